@@ -1,7 +1,16 @@
 #include "sogo.h"
 
+#include <assert.h>
+#include <stddef.h>
+#include <stdlib.h>
 #include <string.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+
 #ifdef _MSC_VER
 #    include <malloc.h>
 #    undef alloca
@@ -10,6 +19,27 @@
 #    include <alloca.h>
 #endif
 
+#if defined(__linux__)
+#    include <linux/futex.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#elif defined(_WIN32)
+#    define WIN32_LEAN_AND_MEAN
+#    define NOMINMAX
+#    include <windows.h>
+#    pragma comment(lib, "Synchronization.lib")
+#endif
+
+#if SOGO_PROFILING
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    elif defined(__x86_64__) || defined(__i386__)
+#        include <x86intrin.h>
+#    else
+#        include <chrono>
+#    endif
+#endif
+
 #define ALIGN_SIZE(x, align) (((x) + ((align)-1)) & ~((align)-1))
 
 namespace sogo {
@@ -23,36 +53,151 @@ typedef uint32_t TContextMemoryOffset;
 
 struct Node
 {
-    RenderCallback       m_Render;
-    TParameterOffset     m_ParametersOffset;
-    TAudioInputOffset    m_AudioInputsOffset;
-    TAudioOutputOffset   m_AudioOutputsOffset;
-    TResourceOffset      m_ResourcesOffset;
-    TTriggerOffset       m_TriggerInputOffset;
-    TTriggerOffset       m_TriggerOutputOffset;
-    TNodeIndex           m_DependencyCount;
-    TNodeIndex           m_DependencyOffset;
-    TContextMemoryOffset m_ContextMemoryOffset;
+    RenderCallback          m_Render;
+    RenderInstancesCallback m_RenderInstances;
+    InitCallback            m_Init;
+    TParameterOffset        m_ParametersOffset;
+    TAudioInputOffset       m_AudioInputsOffset;
+    TAudioOutputOffset      m_AudioOutputsOffset;
+    TResourceOffset         m_ResourcesOffset;
+    TTriggerOffset          m_EventInputOffset;
+    TTriggerOffset          m_TriggerOutputOffset;
+    TNodeIndex              m_DependencyCount;
+    TNodeIndex              m_DependencyOffset;
+    TContextMemoryOffset    m_ContextMemoryOffset;
+    TAudioOutputOffset      m_ScratchAllocationOffset;
+    TAudioSocketIndex       m_ScratchAllocationCount;
+    TAudioOutputOffset      m_PassThroughOffset;
+    TAudioSocketIndex       m_PassThroughCount;
+    TAudioSocketIndex       m_AudioInputCount;
+    TAudioSocketIndex       m_AudioOutputCount;
+    bool                    m_IsSkippedWhenSilent;  // NODE_FLAG_SILENT_IN_SILENT_OUT with audio inputs and no trigger inputs
+    bool                    m_KeepsConstantOutputs; // Every output is read and all readers have NODE_FLAG_CONSTANT_INPUTS
+    bool                    m_HasEventInput;
+    TParameterIndex         m_ParameterCount;
+    TTriggerSocketIndex     m_TriggerInputCount;
+    TResourceIndex          m_ResourceCount;
+    TParameter              m_UserData;
+#if SOGO_PROFILING
+    GetNodeRuntimeDescription m_NodeType;
+#endif
+};
+
+struct ScratchAllocation
+{
+    uint32_t m_Offset;           // In samples from the start of the scratch buffer
+    uint32_t m_ConcurrentOffset; // In samples from the start of the concurrent scratch buffer
+    uint32_t m_SampleCount;      // Channel count * max batch size, rounded up to SCRATCH_ALIGNMENT
+};
+
+static const uint32_t SCRATCH_ALIGNMENT = SCRATCH_BUFFER_ALIGNMENT / sizeof(float); // Samples
+
+// A PASS_THROUGH output, the graph points it at the buffer of the input or at a copy before the node renders
+struct PassThrough
+{
+    uint32_t          m_CopyOffset;           // In samples from the start of the scratch buffer, NO_COPY to write in place
+    uint32_t          m_ConcurrentCopyOffset; // In samples from the start of the concurrent scratch buffer, NO_COPY to write in place
+    TAudioSocketIndex m_OutputIndex;
+    TAudioSocketIndex m_InputIndex;
+};
+
+static const uint32_t NO_COPY = 0xffffffffu;
+
+struct Command
+{
+    enum Type
+    {
+        SET_PARAMETER,
+        TRIGGER,
+        SET_RESOURCE
+    };
+    uint8_t     m_Type;
+    uint8_t     m_Index; // Parameter, trigger or resource index
+    TNodeIndex  m_NodeIndex;
+    TFrameIndex m_FrameOffset; // SET_PARAMETER and TRIGGER
+    union
+    {
+        TParameter m_Parameter;
+        Resource   m_Resource;
+    };
+};
+
+// Single producer single consumer ring buffer, the posting thread owns m_WriteIndex and the
+// rendering thread owns m_ReadIndex. Indexes wrap naturally and are masked on access.
+struct CommandQueue
+{
+    Command*              m_Commands;
+    uint32_t              m_Capacity;
+    std::atomic<uint32_t> m_WriteIndex;
+    std::atomic<uint32_t> m_ReadIndex;
+};
+
+// Slot in the per node queue that Trigger and ScheduleParameter write to from any thread
+struct PendingEvent
+{
+    NodeEvent             m_Event;
+    std::atomic<uint32_t> m_IsPublished;
+};
+
+// Multiple producer single consumer ring buffer of events for a node. Producers reserve a slot by
+// bumping m_ReservedIndex and publish it once written, the thread that renders the node owns
+// m_ConsumedIndex and drains the published slots into the nodes EventInput. Indexes run over
+// twice the capacity so a full queue can be told apart from an empty one.
+struct EventQueue
+{
+    PendingEvent*         m_PendingEvents;
+    std::atomic<uint32_t> m_ReservedIndex;
+    std::atomic<uint32_t> m_ConsumedIndex;
+};
+
+// Scheduling state for each entry in Graph::m_RenderJobs, dependents are indexes into m_RenderJobs
+struct ScheduleNode
+{
+    std::atomic<TNodeIndex> m_PendingDependencyCount;
+    TNodeIndex              m_DependencyCount;
+    TNodeIndex              m_DependentCount;
+    TNodeIndex              m_DependentsOffset;
 };
 
 struct Graph
 {
-    TParameter*          m_Parameters;
-    Resource*            m_Resources;
-    TTriggerCount        m_MaxTriggerEventCount;
-    TTriggerSocketIndex* m_Triggers;
-    TNodeIndex           m_NodeCount;
-    Node*                m_Nodes;
-    uint32_t             m_ScratchBufferSize;
-    float*               m_ScratchBuffer;
-    uint32_t             m_ScratchUsedCount;
-    uint8_t*             m_ContextMemory;
-    TFrameRate           m_FrameRate;
-    AudioOutput*         m_AudioOutputs;
-    AudioInput*          m_AudioInputs;
-    TriggerInput*        m_TriggerInputs;
-    TriggerOutput*       m_TriggerOutputs;
-    TNodeIndex*          m_Dependencies;
+    TParameter*           m_Parameters;
+    Resource*             m_Resources;
+    TTriggerCount         m_MaxTriggerEventCount;
+    NodeEvent*            m_Events;
+    PendingEvent*         m_PendingEvents;
+    TNodeIndex            m_NodeCount;
+    Node*                 m_Nodes;
+    float*                m_ScratchBuffer;
+    float*                m_ConcurrentScratchBuffer;
+    ScratchAllocation*    m_ScratchAllocations; // Planned buffers for both scratch buffers, ordered by node
+    uint32_t              m_ScratchAllocationCount;
+    PassThrough*          m_PassThroughs;             // Ordered by node
+    TAudioSocketIndex*    m_ScratchAllocationIndexes; // Next planned allocation of each node, reset before the node renders
+    uint8_t*              m_ContextMemory;
+    TFrameRate            m_FrameRate;
+    AudioOutput*          m_AudioOutputs;
+    AudioInput*           m_AudioInputs;
+    EventInput*           m_EventInputs;
+    EventQueue*           m_EventQueues; // Parallel to m_EventInputs
+    std::atomic<uint32_t> m_DroppedEventCount;
+    TriggerOutput*        m_TriggerOutputs;
+    TNodeIndex*           m_Dependencies;
+    RenderJob*            m_RenderJobs;  // Resolved once at CreateGraph, stored in render order
+    TNodeIndex*           m_RenderOrder; // Node index for each entry in m_RenderJobs
+    ScheduleNode*         m_ScheduleNodes;
+    TNodeIndex*           m_ScheduleDependents;
+    TNodeIndex*           m_ScheduleRoots;
+    TNodeIndex            m_ScheduleRootCount;
+    TNodeIndex*           m_LevelJobs;    // Indexes into m_RenderJobs sorted by topological level
+    TNodeIndex*           m_LevelOffsets; // First entry in m_LevelJobs for each level, m_LevelCount + 1 entries
+    TNodeIndex            m_LevelCount;
+    CommandQueue          m_CommandQueue;
+#if SOGO_PROFILING
+    std::atomic<uint32_t>* m_ProfileTicks;             // SOGO_PROFILE_BATCH_COUNT entries per node, written round robin
+    uint32_t               m_ProfileStartedBatchCount; // Only touched by the rendering thread
+    std::atomic<uint32_t>  m_ProfileBatchCount;        // Batches that have completed rendering
+#endif
 };
 
 static bool GetOutputChannelCount(
@@ -72,10 +217,11 @@ TChannelIndex*              out_channel_count)
             return true;
         case AudioOutputDescription::PASS_THROUGH:
         case AudioOutputDescription::AS_INPUT:
+        case AudioOutputDescription::SHARED:
         {
             for (TConnectionIndex i = 0; i < node_description.m_AudioConnectionCount; ++i)
             {
-                const NodeAudioConnection* node_connection = audio_connections[i];
+                const NodeAudioConnection* node_connection = &audio_connections[node_index][i];
                 if (node_connection->m_InputIndex == output_description->m_InputIndex)
                 {
                     if (node_connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
@@ -99,6 +245,40 @@ TChannelIndex*              out_channel_count)
     }
 }
 
+// NODE_FLAG_MONO_OR_MATCHING_INPUTS, every connected audio input has one channel or as many
+// channels as output 0 of the node
+static bool HasMonoOrMatchingInputs(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+TNodeIndex                  node_index,
+const NodeAudioConnection** audio_connections)
+{
+    TChannelIndex output_channel_count;
+    if (!GetOutputChannelCount(graph_description, graph_runtime_settings, node_index, audio_connections, 0, &output_channel_count))
+    {
+        return false;
+    }
+    const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+    for (TConnectionIndex i = 0; i < node_description.m_AudioConnectionCount; ++i)
+    {
+        const NodeAudioConnection* node_connection = &audio_connections[node_index][i];
+        TChannelIndex              input_channel_count;
+        if (node_connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+        {
+            input_channel_count = graph_description->m_ExternalAudioInputs[node_connection->m_OutputIndex]->m_ChannelCount;
+        }
+        else if (!GetOutputChannelCount(graph_description, graph_runtime_settings, (TNodeIndex)(node_index + node_connection->m_OutputNodeOffset), audio_connections, node_connection->m_OutputIndex, &input_channel_count))
+        {
+            return false;
+        }
+        if (input_channel_count != 1 && input_channel_count != output_channel_count)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
 static bool GetOutputChannelAllocationCount(
 const GraphDescription*     graph_description,
 const GraphRuntimeSettings* graph_runtime_settings,
@@ -112,6 +292,7 @@ TChannelIndex*              out_channel_count)
     switch (output_description->m_Mode)
     {
         case AudioOutputDescription::PASS_THROUGH:
+        case AudioOutputDescription::SHARED:
             *out_channel_count = 0;
             return true;
         case AudioOutputDescription::FIXED:
@@ -121,7 +302,7 @@ TChannelIndex*              out_channel_count)
         {
             for (TConnectionIndex i = 0; i < node_description.m_AudioConnectionCount; ++i)
             {
-                const NodeAudioConnection* node_connection = audio_connections[i];
+                const NodeAudioConnection* node_connection = &audio_connections[node_index][i];
                 if (node_connection->m_InputIndex == output_description->m_InputIndex)
                 {
                     return GetOutputChannelCount(
@@ -182,11 +363,15 @@ TNodeIndex*                         out_dependecies)
 
     for (TConnectionIndex connection_index = 0; connection_index < node_description->m_TriggerConnectionCount; ++connection_index)
     {
+        if (trigger_connections[node_index][connection_index].m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+        {
+            continue;
+        }
         bool       is_unique         = true;
-        TNodeIndex output_node_index = trigger_connections[node_index][connection_index].m_OutputNodeOffset;
-        for (TConnectionIndex prev = 0; prev < connection_index; ++prev)
+        TNodeIndex output_node_index = (TNodeIndex)(node_index + trigger_connections[node_index][connection_index].m_OutputNodeOffset);
+        for (TConnectionIndex prev = 0; prev < dependency_count; ++prev)
         {
-            if (out_dependecies[prev] == output_node_index)
+            if (dependencies[prev] == output_node_index)
             {
                 is_unique = false;
                 break;
@@ -195,468 +380,3921 @@ TNodeIndex*                         out_dependecies)
 
         if (is_unique)
         {
-            if (out_dependecies)
-            {
-                out_dependecies[dependency_count] = output_node_index;
-            }
+            dependencies[dependency_count] = output_node_index;
             dependency_count += 1;
         }
     }
     return dependency_count;
 }
 
-struct GraphProperties
-{
-    TParameterIndex    m_ParameterCount;
-    TResourceIndex     m_ResourceCount;
-    TAudioSocketIndex  m_AudioInputCount;
-    TAudioSocketIndex  m_AudioOutputCount;
-    uint32_t           m_GeneratedAudioBufferCount;
-    TTriggerCount      m_TriggerInputCount;
-    TTriggerCount      m_TriggerOutputCount;
-    TNodeIndex         m_DependencyCount;
-    TContextMemorySize m_ContextMemorySize;
-};
-
-static bool GetGraphProperties(
-const GraphDescription*     graph_description,
-const GraphRuntimeSettings* graph_runtime_settings,
-GraphProperties*            graph_properties)
+// Depth first walk of the dependencies, each node is emitted after all the nodes it depends on.
+// The walk starts at the nodes that nothing depends on so each branch of the graph is rendered
+// to completion before the next one starts which keeps the number of live buffers down.
+// Fails if the graph contains a cycle.
+static bool GetRenderOrder(
+TNodeIndex        node_count,
+const TNodeIndex* dependency_counts,
+const TNodeIndex* dependency_offsets,
+const TNodeIndex* dependencies,
+TNodeIndex*       out_render_order)
 {
-    TParameterIndex    parameter_count        = 0;
-    TResourceIndex     resource_count         = 0;
-    TTriggerCount      trigger_input_count    = 0;
-    TTriggerCount      trigger_output_count   = 0;
-    TAudioSocketIndex  audio_input_count      = 0;
-    TAudioSocketIndex  audio_output_count     = 0;
-    TNodeIndex         dependency_count       = 0;
-    uint32_t           generated_buffer_count = 0;
-    TContextMemorySize context_memory_size    = 0;
-
-    NodeAudioConnection const** audio_connections      = (NodeAudioConnection const**)alloca(sizeof(NodeAudioConnection*) * graph_description->m_NodeCount);
-    const NodeAudioConnection*  node_audio_connections = graph_description->m_AudioConnections;
-
-    NodeTriggerConnection const** trigger_connections      = (NodeTriggerConnection const**)alloca(sizeof(NodeTriggerConnection*) * graph_description->m_NodeCount);
-    const NodeTriggerConnection*  node_trigger_connections = graph_description->m_TriggerConnections;
+    if (node_count == 0)
+    {
+        return true;
+    }
 
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    enum VisitState
     {
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        audio_connections[node_index]           = node_audio_connections;
-        node_audio_connections += node_description.m_AudioConnectionCount;
+        UNVISITED,
+        VISITING,
+        VISITED
+    };
 
-        trigger_connections[node_index] = node_trigger_connections;
-        node_trigger_connections += node_description.m_TriggerConnectionCount;
+    uint8_t*    visit_state     = (uint8_t*)alloca(sizeof(uint8_t) * node_count);
+    uint8_t*    is_dependency   = (uint8_t*)alloca(sizeof(uint8_t) * node_count);
+    TNodeIndex* stack           = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    TNodeIndex* next_dependency = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    memset(visit_state, UNVISITED, sizeof(uint8_t) * node_count);
+    memset(is_dependency, 0, sizeof(uint8_t) * node_count);
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        for (TNodeIndex d = 0; d < dependency_counts[node_index]; ++d)
+        {
+            is_dependency[dependencies[dependency_offsets[node_index] + d]] = 1;
+        }
     }
 
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    // Nodes in a cycle may not be reachable from a node that nothing depends on, the second
+    // pass visits them so the cycle is detected
+    TNodeIndex render_order_count = 0;
+    for (uint32_t root = 0; root < node_count * 2u; ++root)
     {
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        NodeRuntimeDescription node_runtime_description;
-        node_description.m_NodeStaticDescription.m_GetNodeRuntimeDescCallback(graph_runtime_settings, &node_runtime_description);
-        context_memory_size += node_runtime_description.m_ContextMemorySize;
-        parameter_count += node_description.m_NodeStaticDescription.m_ParameterCount;
-        resource_count += node_description.m_NodeStaticDescription.m_ResourceCount;
-        audio_input_count += node_description.m_NodeStaticDescription.m_AudioInputCount;
-        audio_output_count += node_description.m_NodeStaticDescription.m_AudioOutputCount;
-        trigger_input_count += node_description.m_NodeStaticDescription.m_TriggerInputCount > 0 ? 1 : 0;
-        trigger_output_count += node_description.m_NodeStaticDescription.m_TriggerOutputCount;
-        for (TAudioSocketIndex audio_output_index = 0; audio_output_index < node_description.m_NodeStaticDescription.m_AudioOutputCount; ++audio_output_index)
+        TNodeIndex root_index = (TNodeIndex)(root % node_count);
+        if (visit_state[root_index] != UNVISITED || (root < node_count && is_dependency[root_index]))
+        {
+            continue;
+        }
+        TNodeIndex stack_size       = 0;
+        stack[stack_size++]         = root_index;
+        next_dependency[root_index] = 0;
+        visit_state[root_index]     = VISITING;
+        while (stack_size > 0)
         {
-            TAudioSocketIndex buffer_count = 0;
-            if (!GetOutputChannelAllocationCount(graph_description, graph_runtime_settings, node_index, audio_connections, audio_output_index, &buffer_count))
+            TNodeIndex node_index = stack[stack_size - 1];
+            if (next_dependency[node_index] < dependency_counts[node_index])
             {
-                return false;
+                TNodeIndex dependency_index = dependencies[dependency_offsets[node_index] + next_dependency[node_index]++];
+                if (visit_state[dependency_index] == VISITING)
+                {
+                    return false;
+                }
+                if (visit_state[dependency_index] == UNVISITED)
+                {
+                    stack[stack_size++]               = dependency_index;
+                    next_dependency[dependency_index] = 0;
+                    visit_state[dependency_index]     = VISITING;
+                }
+                continue;
             }
-            generated_buffer_count += buffer_count;
+            visit_state[node_index]                = VISITED;
+            out_render_order[render_order_count++] = node_index;
+            --stack_size;
         }
-
-        dependency_count += GetDependencies(node_index, &node_description, audio_connections, trigger_connections, 0x0);
     }
-
-    graph_properties->m_ContextMemorySize         = context_memory_size;
-    graph_properties->m_ParameterCount            = parameter_count;
-    graph_properties->m_ResourceCount             = resource_count;
-    graph_properties->m_AudioInputCount           = audio_input_count;
-    graph_properties->m_AudioOutputCount          = audio_output_count;
-    graph_properties->m_GeneratedAudioBufferCount = generated_buffer_count;
-    graph_properties->m_TriggerInputCount         = trigger_input_count;
-    graph_properties->m_TriggerOutputCount        = trigger_output_count;
-    graph_properties->m_DependencyCount           = dependency_count;
     return true;
 }
 
-static TGraphSize GetGraphSize(
-const GraphDescription* graph_description,
-const GraphProperties*  graph_properties)
+static bool IsAllocatingOutput(const AudioOutputDescription* output_description)
 {
-    TGraphSize s = ALIGN_SIZE(sizeof(Graph), sizeof(void*)) +
-    ALIGN_SIZE(sizeof(TParameter) * graph_properties->m_ParameterCount, sizeof(Resource*)) +
-    ALIGN_SIZE(sizeof(Resource) * graph_properties->m_ResourceCount, sizeof(RenderCallback)) +
-    ALIGN_SIZE(sizeof(Node) * graph_description->m_NodeCount, sizeof(float*)) +
-    ALIGN_SIZE(sizeof(AudioOutput) * (graph_properties->m_AudioOutputCount + 1), sizeof(AudioOutput*)) +
-    ALIGN_SIZE(sizeof(AudioInput) * graph_properties->m_AudioInputCount, sizeof(TTriggerSocketIndex*)) +
-    ALIGN_SIZE(sizeof(TriggerInput) * graph_properties->m_TriggerInputCount, 1) +
-    ALIGN_SIZE(sizeof(TriggerOutput) * graph_properties->m_TriggerOutputCount, sizeof(TNodeIndex)) +
-    ALIGN_SIZE(sizeof(TNodeIndex) * graph_properties->m_DependencyCount, sizeof(1));
-    return s;
+    return output_description->m_Mode == AudioOutputDescription::FIXED || output_description->m_Mode == AudioOutputDescription::AS_INPUT;
 }
 
-bool GetGraphSize(
-const GraphDescription*     graph_description,
-const GraphRuntimeSettings* graph_runtime_settings,
-GraphSize*                  out_graph_size)
+static bool IsPlanar(const NodeStaticDescription* static_description)
 {
-    GraphProperties graph_properties;
-    if (!GetGraphProperties(graph_description, graph_runtime_settings, &graph_properties))
+    return (static_description->m_Flags & NODE_FLAG_PLANAR) != 0;
+}
+
+// Every channel of a planar buffer starts on a SCRATCH_ALIGNMENT boundary
+static uint32_t GetChannelStride(TFrameIndex max_batch_size)
+{
+    return ALIGN_SIZE(max_batch_size, SCRATCH_ALIGNMENT);
+}
+
+static uint32_t GetBufferSampleCount(const NodeStaticDescription* static_description, TChannelIndex channel_count, TFrameIndex max_batch_size)
+{
+    if (IsPlanar(static_description))
     {
-        return false;
+        return (uint32_t)channel_count * GetChannelStride(max_batch_size);
     }
-    out_graph_size->m_GraphSize         = GetGraphSize(graph_description, &graph_properties);
-    out_graph_size->m_TriggerBufferSize = graph_properties.m_TriggerInputCount * graph_runtime_settings->m_MaxTriggerEventCount * sizeof(TTriggerSocketIndex);
-    out_graph_size->m_ScratchBufferSize = graph_properties.m_GeneratedAudioBufferCount * graph_runtime_settings->m_MaxBatchSize * sizeof(float);
-    out_graph_size->m_ContextMemorySize = graph_properties.m_ContextMemorySize;
-    return true;
+    return ALIGN_SIZE((uint32_t)channel_count * max_batch_size, SCRATCH_ALIGNMENT);
 }
 
-static float* AllocateAudioBuffer(HGraph graph, HNode, TChannelIndex channel_count, TFrameIndex frame_count)
+static const uint32_t NO_BUFFER         = 0xffffffffu;
+static const uint32_t UNRESOLVED_BUFFER = 0xfffffffeu;
+
+// The output an input of a node reads, external inputs are numbered after the outputs of the nodes
+static uint32_t GetInputSource(
+const GraphDescription*     graph_description,
+const NodeAudioConnection** audio_connections,
+const TNodeIndex*           output_offsets,
+uint32_t                    output_count,
+TNodeIndex                  node_index,
+TAudioSocketIndex           input_index)
 {
-    uint32_t samples_required = (uint32_t)channel_count * (uint32_t)frame_count;
-    uint32_t samples_left     = graph->m_ScratchBufferSize - graph->m_ScratchUsedCount;
-    if (samples_left >= samples_required)
+    for (TConnectionIndex c = 0; c < graph_description->m_NodeDescriptions[node_index].m_AudioConnectionCount; ++c)
     {
-        float* scratch = &graph->m_ScratchBuffer[graph->m_ScratchUsedCount];
-        graph->m_ScratchUsedCount += samples_required;
-        return scratch;
+        const NodeAudioConnection* connection = &audio_connections[node_index][c];
+        if (connection->m_InputIndex == input_index)
+        {
+            if (connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+            {
+                return output_count + connection->m_OutputIndex;
+            }
+            return output_offsets[(TNodeIndex)(node_index + connection->m_OutputNodeOffset)] + connection->m_OutputIndex;
+        }
     }
-    return 0x0;
+    return NO_BUFFER;
 }
 
-static void RenderNode(TNodeIndex node_index, RenderJob* render_jobs, uint8_t* is_node_rendered)
+// A PASS_THROUGH output gets a copy of the buffer of its input when writing the buffer in place
+// could change what another reader of the buffer sees. Readers through the output itself want
+// the written samples, every other reader must be done with the buffer before the node renders.
+// For RenderGraph that is every reader earlier in render order. Concurrent rendering only
+// guarantees it for the nodes that passed the buffer on to the node, is_ancestor is filled with
+// them. Readers are found from the outputs resolved so far, a reader of an unresolved output
+// renders after some node that reads a resolved output and is found through that node.
+static bool IsCopyOnWrite(
+const GraphDescription*     graph_description,
+const NodeAudioConnection** audio_connections,
+const TNodeIndex*           output_offsets,
+const TNodeIndex*           output_nodes,
+uint32_t                    output_count,
+const TNodeIndex*           render_position,
+const uint32_t*             output_buffers,
+const uint8_t*              is_consumed,
+uint8_t*                    is_ancestor, // 0x0 when planning for RenderGraph
+TNodeIndex                  node_index,
+TAudioSocketIndex           input_index,
+uint32_t                    buffer)
 {
-    if (is_node_rendered[node_index] != 0)
+    TNodeIndex node_count = graph_description->m_NodeCount;
+    if (is_ancestor)
     {
-        return;
+        memset(is_ancestor, 0, sizeof(uint8_t) * node_count);
+        uint32_t source = GetInputSource(graph_description, audio_connections, output_offsets, output_count, node_index, input_index);
+        while (source < output_count && output_buffers[source] == buffer)
+        {
+            TNodeIndex                    source_node        = output_nodes[source];
+            const AudioOutputDescription* output_description = &graph_description->m_NodeDescriptions[source_node].m_NodeStaticDescription.m_AudioOutputDescriptions[source - output_offsets[source_node]];
+            if (IsAllocatingOutput(output_description))
+            {
+                break;
+            }
+            is_ancestor[source_node] = 1;
+            source                   = GetInputSource(graph_description, audio_connections, output_offsets, output_count, source_node, output_description->m_InputIndex);
+        }
     }
-    RenderJob* render_job = &render_jobs[node_index];
-    for (TNodeIndex dependency_index = 0; dependency_index < render_job->m_DependencyCount; ++dependency_index)
+
+    // Outputs nothing reads stay readable with GetAudioOutput after the batch
+    for (uint32_t output_index = 0; output_index < output_count; ++output_index)
     {
-        RenderNode(render_job->m_Dependencies[dependency_index], render_jobs, is_node_rendered);
+        if (output_buffers[output_index] == buffer && !is_consumed[output_index])
+        {
+            return true;
+        }
     }
 
-    render_job->m_RenderCallback(render_job->m_Graph, render_job->m_Node, &render_job->m_RenderParameters);
-
-    is_node_rendered[node_index] = 1;
+    for (TNodeIndex reader_index = 0; reader_index < node_count; ++reader_index)
+    {
+        for (TConnectionIndex c = 0; c < graph_description->m_NodeDescriptions[reader_index].m_AudioConnectionCount; ++c)
+        {
+            const NodeAudioConnection* connection = &audio_connections[reader_index][c];
+            uint32_t                   source     = connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET ? output_count + connection->m_OutputIndex : output_offsets[(TNodeIndex)(reader_index + connection->m_OutputNodeOffset)] + connection->m_OutputIndex;
+            if ((source < output_count ? output_buffers[source] : source) != buffer)
+            {
+                continue;
+            }
+            if (reader_index == node_index)
+            {
+                if (connection->m_InputIndex != input_index)
+                {
+                    return true;
+                }
+                continue;
+            }
+            if (is_ancestor ? !is_ancestor[reader_index] : render_position[reader_index] > render_position[node_index])
+            {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
-void RenderGraph(HGraph graph, TFrameIndex frame_count)
+// Plans the scratch buffer for rendering the nodes one at a time in render order.
+//
+// Every FIXED and AS_INPUT output gets a buffer, a PASS_THROUGH or SHARED output carries the
+// buffer of the input it passes through. A PASS_THROUGH output that may not write the buffer in
+// place gets a buffer of its own to copy to, see IsCopyOnWrite. A buffer is live from the node
+// that allocates it until the last node reading any output that carries it has rendered, outputs
+// that are not connected to anything stay live until the end of the batch so they can be read
+// with GetAudioOutput. Buffers are placed first-fit in the shared scratch buffer, reusing ranges
+// of buffers that are no longer live.
+//
+// Concurrent rendering has no render order to go by, each buffer also gets a range in the
+// concurrent scratch buffer that no node which may render at the same time uses, so a node can
+// allocate without synchronizing with other workers. A range is reused only by nodes that depend
+// on every node using the buffer before. Which PASS_THROUGH outputs are copied is resolved
+// separately for concurrent rendering.
+//
+// out_allocations has one entry for each allocating output and out_pass_throughs one entry for
+// each PASS_THROUGH output, ordered by node index and output index. out_render_order,
+// out_allocations and out_pass_throughs are optional.
+static bool PlanScratchBuffer(
+const GraphDescription*             graph_description,
+const GraphRuntimeSettings*         graph_runtime_settings,
+const NodeAudioConnection**         audio_connections,
+const NodeTriggerConnection* const* trigger_connections,
+TNodeIndex*                         out_render_order,
+ScratchAllocation*                  out_allocations,
+PassThrough*                        out_pass_throughs,
+uint32_t*                           out_scratch_sample_count,
+uint32_t*                           out_concurrent_scratch_sample_count)
 {
-    TNodeIndex node_count = graph->m_NodeCount;
-
-    RenderJob* render_jobs      = (RenderJob*)alloca(sizeof(RenderJob) * node_count);
-    uint8_t*   is_node_rendered = (uint8_t*)alloca(sizeof(uint8_t) * node_count);
-    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    TNodeIndex node_count                = graph_description->m_NodeCount;
+    *out_scratch_sample_count            = 0;
+    *out_concurrent_scratch_sample_count = 0;
+    if (node_count == 0)
     {
-        is_node_rendered[node_index] = 0;
+        return true;
     }
-    GetRenderJobs(graph, frame_count, render_jobs);
+
+    TNodeIndex* dependency_counts  = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    TNodeIndex* dependency_offsets = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    TNodeIndex* output_offsets     = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    uint32_t    connection_count   = 0;
+    uint32_t    output_count       = 0;
     for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
     {
-        RenderNode(node_index, render_jobs, is_node_rendered);
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        output_offsets[node_index]              = (TNodeIndex)output_count;
+        connection_count += node_description.m_AudioConnectionCount + node_description.m_TriggerConnectionCount;
+        output_count += node_description.m_NodeStaticDescription.m_AudioOutputCount;
     }
-}
-
-void GetRenderJobs(HGraph graph, TFrameIndex frame_count, RenderJob* out_render_jobs)
-{
-    graph->m_ScratchUsedCount = 0;
-    Node*      nodes          = graph->m_Nodes;
-    TNodeIndex node_count     = graph->m_NodeCount;
 
-    TNodeIndex i = 0;
-    while (i < node_count)
+    TNodeIndex* output_nodes = (TNodeIndex*)alloca(sizeof(TNodeIndex) * (output_count + 1));
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
     {
-        Node*      node                         = &nodes[i];
-        RenderJob& render_job                   = out_render_jobs[i];
-        render_job.m_RenderCallback             = node->m_Render;
-        render_job.m_Graph                      = graph;
-        render_job.m_Node                       = node;
-        render_job.m_DependencyCount            = node->m_DependencyCount;
-        render_job.m_Dependencies               = &graph->m_Dependencies[node->m_DependencyOffset];
-        RenderParameters& render_parameters     = render_job.m_RenderParameters;
-        render_parameters.m_AllocateAudioBuffer = AllocateAudioBuffer;
-        render_parameters.m_FrameRate           = graph->m_FrameRate;
-        render_parameters.m_FrameCount          = frame_count;
-
-        render_parameters.m_AudioInputs    = &graph->m_AudioInputs[node->m_AudioInputsOffset];
-        render_parameters.m_AudioOutputs   = &graph->m_AudioOutputs[node->m_AudioOutputsOffset];
-        render_parameters.m_Parameters     = &graph->m_Parameters[node->m_ParametersOffset];
-        render_parameters.m_Resources      = &graph->m_Resources[node->m_ResourcesOffset];
-        render_parameters.m_TriggerInput   = &graph->m_TriggerInputs[node->m_TriggerInputOffset];
-        render_parameters.m_TriggerOutputs = &graph->m_TriggerOutputs[node->m_TriggerOutputOffset];
-        render_parameters.m_ContextMemory  = &graph->m_ContextMemory[node->m_ContextMemoryOffset];
-        ++i;
+        for (TAudioSocketIndex o = 0; o < graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription.m_AudioOutputCount; ++o)
+        {
+            output_nodes[output_offsets[node_index] + o] = node_index;
+        }
     }
-}
 
-bool SetParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value)
-{
-    if (node_index >= graph->m_NodeCount)
+    TNodeIndex* dependencies      = (TNodeIndex*)alloca(sizeof(TNodeIndex) * (connection_count + 1));
+    TNodeIndex  dependency_offset = 0;
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
     {
-        return false;
+        dependency_offsets[node_index] = dependency_offset;
+        dependency_counts[node_index]  = GetDependencies(node_index, &graph_description->m_NodeDescriptions[node_index], audio_connections, trigger_connections, &dependencies[dependency_offset]);
+        dependency_offset += dependency_counts[node_index];
     }
-    Node*            node                = &graph->m_Nodes[node_index];
-    TParameterOffset paramter_offset     = node->m_ParametersOffset + parameter_index;
-    graph->m_Parameters[paramter_offset] = value;
-    return true;
-}
 
-bool Trigger(HGraph graph, TNodeIndex node_index, TTriggerSocketIndex trigger_index)
-{
-    if (node_index >= graph->m_NodeCount)
+    TNodeIndex* render_order = out_render_order ? out_render_order : (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    if (!GetRenderOrder(node_count, dependency_counts, dependency_offsets, dependencies, render_order))
     {
         return false;
     }
-    Node*         node          = &graph->m_Nodes[node_index];
-    TriggerInput* trigger_input = &graph->m_TriggerInputs[node->m_TriggerInputOffset];
-    if (graph->m_MaxTriggerEventCount == trigger_input->m_Count)
+
+    TNodeIndex* render_position = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    for (TNodeIndex i = 0; i < node_count; ++i)
     {
-        return false;
+        render_position[render_order[i]] = i;
     }
 
-    trigger_input->m_Buffer[trigger_input->m_Count++] = trigger_index;
-    return true;
-}
-
-AudioOutput* GetAudioOutput(HGraph graph, TNodeIndex node_index, TAudioSocketIndex output_index)
-{
-    Node* node = &graph->m_Nodes[node_index];
-    return &graph->m_AudioOutputs[node->m_AudioOutputsOffset + output_index];
-}
-
-static HNode MakeNode(
-HGraph                              graph,
-const NodeDescription*              node_description,
-const NodeRuntimeDescription*       node_runtime_description,
-const NodeAudioConnection* const*   audio_connections,
-const NodeTriggerConnection* const* trigger_connections,
-TNodeIndex*                         node_offset,
-TAudioInputOffset*                  input_offset,
-TAudioOutputOffset*                 output_offset,
-TParameterOffset*                   parameters_offset,
-TResourceOffset*                    resources_offset,
-TTriggerOffset*                     triggers_input_offset,
-TTriggerOffset*                     triggers_output_offset,
-TNodeIndex*                         dependenceny_offset,
-TContextMemorySize*                 context_memory_offset)
-{
-    TNodeIndex node_index = *node_offset;
-    (*node_offset) += 1;
-    Node* node = &graph->m_Nodes[node_index];
-
-    node->m_Render           = node_runtime_description->m_RenderCallback;
-    node->m_ParametersOffset = *parameters_offset;
-    *parameters_offset += node_description->m_NodeStaticDescription.m_ParameterCount;
-    node->m_AudioInputsOffset = *input_offset;
-    *input_offset += node_description->m_NodeStaticDescription.m_AudioInputCount;
-    node->m_AudioOutputsOffset = *output_offset;
-    *output_offset += node_description->m_NodeStaticDescription.m_AudioOutputCount;
-    node->m_ResourcesOffset = *resources_offset;
-    *resources_offset += node_description->m_NodeStaticDescription.m_ResourceCount;
-    node->m_TriggerInputOffset = *triggers_input_offset;
-    *triggers_input_offset += node_description->m_NodeStaticDescription.m_TriggerInputCount > 0 ? 1 : 0;
-    node->m_TriggerOutputOffset = *triggers_output_offset;
-    *triggers_output_offset += node_description->m_NodeStaticDescription.m_TriggerOutputCount;
-    node->m_DependencyOffset = *dependenceny_offset;
-
-    for (TParameterIndex i = 0; i < node_description->m_NodeStaticDescription.m_ParameterCount; ++i)
+    uint8_t* is_consumed = (uint8_t*)alloca(sizeof(uint8_t) * (output_count + 1));
+    memset(is_consumed, 0, sizeof(uint8_t) * output_count);
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
     {
-        const ParameterDescription* parameter_description = &node_description->m_NodeStaticDescription.m_ParameterDescriptions[i];
-        graph->m_Parameters[node->m_ParametersOffset + i] = parameter_description->m_InitialValue;
+        for (TConnectionIndex c = 0; c < graph_description->m_NodeDescriptions[node_index].m_AudioConnectionCount; ++c)
+        {
+            const NodeAudioConnection* connection = &audio_connections[node_index][c];
+            if (connection->m_OutputNodeOffset != EXTERNAL_NODE_OFFSET)
+            {
+                is_consumed[output_offsets[(TNodeIndex)(node_index + connection->m_OutputNodeOffset)] + connection->m_OutputIndex] = 1;
+            }
+        }
     }
 
-    node->m_DependencyCount = GetDependencies(node_index, node_description, audio_connections, trigger_connections, &graph->m_Dependencies[node->m_DependencyOffset]);
+    // Resolve which buffer each output carries, once for RenderGraph and once for concurrent
+    // rendering. Outputs are visited in render order so the output a PASS_THROUGH or SHARED
+    // output reads from is always resolved first.
+    uint32_t*   output_buffers            = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    uint32_t*   concurrent_output_buffers = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    uint8_t*    is_copied                 = (uint8_t*)alloca(sizeof(uint8_t) * (output_count + 1));
+    uint8_t*    is_concurrent_copied      = (uint8_t*)alloca(sizeof(uint8_t) * (output_count + 1));
+    uint8_t*    is_ancestor               = (uint8_t*)alloca(sizeof(uint8_t) * node_count);
+    uint32_t*   buffer_sizes              = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    TNodeIndex* buffer_last_use           = (TNodeIndex*)alloca(sizeof(TNodeIndex) * (output_count + 1));
+    uint32_t*   buffer_offsets            = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    for (uint32_t pass = 0; pass < 2; ++pass)
+    {
+        bool      is_concurrent = pass == 1;
+        uint32_t* buffers       = is_concurrent ? concurrent_output_buffers : output_buffers;
+        uint8_t*  copied        = is_concurrent ? is_concurrent_copied : is_copied;
+        for (uint32_t output_index = 0; output_index < output_count; ++output_index)
+        {
+            buffers[output_index] = UNRESOLVED_BUFFER;
+        }
+        for (TNodeIndex i = 0; i < node_count; ++i)
+        {
+            TNodeIndex                   node_index         = render_order[i];
+            const NodeStaticDescription& static_description = graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription;
+            for (TAudioSocketIndex o = 0; o < static_description.m_AudioOutputCount; ++o)
+            {
+                uint32_t                      output_index       = output_offsets[node_index] + o;
+                const AudioOutputDescription* output_description = &static_description.m_AudioOutputDescriptions[o];
+                copied[output_index]                             = 0;
+                if (IsAllocatingOutput(output_description))
+                {
+                    TChannelIndex channel_count = 0;
+                    if (!GetOutputChannelAllocationCount(graph_description, graph_runtime_settings, node_index, audio_connections, o, &channel_count))
+                    {
+                        return false;
+                    }
+                    buffers[output_index]      = output_index;
+                    buffer_sizes[output_index] = GetBufferSampleCount(&static_description, channel_count, graph_runtime_settings->m_MaxBatchSize);
+                    continue;
+                }
+
+                uint32_t source = GetInputSource(graph_description, audio_connections, output_offsets, output_count, node_index, output_description->m_InputIndex);
+                uint32_t buffer = source < output_count ? buffers[source] : source;
+                if (output_description->m_Mode == AudioOutputDescription::PASS_THROUGH && buffer != NO_BUFFER &&
+                    IsCopyOnWrite(graph_description, audio_connections, output_offsets, output_nodes, output_count, render_position, buffers, is_consumed, is_concurrent ? is_ancestor : 0x0, node_index, output_description->m_InputIndex, buffer))
+                {
+                    TChannelIndex channel_count = 0;
+                    if (!GetOutputChannelCount(graph_description, graph_runtime_settings, node_index, audio_connections, o, &channel_count))
+                    {
+                        return false;
+                    }
+                    buffer                     = output_index;
+                    copied[output_index]       = 1;
+                    buffer_sizes[output_index] = GetBufferSampleCount(&static_description, channel_count, graph_runtime_settings->m_MaxBatchSize);
+                }
+                buffers[output_index] = buffer;
+            }
+        }
+    }
+
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        TNodeIndex node_index = render_order[i];
+        for (TAudioSocketIndex o = 0; o < graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription.m_AudioOutputCount; ++o)
+        {
+            uint32_t output_index = output_offsets[node_index] + o;
+            if (output_buffers[output_index] == output_index)
+            {
+                buffer_last_use[output_index] = i;
+            }
+        }
+    }
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        for (TConnectionIndex c = 0; c < graph_description->m_NodeDescriptions[node_index].m_AudioConnectionCount; ++c)
+        {
+            const NodeAudioConnection* connection = &audio_connections[node_index][c];
+            if (connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+            {
+                continue;
+            }
+            uint32_t output_index = output_offsets[(TNodeIndex)(node_index + connection->m_OutputNodeOffset)] + connection->m_OutputIndex;
+            uint32_t buffer       = output_buffers[output_index];
+            if (buffer < output_count && buffer_last_use[buffer] < render_position[node_index])
+            {
+                buffer_last_use[buffer] = render_position[node_index];
+            }
+        }
+    }
+    for (uint32_t output_index = 0; output_index < output_count; ++output_index)
+    {
+        if (!is_consumed[output_index] && output_buffers[output_index] < output_count)
+        {
+            buffer_last_use[output_buffers[output_index]] = node_count;
+        }
+    }
+
+    // First-fit placement in render order, live buffers are kept sorted by offset
+    uint32_t* live_buffers      = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    uint32_t  live_buffer_count = 0;
+    uint32_t  scratch_size      = 0;
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        TNodeIndex                   node_index         = render_order[i];
+        const NodeStaticDescription& static_description = graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription;
+        for (TAudioSocketIndex o = 0; o < static_description.m_AudioOutputCount; ++o)
+        {
+            uint32_t buffer = output_offsets[node_index] + o;
+            if (output_buffers[buffer] != buffer)
+            {
+                continue;
+            }
+            uint32_t offset    = 0;
+            uint32_t insert_at = 0;
+            for (; insert_at < live_buffer_count; ++insert_at)
+            {
+                uint32_t live_buffer = live_buffers[insert_at];
+                if (offset + buffer_sizes[buffer] <= buffer_offsets[live_buffer])
+                {
+                    break;
+                }
+                if (buffer_offsets[live_buffer] + buffer_sizes[live_buffer] > offset)
+                {
+                    offset = buffer_offsets[live_buffer] + buffer_sizes[live_buffer];
+                }
+            }
+            memmove(&live_buffers[insert_at + 1], &live_buffers[insert_at], sizeof(uint32_t) * (live_buffer_count - insert_at));
+            live_buffers[insert_at] = buffer;
+            live_buffer_count += 1;
+            buffer_offsets[buffer] = offset;
+            if (offset + buffer_sizes[buffer] > scratch_size)
+            {
+                scratch_size = offset + buffer_sizes[buffer];
+            }
+        }
+
+        uint32_t keep_count = 0;
+        for (uint32_t l = 0; l < live_buffer_count; ++l)
+        {
+            if (buffer_last_use[live_buffers[l]] > i)
+            {
+                live_buffers[keep_count++] = live_buffers[l];
+            }
+        }
+        live_buffer_count = keep_count;
+    }
+
+    // First-fit placement of the concurrent buffers. A range can only be reused by a node that
+    // depends, directly or through other nodes, on every node using the buffer in it, the
+    // executors then never run the node before all of them are done with it.
+    uint32_t*   concurrent_buffer_offsets = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    uint32_t*   placed_buffers            = (uint32_t*)alloca(sizeof(uint32_t) * (output_count + 1));
+    uint8_t*    is_live                   = (uint8_t*)alloca(sizeof(uint8_t) * (output_count + 1));
+    TNodeIndex* ancestor_stack            = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    uint32_t    placed_buffer_count       = 0;
+    uint32_t    concurrent_scratch_size   = 0;
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        TNodeIndex                   node_index         = render_order[i];
+        const NodeStaticDescription& static_description = graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription;
+        bool                         is_allocating      = false;
+        for (TAudioSocketIndex o = 0; o < static_description.m_AudioOutputCount; ++o)
+        {
+            uint32_t buffer = output_offsets[node_index] + o;
+            is_allocating |= concurrent_output_buffers[buffer] == buffer;
+        }
+        if (!is_allocating)
+        {
+            continue;
+        }
+
+        memset(is_ancestor, 0, sizeof(uint8_t) * node_count);
+        TNodeIndex stack_size = 0;
+        ancestor_stack[stack_size++] = node_index;
+        while (stack_size > 0)
+        {
+            TNodeIndex ancestor_index = ancestor_stack[--stack_size];
+            for (TNodeIndex d = 0; d < dependency_counts[ancestor_index]; ++d)
+            {
+                TNodeIndex dependency = dependencies[dependency_offsets[ancestor_index] + d];
+                if (!is_ancestor[dependency])
+                {
+                    is_ancestor[dependency]      = 1;
+                    ancestor_stack[stack_size++] = dependency;
+                }
+            }
+        }
+
+        // A buffer is in use by the node allocating it, by every node reading an output that
+        // carries it and until the end of the batch if such an output is not read at all
+        for (uint32_t p = 0; p < placed_buffer_count; ++p)
+        {
+            is_live[placed_buffers[p]] = !is_ancestor[output_nodes[placed_buffers[p]]];
+        }
+        for (uint32_t output_index = 0; output_index < output_count; ++output_index)
+        {
+            uint32_t buffer = concurrent_output_buffers[output_index];
+            if (buffer < output_count && (!is_consumed[output_index] || !is_ancestor[output_nodes[output_index]]))
+            {
+                is_live[buffer] = 1;
+            }
+        }
+        for (TNodeIndex reader_index = 0; reader_index < node_count; ++reader_index)
+        {
+            if (is_ancestor[reader_index])
+            {
+                continue;
+            }
+            for (TConnectionIndex c = 0; c < graph_description->m_NodeDescriptions[reader_index].m_AudioConnectionCount; ++c)
+            {
+                const NodeAudioConnection* connection = &audio_connections[reader_index][c];
+                if (connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+                {
+                    continue;
+                }
+                uint32_t buffer = concurrent_output_buffers[output_offsets[(TNodeIndex)(reader_index + connection->m_OutputNodeOffset)] + connection->m_OutputIndex];
+                if (buffer < output_count)
+                {
+                    is_live[buffer] = 1;
+                }
+            }
+        }
+
+        for (TAudioSocketIndex o = 0; o < static_description.m_AudioOutputCount; ++o)
+        {
+            uint32_t buffer = output_offsets[node_index] + o;
+            if (concurrent_output_buffers[buffer] != buffer)
+            {
+                continue;
+            }
+            uint32_t offset    = 0;
+            uint32_t insert_at = 0;
+            for (; insert_at < placed_buffer_count; ++insert_at)
+            {
+                uint32_t placed_buffer = placed_buffers[insert_at];
+                if (offset + buffer_sizes[buffer] <= concurrent_buffer_offsets[placed_buffer])
+                {
+                    break;
+                }
+                if (is_live[placed_buffer] && concurrent_buffer_offsets[placed_buffer] + buffer_sizes[placed_buffer] > offset)
+                {
+                    offset = concurrent_buffer_offsets[placed_buffer] + buffer_sizes[placed_buffer];
+                }
+            }
+            memmove(&placed_buffers[insert_at + 1], &placed_buffers[insert_at], sizeof(uint32_t) * (placed_buffer_count - insert_at));
+            placed_buffers[insert_at] = buffer;
+            placed_buffer_count += 1;
+            is_live[buffer]                   = 1;
+            concurrent_buffer_offsets[buffer] = offset;
+            if (offset + buffer_sizes[buffer] > concurrent_scratch_size)
+            {
+                concurrent_scratch_size = offset + buffer_sizes[buffer];
+            }
+        }
+    }
+
+    uint32_t allocation_index   = 0;
+    uint32_t pass_through_index = 0;
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        const NodeStaticDescription& static_description = graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription;
+        for (TAudioSocketIndex o = 0; o < static_description.m_AudioOutputCount; ++o)
+        {
+            const AudioOutputDescription* output_description = &static_description.m_AudioOutputDescriptions[o];
+            uint32_t                      buffer             = output_offsets[node_index] + o;
+            if (output_description->m_Mode == AudioOutputDescription::PASS_THROUGH)
+            {
+                if (out_pass_throughs)
+                {
+                    PassThrough* pass_through            = &out_pass_throughs[pass_through_index];
+                    pass_through->m_CopyOffset           = is_copied[buffer] ? buffer_offsets[buffer] : NO_COPY;
+                    pass_through->m_ConcurrentCopyOffset = is_concurrent_copied[buffer] ? concurrent_buffer_offsets[buffer] : NO_COPY;
+                    pass_through->m_OutputIndex          = o;
+                    pass_through->m_InputIndex           = output_description->m_InputIndex;
+                }
+                pass_through_index += 1;
+                continue;
+            }
+            if (!IsAllocatingOutput(output_description))
+            {
+                continue;
+            }
+            if (out_allocations)
+            {
+                out_allocations[allocation_index].m_Offset           = buffer_offsets[buffer];
+                out_allocations[allocation_index].m_ConcurrentOffset = concurrent_buffer_offsets[buffer];
+                out_allocations[allocation_index].m_SampleCount      = buffer_sizes[buffer];
+            }
+            allocation_index += 1;
+        }
+    }
+    *out_scratch_sample_count            = scratch_size;
+    *out_concurrent_scratch_sample_count = concurrent_scratch_size;
+    return true;
+}
+
+// Inserted between a node and the nodes of the other layout reading its output, converts the
+// output to the layout of the readers. Constant inputs give a constant output.
+static void ConvertLayout(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    const AudioOutput* input  = render_parameters->m_AudioInputs[0].m_AudioOutput;
+    AudioOutput*       output = &render_parameters->m_AudioOutputs[0];
+    output->m_Buffer          = render_parameters->m_AllocateAudioBuffer(graph, node, output->m_ChannelCount, render_parameters->m_FrameCount);
+    if (output->m_Buffer == 0x0 || input->m_Buffer == 0x0 || input->m_ChannelCount != output->m_ChannelCount)
+    {
+        output->m_Buffer = 0x0;
+        return;
+    }
+    TChannelIndex channel_count = output->m_ChannelCount;
+    TFrameIndex   frame_count   = input->m_IsConstant ? 1 : render_parameters->m_FrameCount;
+    uint32_t      input_frame_stride    = input->m_IsPlanar ? 1 : channel_count;
+    uint32_t      input_channel_stride  = input->m_IsPlanar ? input->m_ChannelStride : 1;
+    uint32_t      output_frame_stride   = output->m_IsPlanar ? 1 : channel_count;
+    uint32_t      output_channel_stride = output->m_IsPlanar ? output->m_ChannelStride : 1;
+    for (TChannelIndex c = 0; c < channel_count; ++c)
+    {
+        const float* in  = &input->m_Buffer[c * input_channel_stride];
+        float*       out = &output->m_Buffer[c * output_channel_stride];
+        for (TFrameIndex f = 0; f < frame_count; ++f)
+        {
+            out[f * output_frame_stride] = in[f * input_frame_stride];
+        }
+    }
+    output->m_IsConstant = input->m_IsConstant;
+}
+
+static void ConvertLayoutGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = ConvertLayout;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+static const AudioOutputDescription ConvertLayoutAudioOutputDescriptions[1] = {
+    { AudioOutputDescription::AS_INPUT, { 0 } }
+};
+
+static const NodeStaticDescription InterleaveNodeDesc = {
+    ConvertLayoutGetNodeRuntimeDescCallback,
+    0x0,
+    ConvertLayoutAudioOutputDescriptions,
+    0x0,
+    1,
+    1,
+    0,
+    0,
+    0,
+    0,
+    NODE_FLAG_SILENT_IN_SILENT_OUT | NODE_FLAG_CONSTANT_INPUTS,
+    { 0 }
+};
+
+static const NodeStaticDescription DeinterleaveNodeDesc = {
+    ConvertLayoutGetNodeRuntimeDescCallback,
+    0x0,
+    ConvertLayoutAudioOutputDescriptions,
+    0x0,
+    1,
+    1,
+    0,
+    0,
+    0,
+    0,
+    NODE_FLAG_SILENT_IN_SILENT_OUT | NODE_FLAG_CONSTANT_INPUTS | NODE_FLAG_PLANAR,
+    { 0 }
+};
+
+static uint32_t GetAudioConnectionCount(const GraphDescription* graph_description)
+{
+    uint32_t connection_count = 0;
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        connection_count += graph_description->m_NodeDescriptions[node_index].m_AudioConnectionCount;
+    }
+    return connection_count;
+}
+
+static const uint32_t EXTERNAL_SOURCE = 0x80000000u;
+
+// Copies the graph description and appends a layout conversion node for each output, or external
+// input, that is read by a node of the other layout. The readers are connected to the conversion.
+// out_node_descriptions and out_audio_connections are sized for the conversions, which are
+// counted by calling with both set to 0x0.
+static bool InsertLayoutConversions(
+const GraphDescription* graph_description,
+NodeDescription*        out_node_descriptions,
+NodeAudioConnection*    out_audio_connections,
+TNodeIndex*             out_conversion_count,
+GraphDescription*       out_graph_description)
+{
+    TNodeIndex node_count       = graph_description->m_NodeCount;
+    uint32_t   connection_count = GetAudioConnectionCount(graph_description);
+    uint32_t*  sources          = (uint32_t*)alloca(sizeof(uint32_t) * (connection_count + 1));
+    TNodeIndex conversion_count = 0;
+    uint32_t   connection_index = 0;
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        bool                   is_planar        = IsPlanar(&node_description.m_NodeStaticDescription);
+        for (TConnectionIndex c = 0; c < node_description.m_AudioConnectionCount; ++c, ++connection_index)
+        {
+            const NodeAudioConnection* connection = &graph_description->m_AudioConnections[connection_index];
+            if (out_audio_connections)
+            {
+                out_audio_connections[connection_index] = *connection;
+            }
+            uint32_t source           = 0;
+            bool     is_source_planar = false;
+            if (connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+            {
+                source           = EXTERNAL_SOURCE | connection->m_OutputIndex;
+                is_source_planar = graph_description->m_ExternalAudioInputs[connection->m_OutputIndex]->m_IsPlanar;
+            }
+            else
+            {
+                TNodeIndex source_index = (TNodeIndex)(node_index + connection->m_OutputNodeOffset);
+                source                  = ((uint32_t)source_index << 8) | connection->m_OutputIndex;
+                is_source_planar        = IsPlanar(&graph_description->m_NodeDescriptions[source_index].m_NodeStaticDescription);
+            }
+            if (is_source_planar == is_planar)
+            {
+                continue;
+            }
+            TNodeIndex conversion_index = 0;
+            while (conversion_index < conversion_count && sources[conversion_index] != source)
+            {
+                ++conversion_index;
+            }
+            if (conversion_index == conversion_count)
+            {
+                sources[conversion_count++] = source;
+            }
+            int32_t offset = (int32_t)(node_count + conversion_index) - (int32_t)node_index;
+            if (offset > INT16_MAX || node_count + conversion_count > 0xffffu)
+            {
+                return false;
+            }
+            if (out_audio_connections)
+            {
+                out_audio_connections[connection_index].m_OutputNodeOffset = (TNodeOffset)offset;
+                out_audio_connections[connection_index].m_OutputIndex      = 0;
+            }
+        }
+    }
+
+    *out_conversion_count = conversion_count;
+    if (out_node_descriptions == 0x0 || out_audio_connections == 0x0)
+    {
+        return true;
+    }
+
+    memcpy(out_node_descriptions, graph_description->m_NodeDescriptions, sizeof(NodeDescription) * node_count);
+    for (TNodeIndex conversion_index = 0; conversion_index < conversion_count; ++conversion_index)
+    {
+        TNodeIndex           node_index = (TNodeIndex)(node_count + conversion_index);
+        uint32_t             source     = sources[conversion_index];
+        NodeAudioConnection* connection = &out_audio_connections[connection_count + conversion_index];
+        bool                 is_planar  = false;
+        connection->m_InputIndex        = 0;
+        if (source & EXTERNAL_SOURCE)
+        {
+            connection->m_OutputNodeOffset = EXTERNAL_NODE_OFFSET;
+            connection->m_OutputIndex      = (TAudioSocketIndex)(source & 0xff);
+            is_planar                      = graph_description->m_ExternalAudioInputs[connection->m_OutputIndex]->m_IsPlanar;
+        }
+        else
+        {
+            TNodeIndex source_index         = (TNodeIndex)(source >> 8);
+            connection->m_OutputNodeOffset = (TNodeOffset)((int32_t)source_index - (int32_t)node_index);
+            connection->m_OutputIndex      = (TAudioSocketIndex)(source & 0xff);
+            is_planar                      = IsPlanar(&graph_description->m_NodeDescriptions[source_index].m_NodeStaticDescription);
+            if ((int32_t)source_index - (int32_t)node_index < INT16_MIN)
+            {
+                return false;
+            }
+        }
+        out_node_descriptions[node_index].m_NodeStaticDescription  = is_planar ? InterleaveNodeDesc : DeinterleaveNodeDesc;
+        out_node_descriptions[node_index].m_AudioConnectionCount   = 1;
+        out_node_descriptions[node_index].m_TriggerConnectionCount = 0;
+    }
+
+    out_graph_description->m_NodeCount           = (TNodeIndex)(node_count + conversion_count);
+    out_graph_description->m_NodeDescriptions    = out_node_descriptions;
+    out_graph_description->m_AudioConnections    = out_audio_connections;
+    out_graph_description->m_TriggerConnections  = graph_description->m_TriggerConnections;
+    out_graph_description->m_ExternalAudioInputs = graph_description->m_ExternalAudioInputs;
+    return true;
+}
+
+struct GraphProperties
+{
+    TParameterOffset   m_ParameterCount;
+    TResourceOffset    m_ResourceCount;
+    TAudioInputOffset  m_AudioInputCount;
+    TAudioOutputOffset m_AudioOutputCount;
+    TAudioOutputOffset m_ScratchAllocationCount;
+    TAudioOutputOffset m_PassThroughCount;
+    uint32_t           m_ScratchSampleCount;
+    uint32_t           m_ConcurrentScratchSampleCount;
+    TCommandCount      m_CommandCapacity;
+    TTriggerCount      m_EventInputCount;
+    TTriggerCount      m_TriggerOutputCount;
+    TNodeIndex         m_DependencyCount;
+    TContextMemorySize m_ContextMemorySize;
+};
+
+// Fields the node does not set are left zero
+static void GetRuntimeDescription(const NodeStaticDescription* node_static_description, const GraphRuntimeSettings* graph_runtime_settings, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    memset(out_node_runtime_desc, 0, sizeof(NodeRuntimeDescription));
+    node_static_description->m_GetNodeRuntimeDescCallback(graph_runtime_settings, node_static_description->m_UserData, out_node_runtime_desc);
+}
+
+static bool GetGraphProperties(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+GraphProperties*            graph_properties)
+{
+    TParameterOffset   parameter_count      = 0;
+    TResourceOffset    resource_count       = 0;
+    TTriggerCount      event_input_count    = 0;
+    TTriggerCount      trigger_output_count = 0;
+    TAudioInputOffset  audio_input_count    = 0;
+    TAudioOutputOffset audio_output_count   = 0;
+    TNodeIndex         dependency_count     = 0;
+    TAudioOutputOffset allocation_count     = 0;
+    TAudioOutputOffset pass_through_count   = 0;
+    TContextMemorySize context_memory_size  = 0;
+
+    NodeAudioConnection const** audio_connections      = (NodeAudioConnection const**)alloca(sizeof(NodeAudioConnection*) * graph_description->m_NodeCount);
+    const NodeAudioConnection*  node_audio_connections = graph_description->m_AudioConnections;
+
+    NodeTriggerConnection const** trigger_connections      = (NodeTriggerConnection const**)alloca(sizeof(NodeTriggerConnection*) * graph_description->m_NodeCount);
+    const NodeTriggerConnection*  node_trigger_connections = graph_description->m_TriggerConnections;
+
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        audio_connections[node_index]           = node_audio_connections;
+        node_audio_connections += node_description.m_AudioConnectionCount;
+
+        trigger_connections[node_index] = node_trigger_connections;
+        node_trigger_connections += node_description.m_TriggerConnectionCount;
+    }
+
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        NodeRuntimeDescription node_runtime_description;
+        GetRuntimeDescription(&node_description.m_NodeStaticDescription, graph_runtime_settings, &node_runtime_description);
+        context_memory_size += node_runtime_description.m_ContextMemorySize;
+        parameter_count += node_description.m_NodeStaticDescription.m_ParameterCount;
+        resource_count += node_description.m_NodeStaticDescription.m_ResourceCount;
+        audio_input_count += node_description.m_NodeStaticDescription.m_AudioInputCount;
+        audio_output_count += node_description.m_NodeStaticDescription.m_AudioOutputCount;
+        event_input_count += (node_description.m_NodeStaticDescription.m_TriggerInputCount > 0 || node_description.m_NodeStaticDescription.m_ParameterCount > 0) ? 1 : 0;
+        trigger_output_count += node_description.m_NodeStaticDescription.m_TriggerOutputCount;
+        for (TAudioSocketIndex audio_output_index = 0; audio_output_index < node_description.m_NodeStaticDescription.m_AudioOutputCount; ++audio_output_index)
+        {
+            const AudioOutputDescription* output_description = &node_description.m_NodeStaticDescription.m_AudioOutputDescriptions[audio_output_index];
+            allocation_count += IsAllocatingOutput(output_description) ? 1 : 0;
+            pass_through_count += output_description->m_Mode == AudioOutputDescription::PASS_THROUGH ? 1 : 0;
+        }
+
+        dependency_count += GetDependencies(node_index, &node_description, audio_connections, trigger_connections, 0x0);
+    }
+
+    uint32_t scratch_sample_count            = 0;
+    uint32_t concurrent_scratch_sample_count = 0;
+    if (!PlanScratchBuffer(graph_description, graph_runtime_settings, audio_connections, trigger_connections, 0x0, 0x0, 0x0, &scratch_sample_count, &concurrent_scratch_sample_count))
+    {
+        return false;
+    }
+
+    TCommandCount command_capacity = graph_runtime_settings->m_MaxCommandCount > 0 ? 1 : 0;
+    while (command_capacity < graph_runtime_settings->m_MaxCommandCount)
+    {
+        command_capacity <<= 1;
+    }
+
+    graph_properties->m_ContextMemorySize            = context_memory_size;
+    graph_properties->m_ParameterCount               = parameter_count;
+    graph_properties->m_ResourceCount                = resource_count;
+    graph_properties->m_AudioInputCount              = audio_input_count;
+    graph_properties->m_AudioOutputCount             = audio_output_count;
+    graph_properties->m_ScratchAllocationCount       = allocation_count;
+    graph_properties->m_PassThroughCount             = pass_through_count;
+    graph_properties->m_ScratchSampleCount           = scratch_sample_count;
+    graph_properties->m_ConcurrentScratchSampleCount = concurrent_scratch_sample_count;
+    graph_properties->m_CommandCapacity              = command_capacity;
+    graph_properties->m_EventInputCount              = event_input_count;
+    graph_properties->m_TriggerOutputCount           = trigger_output_count;
+    graph_properties->m_DependencyCount              = dependency_count;
+    return true;
+}
+
+static TGraphSize GetProfileSize(TNodeIndex node_count)
+{
+#if SOGO_PROFILING
+    return ALIGN_SIZE(sizeof(std::atomic<uint32_t>) * node_count * SOGO_PROFILE_BATCH_COUNT, 1);
+#else
+    (void)node_count;
+    return 0;
+#endif
+}
+
+static uint32_t GetTriggerBufferSize(const GraphRuntimeSettings* graph_runtime_settings, const GraphProperties* graph_properties)
+{
+    return graph_properties->m_EventInputCount * graph_runtime_settings->m_MaxTriggerEventCount * (sizeof(NodeEvent) + sizeof(PendingEvent));
+}
+
+static TGraphSize GetGraphSize(
+TNodeIndex             node_count,
+const GraphProperties* graph_properties)
+{
+    TGraphSize s = ALIGN_SIZE(sizeof(Graph), sizeof(void*)) +
+    ALIGN_SIZE(sizeof(TParameter) * graph_properties->m_ParameterCount, sizeof(Resource*)) +
+    ALIGN_SIZE(sizeof(Resource) * graph_properties->m_ResourceCount, sizeof(RenderCallback)) +
+    ALIGN_SIZE(sizeof(Node) * node_count, sizeof(RenderJob*)) +
+    ALIGN_SIZE(sizeof(RenderJob) * node_count, sizeof(uint32_t)) +
+    ALIGN_SIZE(sizeof(ScratchAllocation) * graph_properties->m_ScratchAllocationCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(PassThrough) * graph_properties->m_PassThroughCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(Command) * graph_properties->m_CommandCapacity, sizeof(float*)) +
+    ALIGN_SIZE(sizeof(AudioOutput) * (graph_properties->m_AudioOutputCount + 1), sizeof(AudioOutput*)) +
+    ALIGN_SIZE(sizeof(AudioInput) * graph_properties->m_AudioInputCount, sizeof(TTriggerSocketIndex*)) +
+    ALIGN_SIZE(sizeof(EventInput) * graph_properties->m_EventInputCount, sizeof(EventQueue*)) +
+    ALIGN_SIZE(sizeof(EventQueue) * graph_properties->m_EventInputCount, 1) +
+    ALIGN_SIZE(sizeof(TriggerOutput) * graph_properties->m_TriggerOutputCount, sizeof(TNodeIndex)) +
+    ALIGN_SIZE(sizeof(TNodeIndex) * graph_properties->m_DependencyCount, sizeof(TNodeIndex)) +
+    ALIGN_SIZE(sizeof(TNodeIndex) * node_count, sizeof(ScheduleNode)) +
+    ALIGN_SIZE(sizeof(ScheduleNode) * node_count, sizeof(TNodeIndex)) +
+    ALIGN_SIZE(sizeof(TNodeIndex) * graph_properties->m_DependencyCount, sizeof(TNodeIndex)) +
+    ALIGN_SIZE(sizeof(TNodeIndex) * node_count, sizeof(TNodeIndex)) +
+    ALIGN_SIZE(sizeof(TNodeIndex) * node_count, sizeof(TNodeIndex)) +
+    ALIGN_SIZE(sizeof(TNodeIndex) * (node_count + 1), sizeof(uint32_t)) +
+    ALIGN_SIZE(sizeof(TAudioSocketIndex) * node_count, sizeof(uint32_t)) +
+    GetProfileSize(node_count);
+    return s;
+}
+
+// Properties and size of the graph with its layout conversions inserted
+static bool GetConvertedGraphProperties(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+TNodeIndex*                 out_node_count,
+GraphProperties*            out_graph_properties,
+TGraphSize*                 out_graph_size)
+{
+    // Layout conversions are created as nodes of their own
+    TNodeIndex conversion_count = 0;
+    if (!InsertLayoutConversions(graph_description, 0x0, 0x0, &conversion_count, 0x0))
+    {
+        return false;
+    }
+    GraphDescription converted_description;
+    if (conversion_count > 0)
+    {
+        NodeDescription*     node_descriptions = (NodeDescription*)alloca(sizeof(NodeDescription) * (graph_description->m_NodeCount + conversion_count));
+        NodeAudioConnection* audio_connections = (NodeAudioConnection*)alloca(sizeof(NodeAudioConnection) * (GetAudioConnectionCount(graph_description) + conversion_count));
+        InsertLayoutConversions(graph_description, node_descriptions, audio_connections, &conversion_count, &converted_description);
+        graph_description = &converted_description;
+    }
+
+    if (!GetGraphProperties(graph_description, graph_runtime_settings, out_graph_properties))
+    {
+        return false;
+    }
+    *out_node_count = graph_description->m_NodeCount;
+    *out_graph_size = GetGraphSize(graph_description->m_NodeCount, out_graph_properties);
+    return true;
+}
+
+static void GetBufferSizes(const GraphRuntimeSettings* graph_runtime_settings, const GraphProperties* graph_properties, TGraphSize graph_size, GraphSize* out_graph_size)
+{
+    out_graph_size->m_GraphSize                   = graph_size;
+    out_graph_size->m_TriggerBufferSize           = GetTriggerBufferSize(graph_runtime_settings, graph_properties);
+    out_graph_size->m_ScratchBufferSize           = graph_properties->m_ScratchSampleCount * sizeof(float);
+    out_graph_size->m_ConcurrentScratchBufferSize = graph_properties->m_ConcurrentScratchSampleCount * sizeof(float);
+    out_graph_size->m_ContextMemorySize           = graph_properties->m_ContextMemorySize;
+}
+
+bool GetGraphSize(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+GraphSize*                  out_graph_size)
+{
+    TNodeIndex      node_count;
+    GraphProperties graph_properties;
+    TGraphSize      graph_size;
+    if (!GetConvertedGraphProperties(graph_description, graph_runtime_settings, &node_count, &graph_properties, &graph_size))
+    {
+        return false;
+    }
+    GetBufferSizes(graph_runtime_settings, &graph_properties, graph_size, out_graph_size);
+    return true;
+}
+
+// The node allocates one buffer for each FIXED and AS_INPUT output in output order, the next
+// planned allocation is tracked per node so a node only ever touches its own state.
+static const ScratchAllocation* GetNextScratchAllocation(HGraph graph, HNode node, TChannelIndex channel_count, TFrameIndex frame_count)
+{
+    TAudioSocketIndex& scratch_allocation_index = graph->m_ScratchAllocationIndexes[node - graph->m_Nodes];
+    if (scratch_allocation_index == node->m_ScratchAllocationCount)
+    {
+        return 0x0;
+    }
+    const ScratchAllocation* scratch_allocation = &graph->m_ScratchAllocations[node->m_ScratchAllocationOffset + scratch_allocation_index++];
+    if ((uint32_t)channel_count * (uint32_t)frame_count > scratch_allocation->m_SampleCount)
+    {
+        return 0x0;
+    }
+    return scratch_allocation;
+}
+
+// Only valid when the nodes render one at a time in render order since planned buffers share memory
+static float* AllocatePlannedAudioBuffer(HGraph graph, HNode node, TChannelIndex channel_count, TFrameIndex frame_count)
+{
+    const ScratchAllocation* scratch_allocation = GetNextScratchAllocation(graph, node, channel_count, frame_count);
+    return scratch_allocation ? &graph->m_ScratchBuffer[scratch_allocation->m_Offset] : 0x0;
+}
+
+// Each buffer has a range of its own so nodes can allocate while other nodes render concurrently
+static float* AllocateConcurrentAudioBuffer(HGraph graph, HNode node, TChannelIndex channel_count, TFrameIndex frame_count)
+{
+    const ScratchAllocation* scratch_allocation = GetNextScratchAllocation(graph, node, channel_count, frame_count);
+    return scratch_allocation ? &graph->m_ConcurrentScratchBuffer[scratch_allocation->m_ConcurrentOffset] : 0x0;
+}
+
+// Inserts the event after any queued events with the same or an earlier frame offset
+static bool InsertEvent(EventInput* event_input, TTriggerCount max_event_count, const NodeEvent& event)
+{
+    if (max_event_count == event_input->m_Count)
+    {
+        return false;
+    }
+    TTriggerCount event_index = event_input->m_Count;
+    while (event_index > 0 && event_input->m_Events[event_index - 1].m_FrameOffset > event.m_FrameOffset)
+    {
+        event_input->m_Events[event_index] = event_input->m_Events[event_index - 1];
+        --event_index;
+    }
+    event_input->m_Events[event_index] = event;
+    event_input->m_Count += 1;
+    return true;
+}
+
+static uint32_t GetNextEventQueueIndex(uint32_t index, uint32_t capacity)
+{
+    return index + 1 == capacity * 2 ? 0 : index + 1;
+}
+
+static uint32_t GetEventQueueCount(uint32_t reserved_index, uint32_t consumed_index, uint32_t capacity)
+{
+    return reserved_index >= consumed_index ? reserved_index - consumed_index : reserved_index + capacity * 2 - consumed_index;
+}
+
+static PendingEvent* GetPendingEvent(EventQueue* event_queue, uint32_t index, uint32_t capacity)
+{
+    return &event_queue->m_PendingEvents[index < capacity ? index : index - capacity];
+}
+
+// Moves the posted events of a node into its EventInput, only called by the thread rendering the
+// node. Draining stops at the first slot that is reserved but not yet published, it and the slots
+// after it are drained in a later batch so the render thread never waits for a producer.
+// Events that do not fit next to the events carried over from earlier batches are dropped.
+static void DrainEvents(HGraph graph, const Node* node)
+{
+    EventQueue* event_queue    = &graph->m_EventQueues[node->m_EventInputOffset];
+    uint32_t    capacity       = graph->m_MaxTriggerEventCount;
+    uint32_t    consumed_index = event_queue->m_ConsumedIndex.load(std::memory_order_relaxed);
+    uint32_t    reserved_index = event_queue->m_ReservedIndex.load(std::memory_order_acquire);
+    if (consumed_index == reserved_index)
+    {
+        return;
+    }
+    EventInput* event_input = &graph->m_EventInputs[node->m_EventInputOffset];
+    while (consumed_index != reserved_index)
+    {
+        PendingEvent* pending_event = GetPendingEvent(event_queue, consumed_index, capacity);
+        if (pending_event->m_IsPublished.load(std::memory_order_acquire) == 0)
+        {
+            break;
+        }
+        if (!InsertEvent(event_input, graph->m_MaxTriggerEventCount, pending_event->m_Event))
+        {
+            graph->m_DroppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        pending_event->m_IsPublished.store(0, std::memory_order_relaxed);
+        consumed_index = GetNextEventQueueIndex(consumed_index, capacity);
+    }
+    event_queue->m_ConsumedIndex.store(consumed_index, std::memory_order_release);
+}
+
+#if SOGO_PROFILING
+static uint64_t GetProfileTicks()
+{
+#    if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#    else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#    endif
+}
+
+static void RecordProfileTicks(HGraph graph, HNode node, uint64_t ticks)
+{
+    uint32_t node_index = (uint32_t)(node - graph->m_Nodes);
+    uint32_t batch_slot = (graph->m_ProfileStartedBatchCount - 1) % SOGO_PROFILE_BATCH_COUNT;
+    graph->m_ProfileTicks[node_index * SOGO_PROFILE_BATCH_COUNT + batch_slot].store(ticks > 0xffffffffu ? 0xffffffffu : (uint32_t)ticks, std::memory_order_relaxed);
+}
+#endif
+
+// Called by every render entry point before any node renders, completes the previous batch in
+// case it was rendered through GetRenderJobs
+static void BeginProfileBatch(HGraph graph)
+{
+#if SOGO_PROFILING
+    graph->m_ProfileBatchCount.store(graph->m_ProfileStartedBatchCount, std::memory_order_release);
+    graph->m_ProfileStartedBatchCount += 1;
+#else
+    (void)graph;
+#endif
+}
+
+static void EndProfileBatch(HGraph graph)
+{
+#if SOGO_PROFILING
+    graph->m_ProfileBatchCount.store(graph->m_ProfileStartedBatchCount, std::memory_order_release);
+#else
+    (void)graph;
+#endif
+}
+
+// Removes the events inside the batch, parameter changes are applied in order so nodes that
+// do not iterate their events still pick them up. Later events are moved to the next batch.
+static void ConsumeEvents(const RenderParameters* render_parameters)
+{
+    EventInput*   event_input = render_parameters->m_EventInput;
+    TFrameIndex   frame_count = render_parameters->m_FrameCount;
+    TTriggerCount event_index = 0;
+    while (event_index < event_input->m_Count && event_input->m_Events[event_index].m_FrameOffset < frame_count)
+    {
+        const NodeEvent* event = &event_input->m_Events[event_index++];
+        if (event->m_Type == NodeEvent::PARAMETER)
+        {
+            render_parameters->m_Parameters[event->m_Index] = event->m_Value;
+        }
+    }
+    TTriggerCount remaining_count = (TTriggerCount)(event_input->m_Count - event_index);
+    for (TTriggerCount i = 0; i < remaining_count; ++i)
+    {
+        NodeEvent* event     = &event_input->m_Events[i];
+        *event               = event_input->m_Events[event_index + i];
+        event->m_FrameOffset = (TFrameIndex)(event->m_FrameOffset - frame_count);
+    }
+    event_input->m_Count = remaining_count;
+}
+
+// Points the PASS_THROUGH outputs of the node at the buffer it writes, the input buffer or a copy
+// if other nodes still read the input buffer. The copy is planned separately for concurrent
+// rendering, which is told apart by the allocator of the render job.
+static void SetPassThroughBuffers(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    bool               is_concurrent = render_parameters->m_AllocateAudioBuffer != AllocatePlannedAudioBuffer;
+    float*             scratch       = is_concurrent ? graph->m_ConcurrentScratchBuffer : graph->m_ScratchBuffer;
+    const PassThrough* pass_throughs = &graph->m_PassThroughs[node->m_PassThroughOffset];
+    for (TAudioSocketIndex i = 0; i < node->m_PassThroughCount; ++i)
+    {
+        const PassThrough* pass_through = &pass_throughs[i];
+        float*             buffer       = render_parameters->m_AudioInputs[pass_through->m_InputIndex].m_AudioOutput->m_Buffer;
+        uint32_t           copy_offset  = is_concurrent ? pass_through->m_ConcurrentCopyOffset : pass_through->m_CopyOffset;
+        if (buffer != 0x0 && copy_offset != NO_COPY)
+        {
+            buffer = &scratch[copy_offset];
+        }
+        render_parameters->m_AudioOutputs[pass_through->m_OutputIndex].m_Buffer = buffer;
+    }
+}
+
+// Repeats the first frame of a constant output over the whole batch
+static void FillConstantOutput(AudioOutput* audio_output, TFrameIndex frame_count)
+{
+    TChannelIndex channel_count  = audio_output->m_ChannelCount;
+    float*        buffer         = audio_output->m_Buffer;
+    uint32_t      frame_stride   = audio_output->m_IsPlanar ? 1 : channel_count;
+    uint32_t      channel_stride = audio_output->m_IsPlanar ? audio_output->m_ChannelStride : 1;
+    for (TChannelIndex c = 0; c < channel_count; ++c)
+    {
+        float* channel = &buffer[c * channel_stride];
+        for (TFrameIndex f = 1; f < frame_count; ++f)
+        {
+            channel[f * frame_stride] = channel[0];
+        }
+    }
+    audio_output->m_IsConstant = false;
+}
+
+// Picks up the events of the node and prepares its outputs, returns false if the node can only
+// produce silence and is skipped
+static bool BeginRenderNode(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    if (render_parameters->m_EventInput)
+    {
+        DrainEvents(graph, node);
+    }
+
+    AudioOutput* audio_outputs = render_parameters->m_AudioOutputs;
+    bool         is_skipped    = false;
+    if (node->m_IsSkippedWhenSilent)
+    {
+        is_skipped = true;
+        for (TAudioSocketIndex i = 0; i < node->m_AudioInputCount && is_skipped; ++i)
+        {
+            is_skipped = render_parameters->m_AudioInputs[i].m_AudioOutput->m_IsSilent;
+        }
+    }
+    if (is_skipped)
+    {
+        for (TAudioSocketIndex i = 0; i < node->m_AudioOutputCount; ++i)
+        {
+            audio_outputs[i].m_Buffer     = 0x0;
+            audio_outputs[i].m_IsSilent   = true;
+            audio_outputs[i].m_IsConstant = false;
+        }
+        return false;
+    }
+    for (TAudioSocketIndex i = 0; i < node->m_AudioOutputCount; ++i)
+    {
+        audio_outputs[i].m_IsConstant = false;
+    }
+    graph->m_ScratchAllocationIndexes[node - graph->m_Nodes] = 0;
+    SetPassThroughBuffers(graph, node, render_parameters);
+    return true;
+}
+
+// Keeps the silence flags of the outputs of a rendered node up to date for the nodes that read
+// them and fills out constant outputs unless every reader handles constant inputs. Removes the
+// events of the batch.
+static void EndRenderNode(HNode node, const RenderParameters* render_parameters, bool is_rendered)
+{
+    AudioOutput* audio_outputs = render_parameters->m_AudioOutputs;
+    if (is_rendered)
+    {
+        for (TAudioSocketIndex i = 0; i < node->m_AudioOutputCount; ++i)
+        {
+            AudioOutput* audio_output = &audio_outputs[i];
+            audio_output->m_IsSilent  = audio_output->m_Buffer == 0x0;
+            if (audio_output->m_IsSilent)
+            {
+                audio_output->m_IsConstant = false;
+            }
+            else if (audio_output->m_IsConstant && !node->m_KeepsConstantOutputs)
+            {
+                FillConstantOutput(audio_output, render_parameters->m_FrameCount);
+            }
+        }
+    }
+    if (render_parameters->m_EventInput && render_parameters->m_EventInput->m_Count > 0)
+    {
+        ConsumeEvents(render_parameters);
+    }
+}
+
+// Render callback of every RenderJob, skips nodes that can only produce silence
+static void RenderNode(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+#if SOGO_PROFILING
+    uint64_t start_ticks = GetProfileTicks();
+#endif
+    bool is_rendered = BeginRenderNode(graph, node, render_parameters);
+    if (is_rendered)
+    {
+        node->m_Render(graph, node, render_parameters);
+    }
+    EndRenderNode(node, render_parameters, is_rendered);
+#if SOGO_PROFILING
+    RecordProfileTicks(graph, node, GetProfileTicks() - start_ticks);
+#endif
+}
+
+static void ApplyCommands(HGraph graph)
+{
+    CommandQueue* command_queue = &graph->m_CommandQueue;
+    uint32_t      read_index    = command_queue->m_ReadIndex.load(std::memory_order_relaxed);
+    uint32_t      write_index   = command_queue->m_WriteIndex.load(std::memory_order_acquire);
+    while (read_index != write_index)
+    {
+        const Command* command = &command_queue->m_Commands[read_index & (command_queue->m_Capacity - 1)];
+        switch (command->m_Type)
+        {
+            case Command::SET_PARAMETER:
+                if (command->m_FrameOffset == 0)
+                {
+                    SetParameter(graph, command->m_NodeIndex, command->m_Index, command->m_Parameter);
+                }
+                else
+                {
+                    ScheduleParameter(graph, command->m_NodeIndex, command->m_Index, command->m_Parameter, command->m_FrameOffset);
+                }
+                break;
+            case Command::TRIGGER:
+                Trigger(graph, command->m_NodeIndex, command->m_Index, command->m_FrameOffset);
+                break;
+            case Command::SET_RESOURCE:
+                SetResource(graph, command->m_NodeIndex, command->m_Index, &command->m_Resource);
+                break;
+        }
+        ++read_index;
+    }
+    command_queue->m_ReadIndex.store(read_index, std::memory_order_release);
+}
+
+void RenderGraph(HGraph graph, TFrameIndex frame_count)
+{
+    ApplyCommands(graph);
+    BeginProfileBatch(graph);
+
+    RenderJob* render_jobs = graph->m_RenderJobs;
+    TNodeIndex node_count  = graph->m_NodeCount;
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        RenderJob* render_job                                = &render_jobs[i];
+        render_job->m_RenderParameters.m_AllocateAudioBuffer = AllocatePlannedAudioBuffer;
+        render_job->m_RenderParameters.m_FrameCount          = frame_count;
+        render_job->m_RenderCallback(render_job->m_Graph, render_job->m_Node, &render_job->m_RenderParameters);
+    }
+    EndProfileBatch(graph);
+}
+
+TNodeIndex GetRenderJobCount(HGraph graph)
+{
+    return graph->m_NodeCount;
+}
+
+void GetRenderJobs(HGraph graph, TFrameIndex frame_count, RenderJob* out_render_jobs)
+{
+    ApplyCommands(graph);
+    BeginProfileBatch(graph);
+
+    TNodeIndex node_count = graph->m_NodeCount;
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        RenderJob& render_job                               = out_render_jobs[graph->m_RenderOrder[i]];
+        render_job                                          = graph->m_RenderJobs[i];
+        render_job.m_RenderParameters.m_AllocateAudioBuffer = AllocateConcurrentAudioBuffer;
+        render_job.m_RenderParameters.m_FrameCount          = frame_count;
+    }
+}
+
+// Fixed capacity Chase-Lev work stealing queue, the owning worker pushes and pops at the bottom
+// and other workers steal from the top. Each render job is pushed at most once per batch and
+// the queues are reset between batches so the capacity never needs to exceed the node count.
+//
+// A thief reads an item while the owner may push over the same slot, the thief then fails to
+// claim it but the items are atomic so the read itself is not a data race.
+struct WorkQueue
+{
+    std::atomic<int32_t>     m_Top;
+    std::atomic<int32_t>     m_Bottom;
+    std::atomic<TNodeIndex>* m_Items;
+};
+
+static void ResetWork(WorkQueue* work_queue)
+{
+    work_queue->m_Top.store(0, std::memory_order_relaxed);
+    work_queue->m_Bottom.store(0, std::memory_order_relaxed);
+}
+
+static void PushWork(WorkQueue* work_queue, TNodeIndex schedule_index)
+{
+    int32_t bottom = work_queue->m_Bottom.load(std::memory_order_relaxed);
+    work_queue->m_Items[bottom].store(schedule_index, std::memory_order_relaxed);
+    work_queue->m_Bottom.store(bottom + 1, std::memory_order_release);
+}
+
+static bool PopWork(WorkQueue* work_queue, TNodeIndex* out_schedule_index)
+{
+    int32_t bottom = work_queue->m_Bottom.load(std::memory_order_relaxed) - 1;
+    work_queue->m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int32_t top = work_queue->m_Top.load(std::memory_order_relaxed);
+    if (top > bottom)
+    {
+        work_queue->m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    *out_schedule_index = work_queue->m_Items[bottom].load(std::memory_order_relaxed);
+    if (top != bottom)
+    {
+        return true;
+    }
+    bool is_taken = work_queue->m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    work_queue->m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    return is_taken;
+}
+
+static bool StealWork(WorkQueue* work_queue, TNodeIndex* out_schedule_index)
+{
+    int32_t top = work_queue->m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int32_t bottom = work_queue->m_Bottom.load(std::memory_order_acquire);
+    if (top >= bottom)
+    {
+        return false;
+    }
+    *out_schedule_index = work_queue->m_Items[top].load(std::memory_order_relaxed);
+    return work_queue->m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+}
+
+struct Executor;
+typedef void (*ExecuteBatchFunc)(Executor* executor, uint32_t worker_index);
+
+struct Executor
+{
+    Executor(uint32_t worker_thread_count, TNodeIndex max_node_count, WorkQueue* work_queues, std::thread* worker_threads);
+
+    uint32_t                m_WorkerCount; // Worker threads plus the thread calling RenderGraphParallel
+    TNodeIndex              m_MaxNodeCount;
+    WorkQueue*              m_WorkQueues;
+    std::thread*            m_WorkerThreads;
+    std::atomic<uint32_t>   m_Generation; // Incremented for each batch and when stopping, parked workers wait on it
+    std::atomic<uint32_t>   m_ParkedWorkerCount;
+    std::atomic<bool>       m_IsStopping;
+    std::mutex              m_ParkMutex;     // Only parks workers on platforms without futexes
+    std::condition_variable m_ParkCondition; // Only parks workers on platforms without futexes
+    std::atomic<uint32_t>   m_ActiveWorkerCount;
+    std::atomic<int32_t>    m_RemainingJobCount;
+    std::atomic<int32_t>    m_NextLevelJob;       // RenderGraphWavefront
+    std::atomic<int32_t>    m_CompletedLevelJobs; // RenderGraphWavefront
+    int32_t                 m_LevelJobCount;      // RenderGraphWavefront
+    ExecuteBatchFunc        m_ExecuteBatch;
+    HGraph                  m_Graph;
+    TFrameIndex             m_FrameCount;
+};
+
+Executor::Executor(uint32_t worker_thread_count, TNodeIndex max_node_count, WorkQueue* work_queues, std::thread* worker_threads)
+    : m_WorkerCount(worker_thread_count + 1)
+    , m_MaxNodeCount(max_node_count)
+    , m_WorkQueues(work_queues)
+    , m_WorkerThreads(worker_threads)
+    , m_Generation(0)
+    , m_ParkedWorkerCount(0)
+    , m_IsStopping(false)
+    , m_ActiveWorkerCount(0)
+    , m_RemainingJobCount(0)
+    , m_NextLevelJob(0)
+    , m_CompletedLevelJobs(0)
+    , m_LevelJobCount(0)
+    , m_ExecuteBatch(0x0)
+    , m_Graph(0x0)
+    , m_FrameCount(0)
+{
+}
+
+static void RenderScheduledJob(Executor* executor, WorkQueue* work_queue, TNodeIndex schedule_index)
+{
+    HGraph        graph         = executor->m_Graph;
+    ScheduleNode* schedule_node = &graph->m_ScheduleNodes[schedule_index];
+    RenderJob*    render_job    = &graph->m_RenderJobs[schedule_index];
+
+    // Nothing else touches the counter until the next batch, restore it for the next batch
+    schedule_node->m_PendingDependencyCount.store(schedule_node->m_DependencyCount, std::memory_order_relaxed);
+
+    render_job->m_RenderParameters.m_AllocateAudioBuffer = AllocateConcurrentAudioBuffer;
+    render_job->m_RenderParameters.m_FrameCount          = executor->m_FrameCount;
+    render_job->m_RenderCallback(render_job->m_Graph, render_job->m_Node, &render_job->m_RenderParameters);
+
+    const TNodeIndex* dependents = &graph->m_ScheduleDependents[schedule_node->m_DependentsOffset];
+    for (TNodeIndex i = 0; i < schedule_node->m_DependentCount; ++i)
+    {
+        ScheduleNode* dependent_node = &graph->m_ScheduleNodes[dependents[i]];
+        if (dependent_node->m_PendingDependencyCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            PushWork(work_queue, dependents[i]);
+        }
+    }
+    executor->m_RemainingJobCount.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+static void ExecuteBatch(Executor* executor, uint32_t worker_index)
+{
+    WorkQueue* work_queue = &executor->m_WorkQueues[worker_index];
+    while (executor->m_RemainingJobCount.load(std::memory_order_acquire) > 0)
+    {
+        TNodeIndex schedule_index;
+        if (PopWork(work_queue, &schedule_index))
+        {
+            RenderScheduledJob(executor, work_queue, schedule_index);
+            continue;
+        }
+        bool is_stolen = false;
+        for (uint32_t i = 1; i < executor->m_WorkerCount && !is_stolen; ++i)
+        {
+            is_stolen = StealWork(&executor->m_WorkQueues[(worker_index + i) % executor->m_WorkerCount], &schedule_index);
+        }
+        if (is_stolen)
+        {
+            RenderScheduledJob(executor, work_queue, schedule_index);
+            continue;
+        }
+        std::this_thread::yield();
+    }
+}
+
+// Level synchronous rendering: jobs are claimed in level order from a shared cursor and a job
+// is not started until every job in the previous levels has completed. A worker may start after
+// the batch is complete and the graph is gone, the graph is only read once a job is claimed.
+static void ExecuteWavefrontBatch(Executor* executor, uint32_t)
+{
+    TNodeIndex level = 0;
+    while (true)
+    {
+        int32_t level_job = executor->m_NextLevelJob.fetch_add(1, std::memory_order_relaxed);
+        if (level_job >= executor->m_LevelJobCount)
+        {
+            return;
+        }
+        HGraph            graph         = executor->m_Graph;
+        const TNodeIndex* level_offsets = graph->m_LevelOffsets;
+        while (level_job >= level_offsets[level + 1])
+        {
+            ++level;
+        }
+        while (executor->m_CompletedLevelJobs.load(std::memory_order_acquire) < level_offsets[level])
+        {
+            std::this_thread::yield();
+        }
+        RenderJob* render_job                                = &graph->m_RenderJobs[graph->m_LevelJobs[level_job]];
+        render_job->m_RenderParameters.m_AllocateAudioBuffer = AllocateConcurrentAudioBuffer;
+        render_job->m_RenderParameters.m_FrameCount          = executor->m_FrameCount;
+        render_job->m_RenderCallback(render_job->m_Graph, render_job->m_Node, &render_job->m_RenderParameters);
+        executor->m_CompletedLevelJobs.fetch_add(1, std::memory_order_release);
+        executor->m_RemainingJobCount.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+// Yields a worker does waiting for the next batch before it parks
+static const uint32_t WORKER_SPIN_COUNT = 1024;
+
+// Blocks while generation is unchanged, may return spuriously
+static void ParkWorker(Executor* executor, uint32_t generation)
+{
+#if defined(__linux__)
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32 bit word");
+    syscall(SYS_futex, (uint32_t*)&executor->m_Generation, FUTEX_WAIT_PRIVATE, generation, 0x0, 0x0, 0);
+#elif defined(_WIN32)
+    WaitOnAddress(&executor->m_Generation, &generation, sizeof(uint32_t), INFINITE);
+#else
+    std::unique_lock<std::mutex> lock(executor->m_ParkMutex);
+    while (executor->m_Generation.load(std::memory_order_relaxed) == generation)
+    {
+        executor->m_ParkCondition.wait(lock);
+    }
+#endif
+}
+
+static void WakeWorkers(Executor* executor)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (uint32_t*)&executor->m_Generation, FUTEX_WAKE_PRIVATE, INT32_MAX, 0x0, 0x0, 0);
+#elif defined(_WIN32)
+    WakeByAddressAll(&executor->m_Generation);
+#else
+    {
+        std::lock_guard<std::mutex> lock(executor->m_ParkMutex);
+    }
+    executor->m_ParkCondition.notify_all();
+#endif
+}
+
+// Publishes a batch or the stop request to the workers, only parked workers need a wake up
+static void SignalWorkers(Executor* executor)
+{
+    executor->m_Generation.fetch_add(1, std::memory_order_seq_cst);
+    if (executor->m_ParkedWorkerCount.load(std::memory_order_seq_cst) > 0)
+    {
+        WakeWorkers(executor);
+    }
+}
+
+static void WorkerThread(Executor* executor, uint32_t worker_index)
+{
+    uint32_t generation = 0;
+    while (true)
+    {
+        uint32_t spin_count = 0;
+        while (executor->m_Generation.load(std::memory_order_acquire) == generation)
+        {
+            if (spin_count < WORKER_SPIN_COUNT)
+            {
+                ++spin_count;
+                std::this_thread::yield();
+                continue;
+            }
+            executor->m_ParkedWorkerCount.fetch_add(1, std::memory_order_seq_cst);
+            if (executor->m_Generation.load(std::memory_order_seq_cst) == generation)
+            {
+                ParkWorker(executor, generation);
+            }
+            executor->m_ParkedWorkerCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+        generation = executor->m_Generation.load(std::memory_order_acquire);
+        if (executor->m_IsStopping.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        executor->m_ExecuteBatch(executor, worker_index);
+        executor->m_ActiveWorkerCount.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+TExecutorSize GetExecutorSize(uint32_t worker_thread_count, TNodeIndex max_node_count)
+{
+    uint32_t      worker_count = worker_thread_count + 1;
+    TExecutorSize s            = (TExecutorSize)(ALIGN_SIZE(sizeof(Executor), sizeof(void*)) +
+                                                 ALIGN_SIZE(sizeof(WorkQueue) * worker_count, sizeof(void*)) +
+                                                 ALIGN_SIZE(sizeof(std::thread) * worker_thread_count, sizeof(std::atomic<TNodeIndex>)) +
+                                                 ALIGN_SIZE(sizeof(std::atomic<TNodeIndex>) * max_node_count * worker_count, sizeof(void*)));
+    return s;
+}
+
+HExecutor CreateExecutor(void* executor_mem, uint32_t worker_thread_count, TNodeIndex max_node_count)
+{
+    uint32_t worker_count = worker_thread_count + 1;
+
+    uint8_t* ptr    = (uint8_t*)executor_mem;
+    size_t   offset = ALIGN_SIZE(sizeof(Executor), sizeof(void*));
+
+    WorkQueue* work_queues = (WorkQueue*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(WorkQueue) * worker_count, sizeof(void*));
+
+    std::thread* worker_threads = (std::thread*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(std::thread) * worker_thread_count, sizeof(std::atomic<TNodeIndex>));
+
+    std::atomic<TNodeIndex>* work_items = (std::atomic<TNodeIndex>*)&ptr[offset];
+    for (uint32_t i = 0; i < max_node_count * worker_count; ++i)
+    {
+        new (&work_items[i]) std::atomic<TNodeIndex>(0);
+    }
+
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        WorkQueue* work_queue = new (&work_queues[i]) WorkQueue;
+        work_queue->m_Items   = &work_items[max_node_count * i];
+        ResetWork(work_queue);
+    }
+
+    HExecutor executor = new (executor_mem) Executor(worker_thread_count, max_node_count, work_queues, worker_threads);
+
+    for (uint32_t i = 0; i < worker_thread_count; ++i)
+    {
+        new (&worker_threads[i]) std::thread(WorkerThread, executor, i + 1);
+    }
+    return executor;
+}
+
+void DisposeExecutor(HExecutor executor)
+{
+    executor->m_IsStopping.store(true, std::memory_order_relaxed);
+    SignalWorkers(executor);
+    for (uint32_t i = 0; i < executor->m_WorkerCount - 1; ++i)
+    {
+        executor->m_WorkerThreads[i].join();
+        executor->m_WorkerThreads[i].~thread();
+    }
+    executor->~Executor();
+}
+
+// The previous batch returned once its jobs completed, workers may still be on their way out of
+// it. They must be done with the batch state before the next batch resets it, by then they
+// normally are.
+static void WaitForIdleWorkers(Executor* executor)
+{
+    while (executor->m_ActiveWorkerCount.load(std::memory_order_acquire) != 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+static void RunBatch(Executor* executor, ExecuteBatchFunc execute_batch)
+{
+    executor->m_ExecuteBatch = execute_batch;
+    executor->m_ActiveWorkerCount.store(executor->m_WorkerCount - 1, std::memory_order_relaxed);
+    SignalWorkers(executor);
+
+    execute_batch(executor, 0);
+
+    while (executor->m_RemainingJobCount.load(std::memory_order_acquire) > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+bool RenderGraphParallel(HGraph graph, TFrameIndex frame_count, HExecutor executor)
+{
+    TNodeIndex node_count = graph->m_NodeCount;
+    if (node_count > executor->m_MaxNodeCount)
+    {
+        return false;
+    }
+    if (graph->m_ScratchAllocationCount > 0 && graph->m_ConcurrentScratchBuffer == 0x0)
+    {
+        return false;
+    }
+    if (node_count == 0)
+    {
+        return true;
+    }
+
+    ApplyCommands(graph);
+    BeginProfileBatch(graph);
+    WaitForIdleWorkers(executor);
+
+    executor->m_Graph      = graph;
+    executor->m_FrameCount = frame_count;
+    executor->m_RemainingJobCount.store(node_count, std::memory_order_relaxed);
+
+    uint32_t worker_count = executor->m_WorkerCount;
+    for (uint32_t i = 0; i < worker_count; ++i)
+    {
+        ResetWork(&executor->m_WorkQueues[i]);
+    }
+    for (TNodeIndex i = 0; i < graph->m_ScheduleRootCount; ++i)
+    {
+        PushWork(&executor->m_WorkQueues[i % worker_count], graph->m_ScheduleRoots[i]);
+    }
+
+    RunBatch(executor, ExecuteBatch);
+    EndProfileBatch(graph);
+    return true;
+}
+
+bool RenderGraphWavefront(HGraph graph, TFrameIndex frame_count, HExecutor executor)
+{
+    if (graph->m_ScratchAllocationCount > 0 && graph->m_ConcurrentScratchBuffer == 0x0)
+    {
+        return false;
+    }
+    if (graph->m_NodeCount == 0)
+    {
+        return true;
+    }
+
+    ApplyCommands(graph);
+    BeginProfileBatch(graph);
+    WaitForIdleWorkers(executor);
+
+    executor->m_Graph         = graph;
+    executor->m_FrameCount    = frame_count;
+    executor->m_LevelJobCount = graph->m_NodeCount;
+    executor->m_RemainingJobCount.store(graph->m_NodeCount, std::memory_order_relaxed);
+    executor->m_NextLevelJob.store(0, std::memory_order_relaxed);
+    executor->m_CompletedLevelJobs.store(0, std::memory_order_relaxed);
+
+    RunBatch(executor, ExecuteWavefrontBatch);
+    EndProfileBatch(graph);
+    return true;
+}
+
+bool SetParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value)
+{
+    if (node_index >= graph->m_NodeCount)
+    {
+        return false;
+    }
+    Node*            node                = &graph->m_Nodes[node_index];
+    TParameterOffset paramter_offset     = node->m_ParametersOffset + parameter_index;
+    graph->m_Parameters[paramter_offset] = value;
+    return true;
+}
+
+// Safe to call from any number of threads, fails if the queue of the node is full
+static bool PushEvent(HGraph graph, Node* node, const NodeEvent& event)
+{
+    EventQueue* event_queue    = &graph->m_EventQueues[node->m_EventInputOffset];
+    uint32_t    capacity       = graph->m_MaxTriggerEventCount;
+    uint32_t    reserved_index = event_queue->m_ReservedIndex.load(std::memory_order_relaxed);
+    do
+    {
+        // Acquire so the slot is written after the render thread has drained it
+        uint32_t consumed_index = event_queue->m_ConsumedIndex.load(std::memory_order_acquire);
+        if (GetEventQueueCount(reserved_index, consumed_index, capacity) == capacity)
+        {
+            return false;
+        }
+    } while (!event_queue->m_ReservedIndex.compare_exchange_weak(reserved_index, GetNextEventQueueIndex(reserved_index, capacity), std::memory_order_relaxed, std::memory_order_relaxed));
+
+    PendingEvent* pending_event = GetPendingEvent(event_queue, reserved_index, capacity);
+    pending_event->m_Event      = event;
+    pending_event->m_IsPublished.store(1, std::memory_order_release);
+    return true;
+}
+
+bool Trigger(HGraph graph, TNodeIndex node_index, TTriggerSocketIndex trigger_index, TFrameIndex frame_offset)
+{
+    if (node_index >= graph->m_NodeCount)
+    {
+        return false;
+    }
+    Node* node = &graph->m_Nodes[node_index];
+    if (trigger_index >= node->m_TriggerInputCount)
+    {
+        return false;
+    }
+    NodeEvent event;
+    event.m_FrameOffset = frame_offset;
+    event.m_Type        = NodeEvent::TRIGGER;
+    event.m_Index       = trigger_index;
+    event.m_Value.m_Int = 0;
+    return PushEvent(graph, node, event);
+}
+
+bool ScheduleParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value, TFrameIndex frame_offset)
+{
+    if (node_index >= graph->m_NodeCount)
+    {
+        return false;
+    }
+    Node* node = &graph->m_Nodes[node_index];
+    if (parameter_index >= node->m_ParameterCount)
+    {
+        return false;
+    }
+    NodeEvent event;
+    event.m_FrameOffset = frame_offset;
+    event.m_Type        = NodeEvent::PARAMETER;
+    event.m_Index       = parameter_index;
+    event.m_Value       = value;
+    return PushEvent(graph, node, event);
+}
+
+void InitEventIterator(EventIterator* event_iterator, const RenderParameters* render_parameters)
+{
+    event_iterator->m_RenderParameters = render_parameters;
+    event_iterator->m_EventIndex       = 0;
+    event_iterator->m_FrameOffset      = 0;
+}
+
+bool NextSubBlock(EventIterator* event_iterator, TFrameIndex* out_frame_offset, TFrameIndex* out_frame_count, const NodeEvent** out_events, TTriggerCount* out_event_count)
+{
+    const RenderParameters* render_parameters = event_iterator->m_RenderParameters;
+    TFrameIndex             frame_count       = render_parameters->m_FrameCount;
+    TFrameIndex             frame_offset      = event_iterator->m_FrameOffset;
+    if (frame_offset >= frame_count)
+    {
+        return false;
+    }
+
+    const EventInput* event_input = render_parameters->m_EventInput;
+    TTriggerCount     event_count = event_input ? event_input->m_Count : 0;
+    TTriggerCount     first_event = event_iterator->m_EventIndex;
+    TTriggerCount     event_index = first_event;
+    while (event_index < event_count && event_input->m_Events[event_index].m_FrameOffset <= frame_offset)
+    {
+        const NodeEvent* event = &event_input->m_Events[event_index++];
+        if (event->m_Type == NodeEvent::PARAMETER)
+        {
+            render_parameters->m_Parameters[event->m_Index] = event->m_Value;
+        }
+    }
+
+    TFrameIndex next_frame_offset = frame_count;
+    if (event_index < event_count && event_input->m_Events[event_index].m_FrameOffset < frame_count)
+    {
+        next_frame_offset = event_input->m_Events[event_index].m_FrameOffset;
+    }
+
+    *out_frame_offset             = frame_offset;
+    *out_frame_count              = next_frame_offset - frame_offset;
+    *out_events                   = event_input ? &event_input->m_Events[first_event] : 0x0;
+    *out_event_count              = (TTriggerCount)(event_index - first_event);
+    event_iterator->m_EventIndex  = event_index;
+    event_iterator->m_FrameOffset = next_frame_offset;
+    return true;
+}
+
+AudioOutput* GetAudioOutput(HGraph graph, TNodeIndex node_index, TAudioSocketIndex output_index)
+{
+    Node* node = &graph->m_Nodes[node_index];
+    return &graph->m_AudioOutputs[node->m_AudioOutputsOffset + output_index];
+}
+
+// Points the event input of the node at its events in the trigger buffer and empties it
+static void InitEventInput(HGraph graph, const Node* node)
+{
+    EventInput* event_input = &graph->m_EventInputs[node->m_EventInputOffset];
+    event_input->m_Events   = &graph->m_Events[node->m_EventInputOffset * graph->m_MaxTriggerEventCount];
+    event_input->m_Count    = 0;
+
+    EventQueue* event_queue      = &graph->m_EventQueues[node->m_EventInputOffset];
+    event_queue->m_PendingEvents = &graph->m_PendingEvents[node->m_EventInputOffset * graph->m_MaxTriggerEventCount];
+    event_queue->m_ReservedIndex.store(0, std::memory_order_relaxed);
+    event_queue->m_ConsumedIndex.store(0, std::memory_order_relaxed);
+    for (TTriggerCount i = 0; i < graph->m_MaxTriggerEventCount; ++i)
+    {
+        event_queue->m_PendingEvents[i].m_IsPublished.store(0, std::memory_order_relaxed);
+    }
+}
+
+static void SetNodeCallbacks(Node* node, const NodeStaticDescription* node_static_description, const NodeRuntimeDescription* node_runtime_description)
+{
+    node->m_Render          = node_runtime_description->m_RenderCallback;
+    node->m_RenderInstances = node_runtime_description->m_RenderInstancesCallback;
+    node->m_Init            = node_runtime_description->m_InitCallback;
+#if SOGO_PROFILING
+    node->m_NodeType = node_static_description->m_GetNodeRuntimeDescCallback;
+#else
+    (void)node_static_description;
+#endif
+}
+
+static HNode MakeNode(
+HGraph                              graph,
+const NodeDescription*              node_description,
+const NodeRuntimeDescription*       node_runtime_description,
+const NodeAudioConnection* const*   audio_connections,
+const NodeTriggerConnection* const* trigger_connections,
+TNodeIndex*                         node_offset,
+TAudioInputOffset*                  input_offset,
+TAudioOutputOffset*                 output_offset,
+TParameterOffset*                   parameters_offset,
+TResourceOffset*                    resources_offset,
+TTriggerOffset*                     triggers_input_offset,
+TTriggerOffset*                     triggers_output_offset,
+TNodeIndex*                         dependenceny_offset,
+TAudioOutputOffset*                 scratch_allocation_offset,
+TAudioOutputOffset*                 pass_through_offset,
+TContextMemorySize*                 context_memory_offset)
+{
+    TNodeIndex node_index = *node_offset;
+    (*node_offset) += 1;
+    Node* node = &graph->m_Nodes[node_index];
+
+    SetNodeCallbacks(node, &node_description->m_NodeStaticDescription, node_runtime_description);
+    node->m_ParametersOffset = *parameters_offset;
+    *parameters_offset += node_description->m_NodeStaticDescription.m_ParameterCount;
+    node->m_AudioInputsOffset = *input_offset;
+    *input_offset += node_description->m_NodeStaticDescription.m_AudioInputCount;
+    node->m_AudioOutputsOffset = *output_offset;
+    *output_offset += node_description->m_NodeStaticDescription.m_AudioOutputCount;
+    node->m_ResourcesOffset = *resources_offset;
+    *resources_offset += node_description->m_NodeStaticDescription.m_ResourceCount;
+    node->m_HasEventInput    = node_description->m_NodeStaticDescription.m_TriggerInputCount > 0 || node_description->m_NodeStaticDescription.m_ParameterCount > 0;
+    node->m_EventInputOffset = *triggers_input_offset;
+    *triggers_input_offset += node->m_HasEventInput ? 1 : 0;
+    node->m_TriggerOutputOffset = *triggers_output_offset;
+    *triggers_output_offset += node_description->m_NodeStaticDescription.m_TriggerOutputCount;
+    node->m_DependencyOffset = *dependenceny_offset;
+
+    const NodeStaticDescription& static_description = node_description->m_NodeStaticDescription;
+    node->m_AudioInputCount                         = static_description.m_AudioInputCount;
+    node->m_AudioOutputCount                        = static_description.m_AudioOutputCount;
+    node->m_ParameterCount                          = static_description.m_ParameterCount;
+    node->m_TriggerInputCount                       = static_description.m_TriggerInputCount;
+    node->m_ResourceCount                           = static_description.m_ResourceCount;
+    node->m_UserData                                = static_description.m_UserData;
+    node->m_IsSkippedWhenSilent                     = (static_description.m_Flags & NODE_FLAG_SILENT_IN_SILENT_OUT) != 0 && static_description.m_AudioInputCount > 0 && static_description.m_TriggerInputCount == 0;
+
+    node->m_ScratchAllocationOffset = *scratch_allocation_offset;
+    node->m_ScratchAllocationCount  = 0;
+    node->m_PassThroughOffset       = *pass_through_offset;
+    node->m_PassThroughCount        = 0;
+    for (TAudioSocketIndex i = 0; i < node_description->m_NodeStaticDescription.m_AudioOutputCount; ++i)
+    {
+        const AudioOutputDescription* output_description = &node_description->m_NodeStaticDescription.m_AudioOutputDescriptions[i];
+        node->m_ScratchAllocationCount += IsAllocatingOutput(output_description) ? 1 : 0;
+        node->m_PassThroughCount += output_description->m_Mode == AudioOutputDescription::PASS_THROUGH ? 1 : 0;
+    }
+    *scratch_allocation_offset += node->m_ScratchAllocationCount;
+    *pass_through_offset += node->m_PassThroughCount;
+
+    for (TParameterIndex i = 0; i < node_description->m_NodeStaticDescription.m_ParameterCount; ++i)
+    {
+        const ParameterDescription* parameter_description = &node_description->m_NodeStaticDescription.m_ParameterDescriptions[i];
+        graph->m_Parameters[node->m_ParametersOffset + i] = parameter_description->m_InitialValue;
+    }
+
+    node->m_DependencyCount = GetDependencies(node_index, node_description, audio_connections, trigger_connections, &graph->m_Dependencies[node->m_DependencyOffset]);
 
     *dependenceny_offset += node->m_DependencyCount;
 
-    graph->m_TriggerInputs[node_index].m_Buffer = &graph->m_Triggers[node_index * graph->m_MaxTriggerEventCount];
-    graph->m_TriggerInputs[node_index].m_Count  = 0;
+    node->m_ContextMemoryOffset = *context_memory_offset;
+    *context_memory_offset += node_runtime_description->m_ContextMemorySize;
+    return node;
+}
+
+bool SetResource(HGraph graph, TNodeIndex node_index, TResourceIndex resource_index, const Resource* resource)
+{
+    Node*     node = &graph->m_Nodes[node_index];
+    Resource* r    = &graph->m_Resources[node->m_ResourcesOffset + resource_index];
+    r->m_Data      = resource->m_Data;
+    r->m_Size      = resource->m_Size;
+    return true;
+}
+
+static uint32_t GetCommandIndexCount(const Node* node, const Command& command)
+{
+    switch (command.m_Type)
+    {
+        case Command::SET_PARAMETER:
+            return node->m_ParameterCount;
+        case Command::TRIGGER:
+            return node->m_TriggerInputCount;
+        default:
+            return node->m_ResourceCount;
+    }
+}
+
+// The indexes are checked here, ApplyCommands runs on the render thread and trusts them
+static bool PostCommand(HGraph graph, const Command& command)
+{
+    if (command.m_NodeIndex >= graph->m_NodeCount || command.m_Index >= GetCommandIndexCount(&graph->m_Nodes[command.m_NodeIndex], command))
+    {
+        return false;
+    }
+    CommandQueue* command_queue = &graph->m_CommandQueue;
+    uint32_t      write_index   = command_queue->m_WriteIndex.load(std::memory_order_relaxed);
+    uint32_t      read_index    = command_queue->m_ReadIndex.load(std::memory_order_acquire);
+    if (write_index - read_index == command_queue->m_Capacity)
+    {
+        return false;
+    }
+    command_queue->m_Commands[write_index & (command_queue->m_Capacity - 1)] = command;
+    command_queue->m_WriteIndex.store(write_index + 1, std::memory_order_release);
+    return true;
+}
+
+uint32_t GetDroppedEventCount(HGraph graph)
+{
+    return graph->m_DroppedEventCount.load(std::memory_order_relaxed);
+}
+
+#if SOGO_PROFILING
+static int CompareProfileTicks(const void* a, const void* b)
+{
+    uint32_t ticks_a = *(const uint32_t*)a;
+    uint32_t ticks_b = *(const uint32_t*)b;
+    return ticks_a < ticks_b ? -1 : (ticks_a > ticks_b ? 1 : 0);
+}
+
+// The slot of the batch being rendered is never read, older slots may be overwritten while we
+// read them if the reader is slower than the renderer which only skews the figures
+static uint32_t GetProfileBatchCount(HGraph graph, uint32_t* out_completed_count)
+{
+    *out_completed_count = graph->m_ProfileBatchCount.load(std::memory_order_acquire);
+    return *out_completed_count < SOGO_PROFILE_BATCH_COUNT - 1 ? *out_completed_count : SOGO_PROFILE_BATCH_COUNT - 1;
+}
+
+static void AddProfileBatchTicks(HGraph graph, TNodeIndex node_index, uint32_t completed_count, uint32_t batch_count, uint32_t* out_ticks)
+{
+    const std::atomic<uint32_t>* node_ticks = &graph->m_ProfileTicks[node_index * SOGO_PROFILE_BATCH_COUNT];
+    for (uint32_t b = 0; b < batch_count; ++b)
+    {
+        out_ticks[b] += node_ticks[(completed_count - 1 - b) % SOGO_PROFILE_BATCH_COUNT].load(std::memory_order_relaxed);
+    }
+}
+
+static bool MakeNodeProfile(uint32_t* ticks, uint32_t batch_count, NodeProfile* out_profile)
+{
+    if (batch_count == 0)
+    {
+        return false;
+    }
+    qsort(ticks, batch_count, sizeof(uint32_t), CompareProfileTicks);
+    uint64_t total_ticks = 0;
+    for (uint32_t b = 0; b < batch_count; ++b)
+    {
+        total_ticks += ticks[b];
+    }
+    out_profile->m_BatchCount   = batch_count;
+    out_profile->m_MinTicks     = ticks[0];
+    out_profile->m_AverageTicks = (uint32_t)(total_ticks / batch_count);
+    out_profile->m_MaxTicks     = ticks[batch_count - 1];
+    out_profile->m_P99Ticks     = ticks[(batch_count * 99 + 99) / 100 - 1];
+    return true;
+}
+#endif
+
+bool GetNodeProfile(HGraph graph, TNodeIndex node_index, NodeProfile* out_profile)
+{
+#if SOGO_PROFILING
+    if (node_index >= graph->m_NodeCount)
+    {
+        return false;
+    }
+    uint32_t ticks[SOGO_PROFILE_BATCH_COUNT - 1];
+    memset(ticks, 0, sizeof(ticks));
+    uint32_t completed_count;
+    uint32_t batch_count = GetProfileBatchCount(graph, &completed_count);
+    AddProfileBatchTicks(graph, node_index, completed_count, batch_count, ticks);
+    return MakeNodeProfile(ticks, batch_count, out_profile);
+#else
+    (void)graph;
+    (void)node_index;
+    (void)out_profile;
+    return false;
+#endif
+}
+
+bool GetNodeTypeProfile(HGraph graph, const NodeStaticDescription* node_static_description, NodeProfile* out_profile)
+{
+#if SOGO_PROFILING
+    uint32_t ticks[SOGO_PROFILE_BATCH_COUNT - 1];
+    memset(ticks, 0, sizeof(ticks));
+    uint32_t completed_count;
+    uint32_t batch_count = GetProfileBatchCount(graph, &completed_count);
+    bool     has_node    = false;
+    for (TNodeIndex node_index = 0; node_index < graph->m_NodeCount; ++node_index)
+    {
+        if (graph->m_Nodes[node_index].m_NodeType == node_static_description->m_GetNodeRuntimeDescCallback)
+        {
+            AddProfileBatchTicks(graph, node_index, completed_count, batch_count, ticks);
+            has_node = true;
+        }
+    }
+    return has_node && MakeNodeProfile(ticks, batch_count, out_profile);
+#else
+    (void)graph;
+    (void)node_static_description;
+    (void)out_profile;
+    return false;
+#endif
+}
+
+bool PostParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value, TFrameIndex frame_offset)
+{
+    Command command;
+    command.m_Type        = Command::SET_PARAMETER;
+    command.m_Index       = parameter_index;
+    command.m_NodeIndex   = node_index;
+    command.m_FrameOffset = frame_offset;
+    command.m_Parameter   = value;
+    return PostCommand(graph, command);
+}
+
+bool PostTrigger(HGraph graph, TNodeIndex node_index, TTriggerSocketIndex trigger_index, TFrameIndex frame_offset)
+{
+    Command command;
+    command.m_Type        = Command::TRIGGER;
+    command.m_Index       = trigger_index;
+    command.m_NodeIndex   = node_index;
+    command.m_FrameOffset = frame_offset;
+    return PostCommand(graph, command);
+}
+
+bool PostResource(HGraph graph, TNodeIndex node_index, TResourceIndex resource_index, const Resource* resource)
+{
+    Command command;
+    command.m_Type        = Command::SET_RESOURCE;
+    command.m_Index       = resource_index;
+    command.m_NodeIndex   = node_index;
+    command.m_FrameOffset = 0;
+    command.m_Resource    = *resource;
+    return PostCommand(graph, command);
+}
+
+static void MakeRenderJob(HGraph graph, TNodeIndex node_index, RenderJob* out_render_job)
+{
+    Node* node                              = &graph->m_Nodes[node_index];
+    out_render_job->m_RenderCallback        = RenderNode;
+    out_render_job->m_Graph                 = graph;
+    out_render_job->m_Node                  = node;
+    out_render_job->m_DependencyCount       = node->m_DependencyCount;
+    out_render_job->m_Dependencies          = &graph->m_Dependencies[node->m_DependencyOffset];
+    RenderParameters& render_parameters     = out_render_job->m_RenderParameters;
+    render_parameters.m_AllocateAudioBuffer = AllocatePlannedAudioBuffer;
+    render_parameters.m_FrameRate           = graph->m_FrameRate;
+    render_parameters.m_FrameCount          = 0;
+    render_parameters.m_AudioInputs         = &graph->m_AudioInputs[node->m_AudioInputsOffset];
+    render_parameters.m_AudioInputCount     = node->m_AudioInputCount;
+    render_parameters.m_AudioOutputs        = &graph->m_AudioOutputs[node->m_AudioOutputsOffset];
+    render_parameters.m_Parameters          = &graph->m_Parameters[node->m_ParametersOffset];
+    render_parameters.m_Resources           = &graph->m_Resources[node->m_ResourcesOffset];
+    render_parameters.m_EventInput          = node->m_HasEventInput ? &graph->m_EventInputs[node->m_EventInputOffset] : 0x0;
+    render_parameters.m_TriggerOutputs      = &graph->m_TriggerOutputs[node->m_TriggerOutputOffset];
+    render_parameters.m_ContextMemory       = &graph->m_ContextMemory[node->m_ContextMemoryOffset];
+}
+
+// Inverts the dependencies so each render job knows which render jobs are waiting for it,
+// the pending dependency counters are restored by the worker that dispatches the job
+static void MakeSchedule(HGraph graph)
+{
+    TNodeIndex node_count = graph->m_NodeCount;
+    if (node_count == 0)
+    {
+        return;
+    }
+
+    TNodeIndex* schedule_index = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        schedule_index[graph->m_RenderOrder[i]] = i;
+    }
+
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        ScheduleNode* schedule_node      = &graph->m_ScheduleNodes[i];
+        schedule_node->m_DependencyCount = graph->m_Nodes[graph->m_RenderOrder[i]].m_DependencyCount;
+        schedule_node->m_DependentCount  = 0;
+        schedule_node->m_PendingDependencyCount.store(schedule_node->m_DependencyCount, std::memory_order_relaxed);
+    }
+
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        const Node*       node         = &graph->m_Nodes[graph->m_RenderOrder[i]];
+        const TNodeIndex* dependencies = &graph->m_Dependencies[node->m_DependencyOffset];
+        for (TNodeIndex d = 0; d < node->m_DependencyCount; ++d)
+        {
+            graph->m_ScheduleNodes[schedule_index[dependencies[d]]].m_DependentCount += 1;
+        }
+    }
+
+    TNodeIndex dependents_offset = 0;
+    TNodeIndex root_count        = 0;
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        ScheduleNode* schedule_node       = &graph->m_ScheduleNodes[i];
+        schedule_node->m_DependentsOffset = dependents_offset;
+        dependents_offset += schedule_node->m_DependentCount;
+        schedule_node->m_DependentCount = 0;
+        if (schedule_node->m_DependencyCount == 0)
+        {
+            graph->m_ScheduleRoots[root_count++] = i;
+        }
+    }
+    graph->m_ScheduleRootCount = root_count;
+
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        const Node*       node         = &graph->m_Nodes[graph->m_RenderOrder[i]];
+        const TNodeIndex* dependencies = &graph->m_Dependencies[node->m_DependencyOffset];
+        for (TNodeIndex d = 0; d < node->m_DependencyCount; ++d)
+        {
+            ScheduleNode* dependency_node = &graph->m_ScheduleNodes[schedule_index[dependencies[d]]];
+            graph->m_ScheduleDependents[dependency_node->m_DependentsOffset + dependency_node->m_DependentCount++] = i;
+        }
+    }
+
+    // The render jobs are in topological order so all dependencies have their level assigned
+    // before it is needed. Level zero holds the nodes without dependencies.
+    TNodeIndex* level       = (TNodeIndex*)alloca(sizeof(TNodeIndex) * node_count);
+    TNodeIndex  level_count = 0;
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        const Node*       node         = &graph->m_Nodes[graph->m_RenderOrder[i]];
+        const TNodeIndex* dependencies = &graph->m_Dependencies[node->m_DependencyOffset];
+        level[i]                       = 0;
+        for (TNodeIndex d = 0; d < node->m_DependencyCount; ++d)
+        {
+            TNodeIndex dependency_level = level[schedule_index[dependencies[d]]];
+            if (dependency_level + 1 > level[i])
+            {
+                level[i] = (TNodeIndex)(dependency_level + 1);
+            }
+        }
+        if (level[i] + 1 > level_count)
+        {
+            level_count = (TNodeIndex)(level[i] + 1);
+        }
+    }
+
+    TNodeIndex* level_offsets = graph->m_LevelOffsets;
+    memset(level_offsets, 0, sizeof(TNodeIndex) * (level_count + 1));
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        level_offsets[level[i] + 1] += 1;
+    }
+    for (TNodeIndex l = 0; l < level_count; ++l)
+    {
+        level_offsets[l + 1] += level_offsets[l];
+    }
+    // Use the schedule index array as fill counters, it is no longer needed
+    TNodeIndex* level_fill_count = schedule_index;
+    memset(level_fill_count, 0, sizeof(TNodeIndex) * level_count);
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        graph->m_LevelJobs[level_offsets[level[i]] + level_fill_count[level[i]]++] = i;
+    }
+    graph->m_LevelCount = level_count;
+}
+
+static void InitNodes(HGraph graph, const GraphRuntimeSettings* graph_runtime_settings)
+{
+    for (TNodeIndex node_index = 0; node_index < graph->m_NodeCount; ++node_index)
+    {
+        Node* node = &graph->m_Nodes[node_index];
+        if (node->m_Init)
+        {
+            node->m_Init(graph, node, graph_runtime_settings, node->m_UserData, &graph->m_ContextMemory[node->m_ContextMemoryOffset]);
+        }
+    }
+}
+
+// The nodes that read an output, to tell if the output is kept constant
+static const uint8_t CONSTANT_READER = 1;
+static const uint8_t SAMPLE_READER   = 2;
+
+// Points the tables of the graph into the graph memory at base, returns the end of the tables
+static TGraphSize LayoutGraph(HGraph graph, uintptr_t base, TNodeIndex node_count, const GraphProperties* graph_properties)
+{
+    TGraphSize offset = ALIGN_SIZE(sizeof(Graph), sizeof(void*));
+
+    graph->m_Parameters = (TParameter*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TParameter) * graph_properties->m_ParameterCount, sizeof(void*));
+
+    graph->m_Resources = (Resource*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(Resource) * graph_properties->m_ResourceCount, sizeof(RenderCallback));
+
+    graph->m_Nodes = (Node*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(Node) * node_count, sizeof(RenderJob*));
+
+    graph->m_RenderJobs = (RenderJob*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(RenderJob) * node_count, sizeof(uint32_t));
+
+    graph->m_ScratchAllocations = (ScratchAllocation*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(ScratchAllocation) * graph_properties->m_ScratchAllocationCount, sizeof(void*));
+
+    graph->m_PassThroughs = (PassThrough*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(PassThrough) * graph_properties->m_PassThroughCount, sizeof(void*));
+
+    graph->m_CommandQueue.m_Commands = (Command*)(base + offset);
+    graph->m_CommandQueue.m_Capacity = graph_properties->m_CommandCapacity;
+    offset += ALIGN_SIZE(sizeof(Command) * graph_properties->m_CommandCapacity, sizeof(AudioOutput*));
+
+    graph->m_AudioInputs = (AudioInput*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(AudioInput) * graph_properties->m_AudioInputCount, sizeof(float*));
+
+    graph->m_AudioOutputs = (AudioOutput*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(AudioOutput) * (graph_properties->m_AudioOutputCount + 1), sizeof(TTriggerSocketIndex*));
+
+    graph->m_EventInputs = (EventInput*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(EventInput) * (graph_properties->m_EventInputCount), sizeof(EventQueue*));
+
+    graph->m_EventQueues = (EventQueue*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(EventQueue) * (graph_properties->m_EventInputCount), sizeof(TNodeIndex));
+
+    graph->m_TriggerOutputs = (TriggerOutput*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TriggerOutput) * (graph_properties->m_TriggerOutputCount), sizeof(TNodeIndex));
+
+    graph->m_Dependencies = (TNodeIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TNodeIndex) * (graph_properties->m_DependencyCount), sizeof(TNodeIndex));
+
+    graph->m_RenderOrder = (TNodeIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TNodeIndex) * node_count, sizeof(ScheduleNode));
+
+    graph->m_ScheduleNodes = (ScheduleNode*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(ScheduleNode) * node_count, sizeof(TNodeIndex));
+
+    graph->m_ScheduleDependents = (TNodeIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TNodeIndex) * (graph_properties->m_DependencyCount), sizeof(TNodeIndex));
+
+    graph->m_ScheduleRoots = (TNodeIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TNodeIndex) * node_count, sizeof(TNodeIndex));
+
+    graph->m_LevelJobs = (TNodeIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TNodeIndex) * node_count, sizeof(TNodeIndex));
+
+    graph->m_LevelOffsets = (TNodeIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TNodeIndex) * (node_count + 1), sizeof(uint32_t));
+
+    graph->m_ScratchAllocationIndexes = (TAudioSocketIndex*)(base + offset);
+    offset += ALIGN_SIZE(sizeof(TAudioSocketIndex) * node_count, sizeof(uint32_t));
+
+#if SOGO_PROFILING
+    graph->m_ProfileTicks = (std::atomic<uint32_t>*)(base + offset);
+    offset += GetProfileSize(node_count);
+#endif
+    return offset;
+}
+
+// Resolves everything about the graph that lives in graph_mem. The graph is not pointed at its
+// other buffers and has no render jobs until BindGraph.
+static HGraph BuildGraph(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+void*                       graph_mem,
+GraphProperties*            out_graph_properties)
+{
+    // Layout conversions are created as nodes of their own
+    TNodeIndex conversion_count = 0;
+    if (!InsertLayoutConversions(graph_description, 0x0, 0x0, &conversion_count, 0x0))
+    {
+        return 0x0;
+    }
+    GraphDescription converted_description;
+    if (conversion_count > 0)
+    {
+        NodeDescription*     node_descriptions = (NodeDescription*)alloca(sizeof(NodeDescription) * (graph_description->m_NodeCount + conversion_count));
+        NodeAudioConnection* audio_connections = (NodeAudioConnection*)alloca(sizeof(NodeAudioConnection) * (GetAudioConnectionCount(graph_description) + conversion_count));
+        InsertLayoutConversions(graph_description, node_descriptions, audio_connections, &conversion_count, &converted_description);
+        graph_description = &converted_description;
+    }
+
+    if (!GetGraphProperties(graph_description, graph_runtime_settings, out_graph_properties))
+    {
+        return 0x0;
+    }
+    const GraphProperties& graph_properties = *out_graph_properties;
+
+    HGraph     graph      = (HGraph)graph_mem;
+    memset(graph_mem, 0, GetGraphSize(graph_description->m_NodeCount, &graph_properties));
+
+    graph->m_FrameRate              = graph_runtime_settings->m_FrameRate;
+    graph->m_MaxTriggerEventCount   = graph_runtime_settings->m_MaxTriggerEventCount;
+    graph->m_NodeCount              = graph_description->m_NodeCount;
+    graph->m_ScratchAllocationCount = graph_properties.m_ScratchAllocationCount;
+
+    LayoutGraph(graph, (uintptr_t)graph_mem, graph_description->m_NodeCount, &graph_properties);
+
+    TNodeIndex         node_offset            = 0;
+    TAudioInputOffset  input_offset           = 0;
+    TAudioOutputOffset output_offset          = 1; // Zero is reserved for unconnected inputs
+    TParameterOffset   parameters_offset      = 0;
+    TResourceOffset    resources_offset       = 0;
+    TTriggerOffset     triggers_input_offset  = 0;
+    TTriggerOffset     triggers_output_offset = 0;
+    TNodeIndex         dependenceny_offset    = 0;
+    TAudioOutputOffset allocation_offset      = 0;
+    TAudioOutputOffset pass_through_offset    = 0;
+    TContextMemorySize context_memory_offset  = 0;
+
+    NodeAudioConnection const** audio_connections      = (NodeAudioConnection const**)alloca(sizeof(NodeAudioConnection*) * graph_description->m_NodeCount);
+    const NodeAudioConnection*  node_audio_connections = graph_description->m_AudioConnections;
+
+    NodeTriggerConnection const** trigger_connections      = (NodeTriggerConnection const**)alloca(sizeof(NodeTriggerConnection*) * graph_description->m_NodeCount);
+    const NodeTriggerConnection*  node_trigger_connections = graph_description->m_TriggerConnections;
+
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        audio_connections[node_index]           = node_audio_connections;
+        node_audio_connections += node_description.m_AudioConnectionCount;
+
+        trigger_connections[node_index] = node_trigger_connections;
+        node_trigger_connections += node_description.m_TriggerConnectionCount;
+    }
+
+    // Each node need to know how many trigger connections it has!
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        NodeRuntimeDescription node_runtime_description;
+        GetRuntimeDescription(&node_description.m_NodeStaticDescription, graph_runtime_settings, &node_runtime_description);
+        MakeNode(
+        graph,
+        &node_description,
+        &node_runtime_description,
+        audio_connections,
+        trigger_connections,
+        &node_offset,
+        &input_offset,
+        &output_offset,
+        &parameters_offset,
+        &resources_offset,
+        &triggers_input_offset,
+        &triggers_output_offset,
+        &dependenceny_offset,
+        &allocation_offset,
+        &pass_through_offset,
+        &context_memory_offset);
+    }
+
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        for (TConnectionIndex i = 0; i < node_description.m_AudioConnectionCount; ++i)
+        {
+            const NodeAudioConnection* node_connection   = &audio_connections[node_index][i];
+            Node*                      input_node        = &graph->m_Nodes[node_index];
+            TAudioInputOffset          graph_input_index = input_node->m_AudioInputsOffset + node_connection->m_InputIndex;
+            if (graph->m_AudioInputs[graph_input_index].m_AudioOutput != 0x0)
+            {
+                return 0x0;
+            }
+            if (node_connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+            {
+                graph->m_AudioInputs[graph_input_index].m_AudioOutput = graph_description->m_ExternalAudioInputs[node_connection->m_OutputIndex];
+            }
+            else
+            {
+                TNodeIndex output_node_index                          = (TNodeIndex)(node_index + node_connection->m_OutputNodeOffset);
+                Node*      output_node                                = &graph->m_Nodes[output_node_index];
+                graph->m_AudioInputs[graph_input_index].m_AudioOutput = &graph->m_AudioOutputs[output_node->m_AudioOutputsOffset + node_connection->m_OutputIndex];
+            }
+        }
+
+        for (TConnectionIndex i = 0; i < node_description.m_TriggerConnectionCount; ++i)
+        {
+            const NodeTriggerConnection* node_connection            = &trigger_connections[node_index][i];
+            TNodeIndex                   output_node_index          = (TNodeIndex)(node_index + node_connection->m_OutputNodeOffset);
+            Node*                        output_node                = &graph->m_Nodes[output_node_index];
+            TTriggerOffset               graph_output_index         = output_node->m_TriggerOutputOffset + node_connection->m_OutputIndex;
+            graph->m_TriggerOutputs[graph_output_index].m_InputNode = node_index;
+            graph->m_TriggerOutputs[graph_output_index].m_Trigger   = node_connection->m_InputTriggerIndex;
+        }
+    }
+
+    // Constant outputs are kept as a single frame if all nodes reading them handle constant inputs
+    uint8_t* output_readers = (uint8_t*)alloca(graph_properties.m_AudioOutputCount + 1);
+    memset(output_readers, 0, graph_properties.m_AudioOutputCount + 1);
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        uint8_t                reader           = (node_description.m_NodeStaticDescription.m_Flags & NODE_FLAG_CONSTANT_INPUTS) ? CONSTANT_READER : SAMPLE_READER;
+        for (TConnectionIndex i = 0; i < node_description.m_AudioConnectionCount; ++i)
+        {
+            const NodeAudioConnection* node_connection = &audio_connections[node_index][i];
+            if (node_connection->m_OutputNodeOffset != EXTERNAL_NODE_OFFSET)
+            {
+                const Node* output_node = &graph->m_Nodes[node_index + node_connection->m_OutputNodeOffset];
+                output_readers[output_node->m_AudioOutputsOffset + node_connection->m_OutputIndex] |= reader;
+            }
+        }
+    }
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        Node* node                   = &graph->m_Nodes[node_index];
+        node->m_KeepsConstantOutputs = true;
+        for (TAudioSocketIndex i = 0; i < node->m_AudioOutputCount; ++i)
+        {
+            node->m_KeepsConstantOutputs &= output_readers[node->m_AudioOutputsOffset + i] == CONSTANT_READER;
+        }
+    }
+
+    // Unconnected inputs read the reserved output which is always silent
+    graph->m_AudioOutputs[0].m_IsSilent = true;
+    for (TAudioInputOffset i = 0; i < graph_properties.m_AudioInputCount; ++i)
+    {
+        if (graph->m_AudioInputs[i].m_AudioOutput == 0x0)
+        {
+            graph->m_AudioInputs[i].m_AudioOutput = &graph->m_AudioOutputs[0];
+        }
+    }
+
+    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    {
+        Node*        node           = &graph->m_Nodes[node_index];
+        AudioOutput* render_outputs = &graph->m_AudioOutputs[node->m_AudioOutputsOffset];
+
+        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
+        for (TAudioSocketIndex j = 0; j < node_description.m_NodeStaticDescription.m_AudioOutputCount; ++j)
+        {
+            if (!GetOutputChannelCount(graph_description, graph_runtime_settings, node_index, audio_connections, j, &render_outputs[j].m_ChannelCount))
+            {
+                return 0x0;
+            }
+            render_outputs[j].m_IsPlanar      = IsPlanar(&node_description.m_NodeStaticDescription);
+            render_outputs[j].m_ChannelStride = render_outputs[j].m_IsPlanar ? GetChannelStride(graph_runtime_settings->m_MaxBatchSize) : 0;
+        }
+        if ((node_description.m_NodeStaticDescription.m_Flags & NODE_FLAG_MONO_OR_MATCHING_INPUTS) && !HasMonoOrMatchingInputs(graph_description, graph_runtime_settings, node_index, audio_connections))
+        {
+            return 0x0;
+        }
+    }
+
+    uint32_t scratch_sample_count            = 0;
+    uint32_t concurrent_scratch_sample_count = 0;
+    if (!PlanScratchBuffer(graph_description, graph_runtime_settings, audio_connections, trigger_connections, graph->m_RenderOrder, graph->m_ScratchAllocations, graph->m_PassThroughs, &scratch_sample_count, &concurrent_scratch_sample_count))
+    {
+        return 0x0;
+    }
+
+    MakeSchedule(graph);
+    return graph;
+}
+
+// Points the graph at its buffers, empties the event inputs and resolves the render jobs
+static void BindGraph(HGraph graph, const GraphProperties* graph_properties, const GraphBuffers* graph_buffers)
+{
+    assert(((uintptr_t)graph_buffers->m_ScratchBufferMem & (SCRATCH_BUFFER_ALIGNMENT - 1)) == 0);
+    assert(((uintptr_t)graph_buffers->m_ConcurrentScratchBufferMem & (SCRATCH_BUFFER_ALIGNMENT - 1)) == 0);
+    graph->m_Events                  = (NodeEvent*)graph_buffers->m_TriggerBufferMem;
+    graph->m_PendingEvents           = (PendingEvent*)&graph->m_Events[graph_properties->m_EventInputCount * graph->m_MaxTriggerEventCount];
+    graph->m_ScratchBuffer           = (float*)graph_buffers->m_ScratchBufferMem;
+    graph->m_ContextMemory           = (uint8_t*)graph_buffers->m_ContextMem;
+    graph->m_ConcurrentScratchBuffer = (float*)graph_buffers->m_ConcurrentScratchBufferMem;
+
+    for (TNodeIndex node_index = 0; node_index < graph->m_NodeCount; ++node_index)
+    {
+        if (graph->m_Nodes[node_index].m_HasEventInput)
+        {
+            InitEventInput(graph, &graph->m_Nodes[node_index]);
+        }
+    }
+    for (TNodeIndex i = 0; i < graph->m_NodeCount; ++i)
+    {
+        MakeRenderJob(graph, graph->m_RenderOrder[i], &graph->m_RenderJobs[i]);
+    }
+}
+
+HGraph CreateGraph(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+const GraphBuffers*         graph_buffers)
+{
+    GraphProperties graph_properties;
+    HGraph          graph = BuildGraph(graph_description, graph_runtime_settings, graph_buffers->m_GraphMem, &graph_properties);
+    if (graph == 0x0)
+    {
+        return 0x0;
+    }
+    BindGraph(graph, &graph_properties, graph_buffers);
+    InitNodes(graph, graph_runtime_settings);
+    return graph;
+}
+
+struct GraphPrototype
+{
+    GraphRuntimeSettings m_GraphRuntimeSettings; // For the init callbacks of instantiated graphs
+    GraphProperties      m_GraphProperties;
+    GraphSize            m_GraphSize; // Of each instantiated graph
+};
+
+// The graph image follows the prototype, a graph with the pointers into its graph memory stored
+// as offsets from the start of it and without any pointers into its other buffers
+static TGraphSize GetPrototypeHeaderSize()
+{
+    return ALIGN_SIZE(sizeof(GraphPrototype), sizeof(void*));
+}
+
+static const uint8_t* GetGraphImage(HGraphPrototype prototype)
+{
+    return (const uint8_t*)prototype + GetPrototypeHeaderSize();
+}
+
+// Tags the external audio inputs of a graph image, they point outside of the graph memory
+static const uintptr_t EXTERNAL_AUDIO_OUTPUT = 1;
+
+static void* Relocate(const void* pointer, uintptr_t from, uintptr_t to)
+{
+    return (void*)((uintptr_t)pointer - from + to);
+}
+
+// Moves the pointers into the graph memory from the address from to the address to
+static void RelocateGraph(HGraph graph, TAudioInputOffset audio_input_count, uintptr_t from, uintptr_t to)
+{
+    graph->m_Parameters               = (TParameter*)Relocate(graph->m_Parameters, from, to);
+    graph->m_Resources                = (Resource*)Relocate(graph->m_Resources, from, to);
+    graph->m_Nodes                    = (Node*)Relocate(graph->m_Nodes, from, to);
+    graph->m_ScratchAllocations       = (ScratchAllocation*)Relocate(graph->m_ScratchAllocations, from, to);
+    graph->m_PassThroughs             = (PassThrough*)Relocate(graph->m_PassThroughs, from, to);
+    graph->m_ScratchAllocationIndexes = (TAudioSocketIndex*)Relocate(graph->m_ScratchAllocationIndexes, from, to);
+    graph->m_AudioOutputs             = (AudioOutput*)Relocate(graph->m_AudioOutputs, from, to);
+    graph->m_AudioInputs              = (AudioInput*)Relocate(graph->m_AudioInputs, from, to);
+    graph->m_EventInputs              = (EventInput*)Relocate(graph->m_EventInputs, from, to);
+    graph->m_EventQueues              = (EventQueue*)Relocate(graph->m_EventQueues, from, to);
+    graph->m_TriggerOutputs           = (TriggerOutput*)Relocate(graph->m_TriggerOutputs, from, to);
+    graph->m_Dependencies             = (TNodeIndex*)Relocate(graph->m_Dependencies, from, to);
+    graph->m_RenderJobs               = (RenderJob*)Relocate(graph->m_RenderJobs, from, to);
+    graph->m_RenderOrder              = (TNodeIndex*)Relocate(graph->m_RenderOrder, from, to);
+    graph->m_ScheduleNodes            = (ScheduleNode*)Relocate(graph->m_ScheduleNodes, from, to);
+    graph->m_ScheduleDependents       = (TNodeIndex*)Relocate(graph->m_ScheduleDependents, from, to);
+    graph->m_ScheduleRoots            = (TNodeIndex*)Relocate(graph->m_ScheduleRoots, from, to);
+    graph->m_LevelJobs                = (TNodeIndex*)Relocate(graph->m_LevelJobs, from, to);
+    graph->m_LevelOffsets             = (TNodeIndex*)Relocate(graph->m_LevelOffsets, from, to);
+    graph->m_CommandQueue.m_Commands  = (Command*)Relocate(graph->m_CommandQueue.m_Commands, from, to);
+#if SOGO_PROFILING
+    graph->m_ProfileTicks = (std::atomic<uint32_t>*)Relocate(graph->m_ProfileTicks, from, to);
+#endif
+
+    AudioInput* audio_inputs = (AudioInput*)Relocate(graph->m_AudioInputs, to, (uintptr_t)graph);
+    for (TAudioInputOffset i = 0; i < audio_input_count; ++i)
+    {
+        if (((uintptr_t)audio_inputs[i].m_AudioOutput & EXTERNAL_AUDIO_OUTPUT) == 0)
+        {
+            audio_inputs[i].m_AudioOutput = (AudioOutput*)Relocate(audio_inputs[i].m_AudioOutput, from, to);
+        }
+    }
+}
+
+// Turns a graph built in place into a graph image
+static void MakeGraphImage(HGraph graph, const GraphProperties* graph_properties)
+{
+    const AudioOutput* audio_outputs_end = &graph->m_AudioOutputs[graph_properties->m_AudioOutputCount + 1];
+    for (TAudioInputOffset i = 0; i < graph_properties->m_AudioInputCount; ++i)
+    {
+        AudioOutput* audio_output = graph->m_AudioInputs[i].m_AudioOutput;
+        if (audio_output < graph->m_AudioOutputs || audio_output >= audio_outputs_end)
+        {
+            graph->m_AudioInputs[i].m_AudioOutput = (AudioOutput*)((uintptr_t)audio_output | EXTERNAL_AUDIO_OUTPUT);
+        }
+    }
+    RelocateGraph(graph, graph_properties->m_AudioInputCount, (uintptr_t)graph, 0);
+}
+
+// The copy still needs BindGraph and InitNodes
+static HGraph CopyGraphImage(const uint8_t* graph_image, TGraphSize graph_size, const GraphProperties* graph_properties, void* graph_mem)
+{
+    memcpy(graph_mem, graph_image, graph_size);
+
+    HGraph graph = (HGraph)graph_mem;
+    RelocateGraph(graph, graph_properties->m_AudioInputCount, 0, (uintptr_t)graph);
+    for (TAudioInputOffset i = 0; i < graph_properties->m_AudioInputCount; ++i)
+    {
+        graph->m_AudioInputs[i].m_AudioOutput = (AudioOutput*)((uintptr_t)graph->m_AudioInputs[i].m_AudioOutput & ~EXTERNAL_AUDIO_OUTPUT);
+    }
+    return graph;
+}
+
+bool GetPrototypeSize(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+TGraphSize*                 out_prototype_size)
+{
+    TNodeIndex      node_count;
+    GraphProperties graph_properties;
+    TGraphSize      graph_size;
+    if (!GetConvertedGraphProperties(graph_description, graph_runtime_settings, &node_count, &graph_properties, &graph_size))
+    {
+        return false;
+    }
+    *out_prototype_size = GetPrototypeHeaderSize() + graph_size;
+    return true;
+}
+
+HGraphPrototype CreatePrototype(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+void*                       prototype_mem)
+{
+    HGraphPrototype prototype = (HGraphPrototype)prototype_mem;
+    HGraph          graph     = BuildGraph(graph_description, graph_runtime_settings, (uint8_t*)prototype_mem + GetPrototypeHeaderSize(), &prototype->m_GraphProperties);
+    if (graph == 0x0)
+    {
+        return 0x0;
+    }
+    const GraphProperties* graph_properties = &prototype->m_GraphProperties;
+    prototype->m_GraphRuntimeSettings       = *graph_runtime_settings;
+    GetBufferSizes(graph_runtime_settings, graph_properties, GetGraphSize(graph->m_NodeCount, graph_properties), &prototype->m_GraphSize);
+    MakeGraphImage(graph, graph_properties);
+    return prototype;
+}
+
+void GetPrototypeGraphSize(HGraphPrototype prototype, GraphSize* out_graph_size)
+{
+    *out_graph_size = prototype->m_GraphSize;
+}
+
+HGraph InstantiateGraph(HGraphPrototype prototype, const GraphBuffers* graph_buffers)
+{
+    const GraphProperties* graph_properties = &prototype->m_GraphProperties;
+    HGraph                 graph            = CopyGraphImage(GetGraphImage(prototype), prototype->m_GraphSize.m_GraphSize, graph_properties, graph_buffers->m_GraphMem);
+    BindGraph(graph, graph_properties, graph_buffers);
+    InitNodes(graph, &prototype->m_GraphRuntimeSettings);
+    return graph;
+}
+
+static const uint32_t COMPILED_GRAPH_MAGIC        = 0x4f474f53u; // "SOGO"
+static const uint32_t COMPILED_GRAPH_VERSION      = 3;
+static const uint32_t LAYOUT_CONVERSION_NODE_TYPE = 0xffffffffu;
+
+// The graph image follows the header, the node types follow the graph image
+struct CompiledGraph
+{
+    uint32_t             m_Magic;
+    uint32_t             m_Version;
+    uint32_t             m_Layout; // GetCompiledGraphLayout, the graph image is only valid with the same layout of the graph structs
+    TGraphSize           m_Size;
+    TGraphSize           m_NodeTypesOffset; // A CompiledNodeType for each node
+    GraphRuntimeSettings m_GraphRuntimeSettings;
+    GraphProperties      m_GraphProperties;
+    GraphSize            m_GraphSize; // Of each instantiated graph
+};
+
+// The node type of a node and the fields of its static description that the graph image does not
+// keep, they must match the node type the graph is loaded with
+struct CompiledNodeType
+{
+    uint32_t            m_NodeType; // Index into the node types, LAYOUT_CONVERSION_NODE_TYPE for inserted conversions
+    TResourceIndex      m_ResourceCount;
+    TTriggerSocketIndex m_TriggerOutputCount;
+    TNodeFlags          m_Flags;
+};
+
+// Hash of the size of every struct stored in a compiled graph and the offset of each of their
+// fields, a compiled graph does not load if any of them moved
+static uint32_t GetCompiledGraphLayout()
+{
+    static const uint32_t LAYOUT[] = {
+        sizeof(void*),
+        sizeof(CompiledGraph),
+        offsetof(CompiledGraph, m_Magic),
+        offsetof(CompiledGraph, m_Version),
+        offsetof(CompiledGraph, m_Layout),
+        offsetof(CompiledGraph, m_Size),
+        offsetof(CompiledGraph, m_NodeTypesOffset),
+        offsetof(CompiledGraph, m_GraphRuntimeSettings),
+        offsetof(CompiledGraph, m_GraphProperties),
+        offsetof(CompiledGraph, m_GraphSize),
+        sizeof(CompiledNodeType),
+        offsetof(CompiledNodeType, m_NodeType),
+        offsetof(CompiledNodeType, m_ResourceCount),
+        offsetof(CompiledNodeType, m_TriggerOutputCount),
+        offsetof(CompiledNodeType, m_Flags),
+        sizeof(GraphRuntimeSettings),
+        offsetof(GraphRuntimeSettings, m_FrameRate),
+        offsetof(GraphRuntimeSettings, m_MaxBatchSize),
+        offsetof(GraphRuntimeSettings, m_MaxTriggerEventCount),
+        offsetof(GraphRuntimeSettings, m_MaxCommandCount),
+        sizeof(GraphProperties),
+        offsetof(GraphProperties, m_ParameterCount),
+        offsetof(GraphProperties, m_ResourceCount),
+        offsetof(GraphProperties, m_AudioInputCount),
+        offsetof(GraphProperties, m_AudioOutputCount),
+        offsetof(GraphProperties, m_ScratchAllocationCount),
+        offsetof(GraphProperties, m_PassThroughCount),
+        offsetof(GraphProperties, m_ScratchSampleCount),
+        offsetof(GraphProperties, m_ConcurrentScratchSampleCount),
+        offsetof(GraphProperties, m_CommandCapacity),
+        offsetof(GraphProperties, m_EventInputCount),
+        offsetof(GraphProperties, m_TriggerOutputCount),
+        offsetof(GraphProperties, m_DependencyCount),
+        offsetof(GraphProperties, m_ContextMemorySize),
+        sizeof(GraphSize),
+        offsetof(GraphSize, m_GraphSize),
+        offsetof(GraphSize, m_ScratchBufferSize),
+        offsetof(GraphSize, m_ConcurrentScratchBufferSize),
+        offsetof(GraphSize, m_TriggerBufferSize),
+        offsetof(GraphSize, m_ContextMemorySize),
+        sizeof(Graph),
+        offsetof(Graph, m_Parameters),
+        offsetof(Graph, m_Resources),
+        offsetof(Graph, m_MaxTriggerEventCount),
+        offsetof(Graph, m_Events),
+        offsetof(Graph, m_PendingEvents),
+        offsetof(Graph, m_NodeCount),
+        offsetof(Graph, m_Nodes),
+        offsetof(Graph, m_ScratchBuffer),
+        offsetof(Graph, m_ConcurrentScratchBuffer),
+        offsetof(Graph, m_ScratchAllocations),
+        offsetof(Graph, m_ScratchAllocationCount),
+        offsetof(Graph, m_PassThroughs),
+        offsetof(Graph, m_ScratchAllocationIndexes),
+        offsetof(Graph, m_ContextMemory),
+        offsetof(Graph, m_FrameRate),
+        offsetof(Graph, m_AudioOutputs),
+        offsetof(Graph, m_AudioInputs),
+        offsetof(Graph, m_EventInputs),
+        offsetof(Graph, m_EventQueues),
+        offsetof(Graph, m_DroppedEventCount),
+        offsetof(Graph, m_TriggerOutputs),
+        offsetof(Graph, m_Dependencies),
+        offsetof(Graph, m_RenderJobs),
+        offsetof(Graph, m_RenderOrder),
+        offsetof(Graph, m_ScheduleNodes),
+        offsetof(Graph, m_ScheduleDependents),
+        offsetof(Graph, m_ScheduleRoots),
+        offsetof(Graph, m_ScheduleRootCount),
+        offsetof(Graph, m_LevelJobs),
+        offsetof(Graph, m_LevelOffsets),
+        offsetof(Graph, m_LevelCount),
+        offsetof(Graph, m_CommandQueue),
+#if SOGO_PROFILING
+        offsetof(Graph, m_ProfileTicks),
+        offsetof(Graph, m_ProfileStartedBatchCount),
+        offsetof(Graph, m_ProfileBatchCount),
+#endif
+        sizeof(CommandQueue),
+        offsetof(CommandQueue, m_Commands),
+        offsetof(CommandQueue, m_Capacity),
+        offsetof(CommandQueue, m_WriteIndex),
+        offsetof(CommandQueue, m_ReadIndex),
+        sizeof(Node),
+        offsetof(Node, m_Render),
+        offsetof(Node, m_RenderInstances),
+        offsetof(Node, m_Init),
+        offsetof(Node, m_ParametersOffset),
+        offsetof(Node, m_AudioInputsOffset),
+        offsetof(Node, m_AudioOutputsOffset),
+        offsetof(Node, m_ResourcesOffset),
+        offsetof(Node, m_EventInputOffset),
+        offsetof(Node, m_TriggerOutputOffset),
+        offsetof(Node, m_DependencyCount),
+        offsetof(Node, m_DependencyOffset),
+        offsetof(Node, m_ContextMemoryOffset),
+        offsetof(Node, m_ScratchAllocationOffset),
+        offsetof(Node, m_ScratchAllocationCount),
+        offsetof(Node, m_PassThroughOffset),
+        offsetof(Node, m_PassThroughCount),
+        offsetof(Node, m_AudioInputCount),
+        offsetof(Node, m_AudioOutputCount),
+        offsetof(Node, m_IsSkippedWhenSilent),
+        offsetof(Node, m_KeepsConstantOutputs),
+        offsetof(Node, m_HasEventInput),
+        offsetof(Node, m_ParameterCount),
+        offsetof(Node, m_TriggerInputCount),
+        offsetof(Node, m_ResourceCount),
+        offsetof(Node, m_UserData),
+#if SOGO_PROFILING
+        offsetof(Node, m_NodeType),
+#endif
+        sizeof(ScratchAllocation),
+        offsetof(ScratchAllocation, m_Offset),
+        offsetof(ScratchAllocation, m_ConcurrentOffset),
+        offsetof(ScratchAllocation, m_SampleCount),
+        sizeof(PassThrough),
+        offsetof(PassThrough, m_CopyOffset),
+        offsetof(PassThrough, m_ConcurrentCopyOffset),
+        offsetof(PassThrough, m_OutputIndex),
+        offsetof(PassThrough, m_InputIndex),
+        sizeof(AudioOutput),
+        offsetof(AudioOutput, m_Buffer),
+        offsetof(AudioOutput, m_ChannelCount),
+        offsetof(AudioOutput, m_IsSilent),
+        offsetof(AudioOutput, m_IsConstant),
+        offsetof(AudioOutput, m_IsPlanar),
+        offsetof(AudioOutput, m_ChannelStride),
+        sizeof(AudioInput),
+        sizeof(TriggerOutput),
+        offsetof(TriggerOutput, m_InputNode),
+        offsetof(TriggerOutput, m_Trigger),
+        sizeof(Resource),
+        sizeof(TParameter),
+        sizeof(RenderJob),
+        sizeof(Command),
+        sizeof(EventInput),
+        sizeof(EventQueue),
+        sizeof(ScheduleNode),
+        sizeof(NodeEvent),
+        sizeof(PendingEvent)};
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < sizeof(LAYOUT) / sizeof(LAYOUT[0]); ++i)
+    {
+        hash = (hash ^ LAYOUT[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Layout conversions are told apart by the planar flag recorded for them when compiling
+static const NodeStaticDescription* GetCompiledNodeStaticDescription(const CompiledNodeType* compiled_node_type, const NodeStaticDescription* const* node_types)
+{
+    if (compiled_node_type->m_NodeType == LAYOUT_CONVERSION_NODE_TYPE)
+    {
+        return (compiled_node_type->m_Flags & NODE_FLAG_PLANAR) ? &DeinterleaveNodeDesc : &InterleaveNodeDesc;
+    }
+    return node_types[compiled_node_type->m_NodeType];
+}
+
+static TGraphSize GetCompiledGraphHeaderSize()
+{
+    return ALIGN_SIZE(sizeof(CompiledGraph), sizeof(void*));
+}
+
+static const Graph* GetCompiledGraphImage(HCompiledGraph compiled_graph)
+{
+    return (const Graph*)((const uint8_t*)compiled_graph + GetCompiledGraphHeaderSize());
+}
+
+static const CompiledNodeType* GetCompiledNodeTypes(HCompiledGraph compiled_graph)
+{
+    return (const CompiledNodeType*)((const uint8_t*)compiled_graph + compiled_graph->m_NodeTypesOffset);
+}
+
+static uint32_t FindNodeType(const NodeStaticDescription* const* node_types, uint32_t node_type_count, const NodeStaticDescription* node_static_description)
+{
+    for (uint32_t i = 0; i < node_type_count; ++i)
+    {
+        const NodeStaticDescription* node_type = node_types[i];
+        if (node_type->m_GetNodeRuntimeDescCallback == node_static_description->m_GetNodeRuntimeDescCallback &&
+            node_type->m_AudioInputCount == node_static_description->m_AudioInputCount &&
+            node_type->m_AudioOutputCount == node_static_description->m_AudioOutputCount &&
+            node_type->m_ResourceCount == node_static_description->m_ResourceCount &&
+            node_type->m_ParameterCount == node_static_description->m_ParameterCount &&
+            node_type->m_TriggerInputCount == node_static_description->m_TriggerInputCount &&
+            node_type->m_TriggerOutputCount == node_static_description->m_TriggerOutputCount &&
+            node_type->m_Flags == node_static_description->m_Flags &&
+            node_type->m_UserData.m_Int == node_static_description->m_UserData.m_Int)
+        {
+            return i;
+        }
+    }
+    return node_type_count;
+}
+
+bool GetCompiledGraphSize(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+TGraphSize*                 out_compiled_graph_size)
+{
+    TNodeIndex      node_count;
+    GraphProperties graph_properties;
+    TGraphSize      graph_size;
+    if (!GetConvertedGraphProperties(graph_description, graph_runtime_settings, &node_count, &graph_properties, &graph_size))
+    {
+        return false;
+    }
+    *out_compiled_graph_size = GetCompiledGraphHeaderSize() + ALIGN_SIZE(graph_size, sizeof(uint32_t)) + sizeof(CompiledNodeType) * node_count;
+    return true;
+}
+
+bool CompileGraph(
+const GraphDescription*             graph_description,
+const GraphRuntimeSettings*         graph_runtime_settings,
+const NodeStaticDescription* const* node_types,
+uint32_t                            node_type_count,
+void*                               compiled_graph_mem)
+{
+    // External audio inputs are addresses in the process that compiles the graph
+    uint32_t audio_connection_count = GetAudioConnectionCount(graph_description);
+    for (uint32_t i = 0; i < audio_connection_count; ++i)
+    {
+        if (graph_description->m_AudioConnections[i].m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
+        {
+            return false;
+        }
+    }
+
+    CompiledGraph* compiled_graph = (CompiledGraph*)compiled_graph_mem;
+    memset(compiled_graph, 0, GetCompiledGraphHeaderSize());
+    HGraph graph = BuildGraph(graph_description, graph_runtime_settings, (uint8_t*)compiled_graph_mem + GetCompiledGraphHeaderSize(), &compiled_graph->m_GraphProperties);
+    if (graph == 0x0)
+    {
+        return false;
+    }
+    const GraphProperties* graph_properties = &compiled_graph->m_GraphProperties;
+    TGraphSize             graph_size       = GetGraphSize(graph->m_NodeCount, graph_properties);
+    compiled_graph->m_NodeTypesOffset       = GetCompiledGraphHeaderSize() + ALIGN_SIZE(graph_size, sizeof(uint32_t));
+
+    // Layout conversions are the last nodes, the callbacks of the nodes are looked up again when
+    // the graph is instantiated
+    CompiledNodeType* compiled_node_types = (CompiledNodeType*)((uint8_t*)compiled_graph_mem + compiled_graph->m_NodeTypesOffset);
+    for (TNodeIndex node_index = 0; node_index < graph->m_NodeCount; ++node_index)
+    {
+        CompiledNodeType*            compiled_node_type = &compiled_node_types[node_index];
+        Node*                        node               = &graph->m_Nodes[node_index];
+        const NodeStaticDescription* node_static_description;
+        memset(compiled_node_type, 0, sizeof(CompiledNodeType));
+        if (node_index < graph_description->m_NodeCount)
+        {
+            node_static_description        = &graph_description->m_NodeDescriptions[node_index].m_NodeStaticDescription;
+            compiled_node_type->m_NodeType = FindNodeType(node_types, node_type_count, node_static_description);
+            if (compiled_node_type->m_NodeType == node_type_count)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            node_static_description        = graph->m_AudioOutputs[node->m_AudioOutputsOffset].m_IsPlanar ? &DeinterleaveNodeDesc : &InterleaveNodeDesc;
+            compiled_node_type->m_NodeType = LAYOUT_CONVERSION_NODE_TYPE;
+        }
+        compiled_node_type->m_ResourceCount      = node_static_description->m_ResourceCount;
+        compiled_node_type->m_TriggerOutputCount = node_static_description->m_TriggerOutputCount;
+        compiled_node_type->m_Flags              = node_static_description->m_Flags;
+
+        node->m_Render          = 0x0;
+        node->m_RenderInstances = 0x0;
+        node->m_Init            = 0x0;
+#if SOGO_PROFILING
+        node->m_NodeType = 0x0;
+#endif
+    }
+
+    compiled_graph->m_Magic                = COMPILED_GRAPH_MAGIC;
+    compiled_graph->m_Version              = COMPILED_GRAPH_VERSION;
+    compiled_graph->m_Layout               = GetCompiledGraphLayout();
+    compiled_graph->m_Size                 = compiled_graph->m_NodeTypesOffset + sizeof(CompiledNodeType) * graph->m_NodeCount;
+    compiled_graph->m_GraphRuntimeSettings = *graph_runtime_settings;
+    GetBufferSizes(graph_runtime_settings, graph_properties, graph_size, &compiled_graph->m_GraphSize);
+    MakeGraphImage(graph, graph_properties);
+    return true;
+}
+
+// The pointers of the graph image are where LayoutGraph puts the tables
+static bool HasGraphLayout(const Graph* graph_image, const Graph* layout)
+{
+#if SOGO_PROFILING
+    if (graph_image->m_ProfileTicks != layout->m_ProfileTicks)
+    {
+        return false;
+    }
+#endif
+    return graph_image->m_Parameters == layout->m_Parameters &&
+           graph_image->m_Resources == layout->m_Resources &&
+           graph_image->m_Nodes == layout->m_Nodes &&
+           graph_image->m_RenderJobs == layout->m_RenderJobs &&
+           graph_image->m_ScratchAllocations == layout->m_ScratchAllocations &&
+           graph_image->m_PassThroughs == layout->m_PassThroughs &&
+           graph_image->m_CommandQueue.m_Commands == layout->m_CommandQueue.m_Commands &&
+           graph_image->m_CommandQueue.m_Capacity == layout->m_CommandQueue.m_Capacity &&
+           graph_image->m_AudioInputs == layout->m_AudioInputs &&
+           graph_image->m_AudioOutputs == layout->m_AudioOutputs &&
+           graph_image->m_EventInputs == layout->m_EventInputs &&
+           graph_image->m_EventQueues == layout->m_EventQueues &&
+           graph_image->m_TriggerOutputs == layout->m_TriggerOutputs &&
+           graph_image->m_Dependencies == layout->m_Dependencies &&
+           graph_image->m_RenderOrder == layout->m_RenderOrder &&
+           graph_image->m_ScheduleNodes == layout->m_ScheduleNodes &&
+           graph_image->m_ScheduleDependents == layout->m_ScheduleDependents &&
+           graph_image->m_ScheduleRoots == layout->m_ScheduleRoots &&
+           graph_image->m_LevelJobs == layout->m_LevelJobs &&
+           graph_image->m_LevelOffsets == layout->m_LevelOffsets &&
+           graph_image->m_ScratchAllocationIndexes == layout->m_ScratchAllocationIndexes;
+}
+
+// The header agrees with itself and the graph image has its tables where BuildGraph puts them for
+// the node count and the graph properties, checked before any offset or count in the image is
+// followed. The sizes derived from the properties must not wrap.
+static bool IsCompiledGraphInBounds(HCompiledGraph compiled_graph)
+{
+    const GraphRuntimeSettings* graph_runtime_settings = &compiled_graph->m_GraphRuntimeSettings;
+    const GraphProperties*      graph_properties       = &compiled_graph->m_GraphProperties;
+    TGraphSize                  header_size            = GetCompiledGraphHeaderSize();
+    if (compiled_graph->m_Size < header_size + sizeof(Graph) ||
+        compiled_graph->m_Size > 0x7fffffffu ||
+        graph_runtime_settings->m_MaxBatchSize > 0x00ffffffu ||
+        graph_runtime_settings->m_MaxCommandCount > compiled_graph->m_Size / sizeof(Command) ||
+        graph_properties->m_ScratchSampleCount > 0xffffffffu / sizeof(float) ||
+        graph_properties->m_ConcurrentScratchSampleCount > 0xffffffffu / sizeof(float) ||
+        (uint64_t)graph_properties->m_EventInputCount * graph_runtime_settings->m_MaxTriggerEventCount * (sizeof(NodeEvent) + sizeof(PendingEvent)) > 0xffffffffu)
+    {
+        return false;
+    }
+    TCommandCount command_capacity = graph_runtime_settings->m_MaxCommandCount > 0 ? 1 : 0;
+    while (command_capacity < graph_runtime_settings->m_MaxCommandCount)
+    {
+        command_capacity <<= 1;
+    }
+    if (graph_properties->m_CommandCapacity != command_capacity)
+    {
+        return false;
+    }
+
+    const Graph* graph_image = GetCompiledGraphImage(compiled_graph);
+    TNodeIndex   node_count  = graph_image->m_NodeCount;
+    TGraphSize   graph_size  = GetGraphSize(node_count, graph_properties);
+    GraphSize    buffer_sizes;
+    GetBufferSizes(graph_runtime_settings, graph_properties, graph_size, &buffer_sizes);
+    if (compiled_graph->m_NodeTypesOffset != header_size + ALIGN_SIZE(graph_size, sizeof(uint32_t)) ||
+        compiled_graph->m_Size != compiled_graph->m_NodeTypesOffset + sizeof(CompiledNodeType) * node_count ||
+        compiled_graph->m_GraphSize.m_GraphSize != buffer_sizes.m_GraphSize ||
+        compiled_graph->m_GraphSize.m_ScratchBufferSize != buffer_sizes.m_ScratchBufferSize ||
+        compiled_graph->m_GraphSize.m_ConcurrentScratchBufferSize != buffer_sizes.m_ConcurrentScratchBufferSize ||
+        compiled_graph->m_GraphSize.m_TriggerBufferSize != buffer_sizes.m_TriggerBufferSize ||
+        compiled_graph->m_GraphSize.m_ContextMemorySize != buffer_sizes.m_ContextMemorySize)
+    {
+        return false;
+    }
+
+    Graph layout;
+    if (LayoutGraph(&layout, 0, node_count, graph_properties) > graph_size || !HasGraphLayout(graph_image, &layout))
+    {
+        return false;
+    }
+#if SOGO_PROFILING
+    if (graph_image->m_ProfileStartedBatchCount != 0 || graph_image->m_ProfileBatchCount.load(std::memory_order_relaxed) != 0)
+    {
+        return false;
+    }
+#endif
+    return graph_image->m_FrameRate == graph_runtime_settings->m_FrameRate &&
+           graph_image->m_MaxTriggerEventCount == graph_runtime_settings->m_MaxTriggerEventCount &&
+           graph_image->m_ScratchAllocationCount == graph_properties->m_ScratchAllocationCount &&
+           graph_image->m_CommandQueue.m_WriteIndex.load(std::memory_order_relaxed) == 0 &&
+           graph_image->m_CommandQueue.m_ReadIndex.load(std::memory_order_relaxed) == 0;
+}
+
+// A planned range of samples lies within a scratch buffer of sample_count samples
+static bool IsScratchRangeValid(uint32_t offset, uint32_t range_sample_count, uint32_t sample_count)
+{
+    return offset % SCRATCH_ALIGNMENT == 0 && range_sample_count <= sample_count && offset <= sample_count - range_sample_count;
+}
+
+// Every table of the graph image holds what BuildGraph makes of the node types, the graph is
+// rejected if any offset, count, index or channel count in it differs. The render jobs and the
+// schedule are not checked, they are rebuilt when the graph is instantiated.
+static bool IsCompiledGraphImageValid(HCompiledGraph compiled_graph, const NodeStaticDescription* const* node_types)
+{
+    const GraphRuntimeSettings* graph_runtime_settings = &compiled_graph->m_GraphRuntimeSettings;
+    const GraphProperties*      graph_properties       = &compiled_graph->m_GraphProperties;
+    const Graph*                graph_image            = GetCompiledGraphImage(compiled_graph);
+    const uint8_t*              image                  = (const uint8_t*)graph_image;
+    const CompiledNodeType*     compiled_node_types    = GetCompiledNodeTypes(compiled_graph);
+    TNodeIndex                  node_count             = graph_image->m_NodeCount;
+    uint32_t                    output_count           = graph_properties->m_AudioOutputCount + 1u;
+    const Node*                 nodes                  = (const Node*)(image + (uintptr_t)graph_image->m_Nodes);
+    const AudioInput*           audio_inputs           = (const AudioInput*)(image + (uintptr_t)graph_image->m_AudioInputs);
+    const AudioOutput*          audio_outputs          = (const AudioOutput*)(image + (uintptr_t)graph_image->m_AudioOutputs);
+    const ScratchAllocation*    scratch_allocations    = (const ScratchAllocation*)(image + (uintptr_t)graph_image->m_ScratchAllocations);
+    const PassThrough*          pass_throughs          = (const PassThrough*)(image + (uintptr_t)graph_image->m_PassThroughs);
+    const TriggerOutput*        trigger_outputs        = (const TriggerOutput*)(image + (uintptr_t)graph_image->m_TriggerOutputs);
+    const Resource*             resources              = (const Resource*)(image + (uintptr_t)graph_image->m_Resources);
+    const TNodeIndex*           dependencies           = (const TNodeIndex*)(image + (uintptr_t)graph_image->m_Dependencies);
+    const TNodeIndex*           render_order           = (const TNodeIndex*)(image + (uintptr_t)graph_image->m_RenderOrder);
+
+    // Inputs read an output of a node or the reserved silent output, compiled graphs have no
+    // external inputs
+    uint32_t* input_sources = (uint32_t*)alloca(sizeof(uint32_t) * (graph_properties->m_AudioInputCount + 1));
+    for (TAudioInputOffset i = 0; i < graph_properties->m_AudioInputCount; ++i)
+    {
+        uintptr_t output_offset = (uintptr_t)audio_inputs[i].m_AudioOutput - (uintptr_t)graph_image->m_AudioOutputs;
+        if ((uintptr_t)audio_inputs[i].m_AudioOutput < (uintptr_t)graph_image->m_AudioOutputs ||
+            output_offset % sizeof(AudioOutput) != 0 ||
+            output_offset / sizeof(AudioOutput) >= output_count)
+        {
+            return false;
+        }
+        input_sources[i] = (uint32_t)(output_offset / sizeof(AudioOutput));
+    }
+
+    // The node owning each output and the kind of nodes reading it
+    const NodeStaticDescription** static_descriptions = (const NodeStaticDescription**)alloca(sizeof(NodeStaticDescription*) * (node_count + 1));
+    TNodeIndex*                   output_nodes        = (TNodeIndex*)alloca(sizeof(TNodeIndex) * output_count);
+    uint8_t*                      output_readers      = (uint8_t*)alloca(output_count);
+    uint32_t                      input_offset        = 0;
+    uint32_t                      output_offset       = 1;
+    memset(output_readers, 0, output_count);
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        const NodeStaticDescription* static_description = GetCompiledNodeStaticDescription(&compiled_node_types[node_index], node_types);
+        if (input_offset + static_description->m_AudioInputCount > graph_properties->m_AudioInputCount ||
+            output_offset + static_description->m_AudioOutputCount > output_count)
+        {
+            return false;
+        }
+        uint8_t reader = (static_description->m_Flags & NODE_FLAG_CONSTANT_INPUTS) ? CONSTANT_READER : SAMPLE_READER;
+        for (TAudioSocketIndex i = 0; i < static_description->m_AudioInputCount; ++i)
+        {
+            output_readers[input_sources[input_offset + i]] |= reader;
+        }
+        for (TAudioSocketIndex i = 0; i < static_description->m_AudioOutputCount; ++i)
+        {
+            output_nodes[output_offset + i] = node_index;
+        }
+        static_descriptions[node_index] = static_description;
+        input_offset += static_description->m_AudioInputCount;
+        output_offset += static_description->m_AudioOutputCount;
+    }
+    if (input_offset != graph_properties->m_AudioInputCount || output_offset != output_count)
+    {
+        return false;
+    }
+
+    // Each node is laid out as MakeNode lays it out, with the dependency count of the image
+    uint32_t parameter_offset      = 0;
+    uint32_t resource_offset       = 0;
+    uint32_t event_input_offset    = 0;
+    uint32_t trigger_output_offset = 0;
+    uint32_t dependency_offset     = 0;
+    uint32_t allocation_offset     = 0;
+    uint32_t pass_through_offset   = 0;
+    uint64_t context_memory_offset = 0;
+    input_offset                   = 0;
+    output_offset                  = 1;
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        const NodeStaticDescription* static_description = static_descriptions[node_index];
+        NodeRuntimeDescription       node_runtime_description;
+        GetRuntimeDescription(static_description, graph_runtime_settings, &node_runtime_description);
+
+        Node expected_node;
+        memset(&expected_node, 0, sizeof(Node));
+        expected_node.m_ParametersOffset        = (TParameterOffset)parameter_offset;
+        expected_node.m_AudioInputsOffset       = (TAudioInputOffset)input_offset;
+        expected_node.m_AudioOutputsOffset      = (TAudioOutputOffset)output_offset;
+        expected_node.m_ResourcesOffset         = (TResourceOffset)resource_offset;
+        expected_node.m_EventInputOffset        = (TTriggerOffset)event_input_offset;
+        expected_node.m_TriggerOutputOffset     = (TTriggerOffset)trigger_output_offset;
+        expected_node.m_DependencyCount         = nodes[node_index].m_DependencyCount;
+        expected_node.m_DependencyOffset        = (TNodeIndex)dependency_offset;
+        expected_node.m_ContextMemoryOffset     = (TContextMemoryOffset)context_memory_offset;
+        expected_node.m_ScratchAllocationOffset = (TAudioOutputOffset)allocation_offset;
+        expected_node.m_PassThroughOffset       = (TAudioOutputOffset)pass_through_offset;
+        expected_node.m_AudioInputCount         = static_description->m_AudioInputCount;
+        expected_node.m_AudioOutputCount        = static_description->m_AudioOutputCount;
+        expected_node.m_IsSkippedWhenSilent     = (static_description->m_Flags & NODE_FLAG_SILENT_IN_SILENT_OUT) != 0 && static_description->m_AudioInputCount > 0 && static_description->m_TriggerInputCount == 0;
+        expected_node.m_KeepsConstantOutputs    = true;
+        expected_node.m_HasEventInput           = static_description->m_TriggerInputCount > 0 || static_description->m_ParameterCount > 0;
+        expected_node.m_ParameterCount          = static_description->m_ParameterCount;
+        expected_node.m_TriggerInputCount       = static_description->m_TriggerInputCount;
+        expected_node.m_ResourceCount           = static_description->m_ResourceCount;
+        expected_node.m_UserData                = static_description->m_UserData;
+        for (TAudioSocketIndex i = 0; i < static_description->m_AudioOutputCount; ++i)
+        {
+            const AudioOutputDescription* output_description = &static_description->m_AudioOutputDescriptions[i];
+            expected_node.m_ScratchAllocationCount += IsAllocatingOutput(output_description) ? 1 : 0;
+            expected_node.m_PassThroughCount += output_description->m_Mode == AudioOutputDescription::PASS_THROUGH ? 1 : 0;
+            expected_node.m_KeepsConstantOutputs &= output_readers[output_offset + i] == CONSTANT_READER;
+        }
+        if (memcmp(&expected_node, &nodes[node_index], sizeof(Node)) != 0)
+        {
+            return false;
+        }
+
+        parameter_offset += expected_node.m_ParameterCount;
+        input_offset += expected_node.m_AudioInputCount;
+        output_offset += expected_node.m_AudioOutputCount;
+        resource_offset += expected_node.m_ResourceCount;
+        event_input_offset += expected_node.m_HasEventInput ? 1 : 0;
+        trigger_output_offset += static_description->m_TriggerOutputCount;
+        dependency_offset += expected_node.m_DependencyCount;
+        allocation_offset += expected_node.m_ScratchAllocationCount;
+        pass_through_offset += expected_node.m_PassThroughCount;
+        context_memory_offset += node_runtime_description.m_ContextMemorySize;
+    }
+    if (parameter_offset != graph_properties->m_ParameterCount ||
+        resource_offset != graph_properties->m_ResourceCount ||
+        event_input_offset != graph_properties->m_EventInputCount ||
+        trigger_output_offset != graph_properties->m_TriggerOutputCount ||
+        dependency_offset != graph_properties->m_DependencyCount ||
+        allocation_offset != graph_properties->m_ScratchAllocationCount ||
+        pass_through_offset != graph_properties->m_PassThroughCount ||
+        context_memory_offset != graph_properties->m_ContextMemorySize)
+    {
+        return false;
+    }
+
+    // Dependencies are other nodes, listed once, and include every node the inputs read from
+    uint8_t* is_dependency = (uint8_t*)alloca(node_count + 1);
+    memset(is_dependency, 0, node_count + 1);
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        const Node*       node              = &nodes[node_index];
+        const TNodeIndex* node_dependencies = &dependencies[node->m_DependencyOffset];
+        bool              is_valid          = true;
+        for (TNodeIndex d = 0; d < node->m_DependencyCount; ++d)
+        {
+            TNodeIndex dependency = node_dependencies[d];
+            if (dependency >= node_count || dependency == node_index || is_dependency[dependency])
+            {
+                return false;
+            }
+            is_dependency[dependency] = 1;
+        }
+        for (TAudioSocketIndex i = 0; i < node->m_AudioInputCount; ++i)
+        {
+            uint32_t source = input_sources[node->m_AudioInputsOffset + i];
+            is_valid &= source == 0 || is_dependency[output_nodes[source]];
+        }
+        for (TNodeIndex d = 0; d < node->m_DependencyCount; ++d)
+        {
+            is_dependency[node_dependencies[d]] = 0;
+        }
+        if (!is_valid)
+        {
+            return false;
+        }
+    }
+
+    // The render order holds every node once, after all of its dependencies
+    TNodeIndex* render_position = (TNodeIndex*)alloca(sizeof(TNodeIndex) * (node_count + 1));
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        render_position[i] = node_count;
+    }
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        TNodeIndex node_index = render_order[i];
+        if (node_index >= node_count || render_position[node_index] != node_count)
+        {
+            return false;
+        }
+        render_position[node_index] = i;
+    }
+    for (TNodeIndex node_index = 0; node_index < node_count; ++node_index)
+    {
+        const Node*       node              = &nodes[node_index];
+        const TNodeIndex* node_dependencies = &dependencies[node->m_DependencyOffset];
+        for (TNodeIndex d = 0; d < node->m_DependencyCount; ++d)
+        {
+            if (render_position[node_dependencies[d]] >= render_position[node_index])
+            {
+                return false;
+            }
+        }
+    }
+
+    // Channel counts follow the inputs, so the outputs are checked in render order
+    AudioOutput expected_output;
+    memset(&expected_output, 0, sizeof(AudioOutput));
+    expected_output.m_IsSilent = true;
+    if (memcmp(&expected_output, &audio_outputs[0], sizeof(AudioOutput)) != 0)
+    {
+        return false;
+    }
+    for (TNodeIndex i = 0; i < node_count; ++i)
+    {
+        TNodeIndex                   node_index         = render_order[i];
+        const Node*                  node               = &nodes[node_index];
+        const NodeStaticDescription* static_description = static_descriptions[node_index];
+        const ScratchAllocation*     allocation         = &scratch_allocations[node->m_ScratchAllocationOffset];
+        const PassThrough*           pass_through       = &pass_throughs[node->m_PassThroughOffset];
+        for (TAudioSocketIndex j = 0; j < node->m_AudioOutputCount; ++j)
+        {
+            const AudioOutputDescription* output_description = &static_description->m_AudioOutputDescriptions[j];
+            memset(&expected_output, 0, sizeof(AudioOutput));
+            if (output_description->m_Mode == AudioOutputDescription::FIXED)
+            {
+                expected_output.m_ChannelCount = output_description->m_ChannelCount;
+            }
+            else
+            {
+                if (output_description->m_InputIndex >= node->m_AudioInputCount)
+                {
+                    return false;
+                }
+                uint32_t source = input_sources[node->m_AudioInputsOffset + output_description->m_InputIndex];
+                if (source == 0)
+                {
+                    return false;
+                }
+                expected_output.m_ChannelCount = audio_outputs[source].m_ChannelCount;
+            }
+            expected_output.m_IsPlanar      = IsPlanar(static_description);
+            expected_output.m_ChannelStride = expected_output.m_IsPlanar ? GetChannelStride(graph_runtime_settings->m_MaxBatchSize) : 0;
+            if (memcmp(&expected_output, &audio_outputs[node->m_AudioOutputsOffset + j], sizeof(AudioOutput)) != 0)
+            {
+                return false;
+            }
+
+            uint32_t sample_count = GetBufferSampleCount(static_description, expected_output.m_ChannelCount, graph_runtime_settings->m_MaxBatchSize);
+            if (IsAllocatingOutput(output_description))
+            {
+                if (allocation->m_SampleCount != sample_count ||
+                    !IsScratchRangeValid(allocation->m_Offset, sample_count, graph_properties->m_ScratchSampleCount) ||
+                    !IsScratchRangeValid(allocation->m_ConcurrentOffset, sample_count, graph_properties->m_ConcurrentScratchSampleCount))
+                {
+                    return false;
+                }
+                ++allocation;
+            }
+            else if (output_description->m_Mode == AudioOutputDescription::PASS_THROUGH)
+            {
+                if (pass_through->m_OutputIndex != j ||
+                    pass_through->m_InputIndex != output_description->m_InputIndex ||
+                    (pass_through->m_CopyOffset != NO_COPY && !IsScratchRangeValid(pass_through->m_CopyOffset, sample_count, graph_properties->m_ScratchSampleCount)) ||
+                    (pass_through->m_ConcurrentCopyOffset != NO_COPY && !IsScratchRangeValid(pass_through->m_ConcurrentCopyOffset, sample_count, graph_properties->m_ConcurrentScratchSampleCount)))
+                {
+                    return false;
+                }
+                ++pass_through;
+            }
+        }
 
-    node->m_ContextMemoryOffset = *context_memory_offset;
-    *context_memory_offset += node_runtime_description->m_ContextMemorySize;
-    return node;
+        if (static_description->m_Flags & NODE_FLAG_MONO_OR_MATCHING_INPUTS)
+        {
+            if (node->m_AudioOutputCount == 0)
+            {
+                return false;
+            }
+            TChannelIndex output_channel_count = audio_outputs[node->m_AudioOutputsOffset].m_ChannelCount;
+            for (TAudioSocketIndex j = 0; j < node->m_AudioInputCount; ++j)
+            {
+                uint32_t source = input_sources[node->m_AudioInputsOffset + j];
+                if (source != 0 && audio_outputs[source].m_ChannelCount != 1 && audio_outputs[source].m_ChannelCount != output_channel_count)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Unconnected trigger outputs are left zeroed
+    for (TTriggerOffset i = 0; i < graph_properties->m_TriggerOutputCount; ++i)
+    {
+        const TriggerOutput* trigger_output = &trigger_outputs[i];
+        if ((trigger_output->m_InputNode != 0 || trigger_output->m_Trigger != 0) &&
+            (trigger_output->m_InputNode >= node_count || trigger_output->m_Trigger >= nodes[trigger_output->m_InputNode].m_TriggerInputCount))
+        {
+            return false;
+        }
+    }
+
+    // Resources are set on each instantiated graph
+    for (TResourceOffset i = 0; i < graph_properties->m_ResourceCount; ++i)
+    {
+        if (resources[i].m_Data != 0x0 || resources[i].m_Size != 0)
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool SetResource(HGraph graph, TNodeIndex node_index, TResourceIndex resource_index, const Resource* resource)
+HCompiledGraph LoadCompiledGraph(
+const void*                         compiled_graph_mem,
+TGraphSize                          compiled_graph_size,
+const NodeStaticDescription* const* node_types,
+uint32_t                            node_type_count)
 {
-    Node*     node = &graph->m_Nodes[node_index];
-    Resource* r    = &graph->m_Resources[node->m_ResourcesOffset + resource_index];
-    r->m_Data      = resource->m_Data;
-    r->m_Size      = resource->m_Size;
-    return true;
+    HCompiledGraph compiled_graph = (HCompiledGraph)compiled_graph_mem;
+    if (compiled_graph_size < GetCompiledGraphHeaderSize() ||
+        compiled_graph->m_Magic != COMPILED_GRAPH_MAGIC ||
+        compiled_graph->m_Version != COMPILED_GRAPH_VERSION ||
+        compiled_graph->m_Layout != GetCompiledGraphLayout() ||
+        compiled_graph->m_Size > compiled_graph_size ||
+        !IsCompiledGraphInBounds(compiled_graph))
+    {
+        return 0x0;
+    }
+
+    // The node types must match the node types the graph was compiled with, as FindNodeType does
+    const CompiledNodeType* compiled_node_types = GetCompiledNodeTypes(compiled_graph);
+    for (TNodeIndex node_index = 0; node_index < GetCompiledGraphImage(compiled_graph)->m_NodeCount; ++node_index)
+    {
+        const CompiledNodeType* compiled_node_type = &compiled_node_types[node_index];
+        if (compiled_node_type->m_NodeType != LAYOUT_CONVERSION_NODE_TYPE && compiled_node_type->m_NodeType >= node_type_count)
+        {
+            return 0x0;
+        }
+        const NodeStaticDescription* node_type = GetCompiledNodeStaticDescription(compiled_node_type, node_types);
+        if (node_type->m_ResourceCount != compiled_node_type->m_ResourceCount ||
+            node_type->m_TriggerOutputCount != compiled_node_type->m_TriggerOutputCount ||
+            node_type->m_Flags != compiled_node_type->m_Flags)
+        {
+            return 0x0;
+        }
+    }
+    if (!IsCompiledGraphImageValid(compiled_graph, node_types))
+    {
+        return 0x0;
+    }
+    return compiled_graph;
 }
 
-HGraph CreateGraph(
+void GetCompiledGraphBuffersSize(HCompiledGraph compiled_graph, GraphSize* out_graph_size)
+{
+    *out_graph_size = compiled_graph->m_GraphSize;
+}
+
+HGraph InstantiateCompiledGraph(HCompiledGraph compiled_graph, const NodeStaticDescription* const* node_types, const GraphBuffers* graph_buffers)
+{
+    const GraphProperties*      graph_properties       = &compiled_graph->m_GraphProperties;
+    const GraphRuntimeSettings* graph_runtime_settings = &compiled_graph->m_GraphRuntimeSettings;
+    HGraph                      graph                  = CopyGraphImage((const uint8_t*)GetCompiledGraphImage(compiled_graph), compiled_graph->m_GraphSize.m_GraphSize, graph_properties, graph_buffers->m_GraphMem);
+
+    // LoadCompiledGraph does not check the schedule, it is made again from the checked dependencies
+    MakeSchedule(graph);
+
+    const CompiledNodeType* compiled_node_types = GetCompiledNodeTypes(compiled_graph);
+    for (TNodeIndex node_index = 0; node_index < graph->m_NodeCount; ++node_index)
+    {
+        const NodeStaticDescription* node_static_description = GetCompiledNodeStaticDescription(&compiled_node_types[node_index], node_types);
+        NodeRuntimeDescription       node_runtime_description;
+        GetRuntimeDescription(node_static_description, graph_runtime_settings, &node_runtime_description);
+        SetNodeCallbacks(&graph->m_Nodes[node_index], node_static_description, &node_runtime_description);
+    }
+    BindGraph(graph, graph_properties, graph_buffers);
+    InitNodes(graph, graph_runtime_settings);
+    return graph;
+}
+
+struct InstancedGraph
+{
+    GraphRuntimeSettings     m_GraphRuntimeSettings; // For the init callbacks of activated instances
+    uint32_t                 m_InstanceCount;
+    TAudioOutputOffset       m_AudioOutputCount;
+    TParameterOffset         m_ParameterCount;
+    HGraph*                  m_Instances; // The first instance is created from the description, the others share its tables
+    bool*                    m_IsActive;
+    bool*                    m_IsRendered;       // Of each instance for the node being rendered
+    HGraph*                  m_RenderGraphs;     // Instances of the node being rendered by its RenderInstancesCallback
+    const RenderParameters** m_RenderParameters; // Parallel to m_RenderGraphs
+    TParameter*              m_InitialParameters;
+};
+
+// Size of an instance that shares the tables of the first instance
+static TGraphSize GetInstanceSize(TNodeIndex node_count, const GraphProperties* graph_properties)
+{
+    return ALIGN_SIZE(sizeof(Graph), sizeof(void*)) +
+    ALIGN_SIZE(sizeof(TParameter) * graph_properties->m_ParameterCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(Resource) * graph_properties->m_ResourceCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(RenderJob) * node_count, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(Command) * graph_properties->m_CommandCapacity, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(AudioInput) * graph_properties->m_AudioInputCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(AudioOutput) * (graph_properties->m_AudioOutputCount + 1), sizeof(void*)) +
+    ALIGN_SIZE(sizeof(EventInput) * graph_properties->m_EventInputCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(EventQueue) * graph_properties->m_EventInputCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(TAudioSocketIndex) * node_count, sizeof(void*)) +
+    GetProfileSize(node_count);
+}
+
+static TGraphSize GetInstancedGraphHeaderSize(uint32_t instance_count, const GraphProperties* graph_properties)
+{
+    return ALIGN_SIZE(sizeof(InstancedGraph), sizeof(void*)) +
+    ALIGN_SIZE(sizeof(HGraph) * instance_count, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(HGraph) * instance_count, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(RenderParameters*) * instance_count, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(TParameter) * graph_properties->m_ParameterCount, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(bool) * instance_count, sizeof(void*)) +
+    ALIGN_SIZE(sizeof(bool) * instance_count, sizeof(void*));
+}
+
+static uint32_t GetInstanceContextMemorySize(const GraphProperties* graph_properties)
+{
+    return ALIGN_SIZE(graph_properties->m_ContextMemorySize, sizeof(void*));
+}
+
+bool GetInstancedGraphSize(
 const GraphDescription*     graph_description,
 const GraphRuntimeSettings* graph_runtime_settings,
-const GraphBuffers*         graph_buffers)
+uint32_t                    instance_count,
+GraphSize*                  out_graph_size)
 {
+    TNodeIndex      node_count;
     GraphProperties graph_properties;
-    if (!GetGraphProperties(graph_description, graph_runtime_settings, &graph_properties))
+    TGraphSize      graph_size;
+    if (instance_count == 0 || !GetConvertedGraphProperties(graph_description, graph_runtime_settings, &node_count, &graph_properties, &graph_size))
     {
-        return 0x0;
+        return false;
+    }
+    out_graph_size->m_GraphSize                   = GetInstancedGraphHeaderSize(instance_count, &graph_properties) + ALIGN_SIZE(graph_size, sizeof(void*)) + GetInstanceSize(node_count, &graph_properties) * (instance_count - 1);
+    out_graph_size->m_TriggerBufferSize           = GetTriggerBufferSize(graph_runtime_settings, &graph_properties) * instance_count;
+    out_graph_size->m_ScratchBufferSize           = graph_properties.m_ScratchSampleCount * sizeof(float) * instance_count;
+    out_graph_size->m_ConcurrentScratchBufferSize = 0;
+    out_graph_size->m_ContextMemorySize           = GetInstanceContextMemorySize(&graph_properties) * instance_count;
+    return true;
+}
+
+static void SilenceOutputs(HInstancedGraph instanced_graph, HGraph graph)
+{
+    for (TAudioOutputOffset i = 1; i <= instanced_graph->m_AudioOutputCount; ++i)
+    {
+        graph->m_AudioOutputs[i].m_Buffer     = 0x0;
+        graph->m_AudioOutputs[i].m_IsSilent   = true;
+        graph->m_AudioOutputs[i].m_IsConstant = false;
     }
+}
 
-    HGraph     graph      = (HGraph)(graph_buffers->m_GraphMem);
-    TGraphSize graph_size = GetGraphSize(graph_description, &graph_properties);
-    memset(graph, 0, graph_size);
+// The node table, the schedule, the scratch buffer plan and the trigger outputs are shared with
+// the prototype, everything a node writes to while rendering belongs to the instance
+static HGraph CreateInstance(
+HGraph                      prototype,
+const GraphProperties*      graph_properties,
+const GraphRuntimeSettings* graph_runtime_settings,
+const GraphBuffers*         instance_buffers)
+{
+    TNodeIndex node_count = prototype->m_NodeCount;
+    void*      graph_mem  = instance_buffers->m_GraphMem;
+    memset(graph_mem, 0, GetInstanceSize(node_count, graph_properties));
+    HGraph graph = (HGraph)graph_mem;
 
-    graph->m_FrameRate            = graph_runtime_settings->m_FrameRate;
-    graph->m_MaxTriggerEventCount = graph_runtime_settings->m_MaxTriggerEventCount;
-    graph->m_NodeCount            = graph_description->m_NodeCount;
-    graph->m_ScratchBufferSize    = graph_properties.m_GeneratedAudioBufferCount * graph_runtime_settings->m_MaxBatchSize;
-    graph->m_Triggers             = (TTriggerSocketIndex*)graph_buffers->m_TriggerBufferMem;
-    graph->m_ScratchBuffer        = (float*)graph_buffers->m_ScratchBufferMem;
-    graph->m_ContextMemory        = (uint8_t*)graph_buffers->m_ContextMem;
+    graph->m_FrameRate              = prototype->m_FrameRate;
+    graph->m_MaxTriggerEventCount   = prototype->m_MaxTriggerEventCount;
+    graph->m_NodeCount              = node_count;
+    graph->m_Nodes                  = prototype->m_Nodes;
+    graph->m_ScratchAllocations     = prototype->m_ScratchAllocations;
+    graph->m_ScratchAllocationCount = prototype->m_ScratchAllocationCount;
+    graph->m_PassThroughs           = prototype->m_PassThroughs;
+    graph->m_TriggerOutputs         = prototype->m_TriggerOutputs;
+    graph->m_Dependencies           = prototype->m_Dependencies;
+    graph->m_RenderOrder            = prototype->m_RenderOrder;
+    graph->m_ScheduleNodes          = prototype->m_ScheduleNodes;
+    graph->m_ScheduleDependents     = prototype->m_ScheduleDependents;
+    graph->m_ScheduleRoots          = prototype->m_ScheduleRoots;
+    graph->m_ScheduleRootCount      = prototype->m_ScheduleRootCount;
+    graph->m_LevelJobs              = prototype->m_LevelJobs;
+    graph->m_LevelOffsets           = prototype->m_LevelOffsets;
+    graph->m_LevelCount             = prototype->m_LevelCount;
 
-    uint8_t* ptr    = (uint8_t*)graph_buffers->m_GraphMem;
+    uint8_t* ptr    = (uint8_t*)graph_mem;
     uint32_t offset = ALIGN_SIZE(sizeof(Graph), sizeof(void*));
 
     graph->m_Parameters = (TParameter*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(TParameter) * graph_properties.m_ParameterCount, sizeof(void*));
+    offset += ALIGN_SIZE(sizeof(TParameter) * graph_properties->m_ParameterCount, sizeof(void*));
 
     graph->m_Resources = (Resource*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(Resource) * graph_properties.m_ResourceCount, sizeof(RenderCallback));
+    offset += ALIGN_SIZE(sizeof(Resource) * graph_properties->m_ResourceCount, sizeof(void*));
 
-    graph->m_Nodes = (Node*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(Node) * graph_description->m_NodeCount, sizeof(AudioOutput*));
+    graph->m_RenderJobs = (RenderJob*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(RenderJob) * node_count, sizeof(void*));
+
+    graph->m_CommandQueue.m_Commands = (Command*)&ptr[offset];
+    graph->m_CommandQueue.m_Capacity = prototype->m_CommandQueue.m_Capacity;
+    offset += ALIGN_SIZE(sizeof(Command) * graph_properties->m_CommandCapacity, sizeof(void*));
 
     graph->m_AudioInputs = (AudioInput*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(AudioInput) * graph_properties.m_AudioInputCount, sizeof(float*));
+    offset += ALIGN_SIZE(sizeof(AudioInput) * graph_properties->m_AudioInputCount, sizeof(void*));
 
     graph->m_AudioOutputs = (AudioOutput*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(AudioOutput) * (graph_properties.m_AudioOutputCount + 1), sizeof(TTriggerSocketIndex*));
+    offset += ALIGN_SIZE(sizeof(AudioOutput) * (graph_properties->m_AudioOutputCount + 1), sizeof(void*));
 
-    graph->m_TriggerInputs = (TriggerInput*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(TriggerInput) * (graph_properties.m_TriggerInputCount), sizeof(TNodeIndex));
+    graph->m_EventInputs = (EventInput*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(EventInput) * graph_properties->m_EventInputCount, sizeof(void*));
 
-    graph->m_TriggerOutputs = (TriggerOutput*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(TriggerOutput) * (graph_properties.m_TriggerOutputCount), sizeof(TNodeIndex));
+    graph->m_EventQueues = (EventQueue*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(EventQueue) * graph_properties->m_EventInputCount, sizeof(void*));
 
-    graph->m_Dependencies = (TNodeIndex*)&ptr[offset];
-    offset += ALIGN_SIZE(sizeof(TNodeIndex) * (graph_properties.m_DependencyCount), sizeof(1));
+    graph->m_ScratchAllocationIndexes = (TAudioSocketIndex*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(TAudioSocketIndex) * node_count, sizeof(void*));
 
-    TNodeIndex         node_offset            = 0;
-    TAudioInputOffset  input_offset           = 0;
-    TAudioOutputOffset output_offset          = 1; // Zero is reserved for unconnected inputs
-    TParameterOffset   parameters_offset      = 0;
-    TResourceOffset    resources_offset       = 0;
-    TTriggerOffset     triggers_input_offset  = 0;
-    TTriggerOffset     triggers_output_offset = 0;
-    TNodeIndex         dependenceny_offset    = 0;
-    TContextMemorySize context_memory_offset  = 0;
+#if SOGO_PROFILING
+    graph->m_ProfileTicks = (std::atomic<uint32_t>*)&ptr[offset];
+    offset += GetProfileSize(node_count);
+#endif
 
-    NodeAudioConnection const** audio_connections      = (NodeAudioConnection const**)alloca(sizeof(NodeAudioConnection*) * graph_description->m_NodeCount);
-    const NodeAudioConnection*  node_audio_connections = graph_description->m_AudioConnections;
+    memcpy(graph->m_Parameters, prototype->m_Parameters, sizeof(TParameter) * graph_properties->m_ParameterCount);
+    memcpy(graph->m_AudioOutputs, prototype->m_AudioOutputs, sizeof(AudioOutput) * (graph_properties->m_AudioOutputCount + 1));
 
-    NodeTriggerConnection const** trigger_connections      = (NodeTriggerConnection const**)alloca(sizeof(NodeTriggerConnection*) * graph_description->m_NodeCount);
-    const NodeTriggerConnection*  node_trigger_connections = graph_description->m_TriggerConnections;
+    // Inputs connected inside the graph read the outputs of the instance, external inputs are shared
+    const AudioOutput* prototype_outputs_end = &prototype->m_AudioOutputs[graph_properties->m_AudioOutputCount + 1];
+    for (TAudioInputOffset i = 0; i < graph_properties->m_AudioInputCount; ++i)
+    {
+        AudioOutput* audio_output = prototype->m_AudioInputs[i].m_AudioOutput;
+        if (audio_output >= prototype->m_AudioOutputs && audio_output < prototype_outputs_end)
+        {
+            audio_output = &graph->m_AudioOutputs[audio_output - prototype->m_AudioOutputs];
+        }
+        graph->m_AudioInputs[i].m_AudioOutput = audio_output;
+    }
 
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    BindGraph(graph, graph_properties, instance_buffers);
+    InitNodes(graph, graph_runtime_settings);
+    return graph;
+}
+
+HInstancedGraph CreateInstancedGraph(
+const GraphDescription*     graph_description,
+const GraphRuntimeSettings* graph_runtime_settings,
+uint32_t                    instance_count,
+const GraphBuffers*         graph_buffers)
+{
+    TNodeIndex      node_count;
+    GraphProperties graph_properties;
+    TGraphSize      graph_size;
+    if (instance_count == 0 || !GetConvertedGraphProperties(graph_description, graph_runtime_settings, &node_count, &graph_properties, &graph_size))
     {
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        audio_connections[node_index]           = node_audio_connections;
-        node_audio_connections += node_description.m_AudioConnectionCount;
+        return 0x0;
+    }
 
-        trigger_connections[node_index] = node_trigger_connections;
-        node_trigger_connections += node_description.m_TriggerConnectionCount;
+    HInstancedGraph instanced_graph = (HInstancedGraph)graph_buffers->m_GraphMem;
+    memset(instanced_graph, 0, GetInstancedGraphHeaderSize(instance_count, &graph_properties));
+    instanced_graph->m_GraphRuntimeSettings = *graph_runtime_settings;
+    instanced_graph->m_InstanceCount        = instance_count;
+    instanced_graph->m_AudioOutputCount     = graph_properties.m_AudioOutputCount;
+    instanced_graph->m_ParameterCount       = graph_properties.m_ParameterCount;
+
+    uint8_t* ptr    = (uint8_t*)graph_buffers->m_GraphMem;
+    uint32_t offset = ALIGN_SIZE(sizeof(InstancedGraph), sizeof(void*));
+
+    instanced_graph->m_Instances = (HGraph*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(HGraph) * instance_count, sizeof(void*));
+
+    instanced_graph->m_RenderGraphs = (HGraph*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(HGraph) * instance_count, sizeof(void*));
+
+    instanced_graph->m_RenderParameters = (const RenderParameters**)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(RenderParameters*) * instance_count, sizeof(void*));
+
+    instanced_graph->m_InitialParameters = (TParameter*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(TParameter) * graph_properties.m_ParameterCount, sizeof(void*));
+
+    instanced_graph->m_IsActive = (bool*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(bool) * instance_count, sizeof(void*));
+
+    instanced_graph->m_IsRendered = (bool*)&ptr[offset];
+    offset += ALIGN_SIZE(sizeof(bool) * instance_count, sizeof(void*));
+
+    uint32_t     scratch_sample_count = graph_properties.m_ScratchSampleCount;
+    uint32_t     trigger_buffer_size  = GetTriggerBufferSize(graph_runtime_settings, &graph_properties);
+    uint32_t     context_memory_size  = GetInstanceContextMemorySize(&graph_properties);
+    float*       scratch_buffer       = (float*)graph_buffers->m_ScratchBufferMem;
+    uint8_t*     trigger_buffer       = (uint8_t*)graph_buffers->m_TriggerBufferMem;
+    uint8_t*     context_memory       = (uint8_t*)graph_buffers->m_ContextMem;
+    GraphBuffers prototype_buffers    = { &ptr[offset], scratch_buffer, 0x0, trigger_buffer, context_memory };
+    HGraph       prototype            = CreateGraph(graph_description, graph_runtime_settings, &prototype_buffers);
+    if (prototype == 0x0)
+    {
+        return 0x0;
     }
+    offset += ALIGN_SIZE(graph_size, sizeof(void*));
+    memcpy(instanced_graph->m_InitialParameters, prototype->m_Parameters, sizeof(TParameter) * graph_properties.m_ParameterCount);
+    instanced_graph->m_Instances[0] = prototype;
 
-    // Each node need to know how many trigger connections it has!
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    TGraphSize instance_size = GetInstanceSize(node_count, &graph_properties);
+    for (uint32_t i = 1; i < instance_count; ++i)
     {
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        NodeRuntimeDescription node_runtime_description;
-        node_description.m_NodeStaticDescription.m_GetNodeRuntimeDescCallback(graph_runtime_settings, &node_runtime_description);
-        MakeNode(
-        graph,
-        &node_description,
-        &node_runtime_description,
-        audio_connections,
-        trigger_connections,
-        &node_offset,
-        &input_offset,
-        &output_offset,
-        &parameters_offset,
-        &resources_offset,
-        &triggers_input_offset,
-        &triggers_output_offset,
-        &dependenceny_offset,
-        &context_memory_offset);
+        GraphBuffers instance_buffers   = { &ptr[offset], &scratch_buffer[scratch_sample_count * i], 0x0, &trigger_buffer[trigger_buffer_size * i], &context_memory[context_memory_size * i] };
+        instanced_graph->m_Instances[i] = CreateInstance(prototype, &graph_properties, graph_runtime_settings, &instance_buffers);
+        offset += instance_size;
+    }
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        SilenceOutputs(instanced_graph, instanced_graph->m_Instances[i]);
     }
+    return instanced_graph;
+}
 
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+HGraph GetInstance(HInstancedGraph instanced_graph, uint32_t instance_index)
+{
+    return instance_index < instanced_graph->m_InstanceCount ? instanced_graph->m_Instances[instance_index] : 0x0;
+}
+
+bool SetInstanceActive(HInstancedGraph instanced_graph, uint32_t instance_index, bool is_active)
+{
+    if (instance_index >= instanced_graph->m_InstanceCount)
     {
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        for (TConnectionIndex i = 0; i < node_description.m_AudioConnectionCount; ++i)
+        return false;
+    }
+    HGraph graph = instanced_graph->m_Instances[instance_index];
+    if (is_active && !instanced_graph->m_IsActive[instance_index])
+    {
+        memcpy(graph->m_Parameters, instanced_graph->m_InitialParameters, sizeof(TParameter) * instanced_graph->m_ParameterCount);
+        for (TNodeIndex node_index = 0; node_index < graph->m_NodeCount; ++node_index)
         {
-            const NodeAudioConnection* node_connection   = &audio_connections[node_index][i];
-            Node*                      input_node        = &graph->m_Nodes[node_index];
-            TAudioInputOffset          graph_input_index = input_node->m_AudioInputsOffset + node_connection->m_InputIndex;
-            if (graph->m_AudioInputs[graph_input_index].m_AudioOutput != 0x0)
-            {
-                return 0x0;
-            }
-            if (node_connection->m_OutputNodeOffset == EXTERNAL_NODE_OFFSET)
-            {
-                graph->m_AudioInputs[graph_input_index].m_AudioOutput = graph_description->m_ExternalAudioInputs[node_connection->m_OutputIndex];
-            }
-            else
+            if (graph->m_Nodes[node_index].m_HasEventInput)
             {
-                TNodeIndex output_node_index                          = (TNodeIndex)(node_index + node_connection->m_OutputNodeOffset);
-                Node*      output_node                                = &graph->m_Nodes[output_node_index];
-                graph->m_AudioInputs[graph_input_index].m_AudioOutput = &graph->m_AudioOutputs[output_node->m_AudioOutputsOffset + node_connection->m_OutputIndex];
+                InitEventInput(graph, &graph->m_Nodes[node_index]);
             }
         }
+        InitNodes(graph, &instanced_graph->m_GraphRuntimeSettings);
+    }
+    else if (!is_active)
+    {
+        SilenceOutputs(instanced_graph, graph);
+    }
+    instanced_graph->m_IsActive[instance_index] = is_active;
+    return true;
+}
 
-        for (TConnectionIndex i = 0; i < node_description.m_TriggerConnectionCount; ++i)
+// Renders one node at a time for all active instances so the node sees all of them together.
+// The cost of a node is shared evenly between the instances in the profile.
+void RenderInstancedGraph(HInstancedGraph instanced_graph, TFrameIndex frame_count)
+{
+    uint32_t    instance_count = instanced_graph->m_InstanceCount;
+    HGraph*     instances      = instanced_graph->m_Instances;
+    const bool* is_active      = instanced_graph->m_IsActive;
+    bool*       is_rendered    = instanced_graph->m_IsRendered;
+    uint32_t    active_count   = 0;
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        if (is_active[i])
         {
-            const NodeTriggerConnection* node_connection            = &trigger_connections[node_index][i];
-            TNodeIndex                   output_node_index          = (TNodeIndex)(node_index + node_connection->m_OutputNodeOffset);
-            Node*                        output_node                = &graph->m_Nodes[output_node_index];
-            TTriggerOffset               graph_output_index         = output_node->m_TriggerOutputOffset + node_connection->m_OutputIndex;
-            graph->m_TriggerOutputs[graph_output_index].m_InputNode = node_index;
-            graph->m_TriggerOutputs[graph_output_index].m_Trigger   = node_connection->m_InputTriggerIndex;
+            ApplyCommands(instances[i]);
+            BeginProfileBatch(instances[i]);
+            ++active_count;
         }
     }
-
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    if (active_count == 0)
     {
-        Node*        node           = &graph->m_Nodes[node_index];
-        AudioOutput* render_outputs = &graph->m_AudioOutputs[node->m_AudioOutputsOffset];
+        return;
+    }
 
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        for (TAudioSocketIndex j = 0; j < node_description.m_NodeStaticDescription.m_AudioOutputCount; ++j)
+    TNodeIndex node_count = instances[0]->m_NodeCount;
+    for (TNodeIndex j = 0; j < node_count; ++j)
+    {
+#if SOGO_PROFILING
+        uint64_t start_ticks = GetProfileTicks();
+#endif
+        HNode node = instances[0]->m_RenderJobs[j].m_Node;
+        if (node->m_RenderInstances == 0x0)
         {
-            if (!GetOutputChannelCount(graph_description, graph_runtime_settings, node_index, audio_connections, j, &render_outputs[j].m_ChannelCount))
+            for (uint32_t i = 0; i < instance_count; ++i)
             {
-                return 0x0;
+                if (is_active[i])
+                {
+                    RenderParameters* render_parameters      = &instances[i]->m_RenderJobs[j].m_RenderParameters;
+                    render_parameters->m_AllocateAudioBuffer = AllocatePlannedAudioBuffer;
+                    render_parameters->m_FrameCount          = frame_count;
+                    bool is_node_rendered                    = BeginRenderNode(instances[i], node, render_parameters);
+                    if (is_node_rendered)
+                    {
+                        node->m_Render(instances[i], node, render_parameters);
+                    }
+                    EndRenderNode(node, render_parameters, is_node_rendered);
+                }
+            }
+        }
+        else
+        {
+            uint32_t render_count = 0;
+            for (uint32_t i = 0; i < instance_count; ++i)
+            {
+                if (is_active[i])
+                {
+                    RenderParameters* render_parameters      = &instances[i]->m_RenderJobs[j].m_RenderParameters;
+                    render_parameters->m_AllocateAudioBuffer = AllocatePlannedAudioBuffer;
+                    render_parameters->m_FrameCount          = frame_count;
+                    is_rendered[i]                           = BeginRenderNode(instances[i], node, render_parameters);
+                    if (is_rendered[i])
+                    {
+                        instanced_graph->m_RenderGraphs[render_count]     = instances[i];
+                        instanced_graph->m_RenderParameters[render_count] = render_parameters;
+                        ++render_count;
+                    }
+                }
+            }
+            if (render_count > 0)
+            {
+                node->m_RenderInstances(instanced_graph->m_RenderGraphs, node, instanced_graph->m_RenderParameters, render_count);
+            }
+            for (uint32_t i = 0; i < instance_count; ++i)
+            {
+                if (is_active[i])
+                {
+                    EndRenderNode(node, &instances[i]->m_RenderJobs[j].m_RenderParameters, is_rendered[i]);
+                }
+            }
+        }
+#if SOGO_PROFILING
+        uint64_t ticks = (GetProfileTicks() - start_ticks) / active_count;
+        for (uint32_t i = 0; i < instance_count; ++i)
+        {
+            if (is_active[i])
+            {
+                RecordProfileTicks(instances[i], node, ticks);
             }
         }
+#endif
     }
 
-    for (TNodeIndex node_index = 0; node_index < graph_description->m_NodeCount; ++node_index)
+    for (uint32_t i = 0; i < instance_count; ++i)
     {
-        Node*                  node             = &graph->m_Nodes[node_index];
-        const NodeDescription& node_description = graph_description->m_NodeDescriptions[node_index];
-        NodeRuntimeDescription node_runtime_description;
-        node_description.m_NodeStaticDescription.m_GetNodeRuntimeDescCallback(graph_runtime_settings, &node_runtime_description);
-        if (node_runtime_description.m_InitCallback)
+        if (is_active[i])
         {
-            node_runtime_description.m_InitCallback(graph, node, graph_runtime_settings, &graph->m_ContextMemory[node->m_ContextMemoryOffset]);
+            EndProfileBatch(instances[i]);
         }
     }
-
-    return graph;
 }
 
 } // namespace sogo
@@ -2,6 +2,16 @@
 
 #include <stdint.h>
 
+// Build with SOGO_PROFILING=1 to record the render cost of every node for the last
+// SOGO_PROFILE_BATCH_COUNT batches, compiled out entirely otherwise
+#ifndef SOGO_PROFILING
+#    define SOGO_PROFILING 0
+#endif
+
+#ifndef SOGO_PROFILE_BATCH_COUNT
+#    define SOGO_PROFILE_BATCH_COUNT 128
+#endif
+
 namespace sogo {
 
 // Index is offset inside parent struct - index of node in graph, index of audio output in node etc
@@ -24,12 +34,18 @@ typedef uint32_t TContextMemorySize;
 typedef uint32_t TGraphSize;
 typedef uint32_t TTriggerBufferSize;
 typedef uint32_t TScratchBufferSize;
-typedef uint32_t TContextMemorySize;
+typedef uint32_t TExecutorSize;
+typedef uint32_t TCommandCount;
+typedef uint8_t  TNodeFlags;
 
 struct AudioOutput
 {
     float*        m_Buffer;
     TChannelIndex m_ChannelCount;
+    bool          m_IsSilent;      // Set by the graph after the node has rendered, a silent output has no buffer
+    bool          m_IsConstant;    // Set by the node, m_Buffer only holds the first frame and every frame of the batch is the same
+    bool          m_IsPlanar;      // Channel c starts at m_Buffer + c * m_ChannelStride, interleaved otherwise
+    uint32_t      m_ChannelStride; // Planar only, in samples
 };
 
 struct AudioInput
@@ -43,10 +59,32 @@ struct TriggerOutput
     TTriggerSocketIndex m_Trigger;
 };
 
-struct TriggerInput
+union TParameter
+{
+    float   m_Float;
+    int32_t m_Int;
+};
+
+// A trigger or a parameter change that takes effect m_FrameOffset frames into the batch
+struct NodeEvent
 {
-    TTriggerSocketIndex* m_Buffer;
-    TTriggerCount        m_Count;
+    enum Type
+    {
+        TRIGGER,
+        PARAMETER
+    };
+    TFrameIndex m_FrameOffset;
+    uint8_t     m_Type;
+    uint8_t     m_Index; // TTriggerSocketIndex for TRIGGER, TParameterIndex for PARAMETER
+    TParameter  m_Value; // PARAMETER
+};
+
+// Events queued for a node sorted on m_FrameOffset, events past the end of the batch are kept
+// for the following batches
+struct EventInput
+{
+    NodeEvent*    m_Events;
+    TTriggerCount m_Count;
 };
 
 struct Resource
@@ -55,8 +93,9 @@ struct Resource
     uint32_t m_Size;
 };
 
-typedef struct Graph* HGraph;
-typedef struct Node*  HNode;
+typedef struct Graph*    HGraph;
+typedef struct Node*     HNode;
+typedef struct Executor* HExecutor;
 
 typedef float* (*AllocateAudioBufferFunc)(HGraph graph, HNode node, TChannelIndex channel_count, TFrameIndex frame_count);
 
@@ -64,13 +103,8 @@ struct GraphRuntimeSettings
 {
     TFrameRate    m_FrameRate;
     TFrameIndex   m_MaxBatchSize;
-    TTriggerCount m_MaxTriggerEventCount;
-};
-
-union TParameter
-{
-    float   m_Float;
-    int32_t m_Int;
+    TTriggerCount m_MaxTriggerEventCount; // Capacity of the event queue of each node
+    TCommandCount m_MaxCommandCount;      // Capacity of the Post* command queue, rounded up to a power of two
 };
 
 struct RenderParameters;
@@ -83,10 +117,11 @@ struct RenderParameters
     TFrameRate              m_FrameRate;
     TFrameIndex             m_FrameCount;
     AudioInput*             m_AudioInputs;
+    TAudioSocketIndex       m_AudioInputCount;
     AudioOutput*            m_AudioOutputs;
     TParameter*             m_Parameters;
     Resource*               m_Resources;
-    TriggerInput*           m_TriggerInput;
+    EventInput*             m_EventInput; // 0x0 if the node has no parameters and no trigger inputs
     TriggerOutput*          m_TriggerOutputs;
 };
 
@@ -105,28 +140,44 @@ struct AudioOutputDescription
 {
     enum AllocationMode
     {
-        PASS_THROUGH, // Reuse buffer from Input[m_InputIndex]
+        PASS_THROUGH, // Reuse buffer from Input[m_InputIndex], the node may write to it in place
         FIXED,        // Allocates a buffer with m_ChannelCount channels
-        AS_INPUT      // Allocates a buffer with with same channel count as Input[m_InputIndex]
+        AS_INPUT,     // Allocates a buffer with with same channel count as Input[m_InputIndex]
+        SHARED        // Reuse buffer from Input[m_InputIndex] read only, several outputs may share it
     };
+    // The scratch buffer is planned from these modes, a PASS_THROUGH or SHARED output may only carry
+    // the buffer of Input[m_InputIndex] and FIXED or AS_INPUT outputs may only carry a buffer allocated
+    // by the node. Allocate at most one buffer for each FIXED and AS_INPUT output, in output order.
+    //
+    // Buffers are copy on write. The graph sets the buffer of a PASS_THROUGH output before the node
+    // renders, it is the buffer of Input[m_InputIndex] unless other nodes still read that buffer, then
+    // it is a planned buffer of its own. The node reads the input and writes the output, which is
+    // in place when they are the same buffer.
     uint16_t m_Mode;
     union
     {
         TChannelIndex     m_ChannelCount; // FIXED
-        TAudioSocketIndex m_InputIndex;   // AS_INPUT
+        TAudioSocketIndex m_InputIndex;   // PASS_THROUGH, AS_INPUT, SHARED
     };
 };
 
-typedef void (*InitCallback)(HGraph graph, HNode node, const GraphRuntimeSettings* graph_runtime_settings, void* context_memory);
+// user_data is NodeStaticDescription::m_UserData of the node
+typedef void (*InitCallback)(HGraph graph, HNode node, const GraphRuntimeSettings* graph_runtime_settings, TParameter user_data, void* context_memory);
+
+// Renders the node of instance_count instances of an instanced graph in one call, entry i of
+// graphs and render_parameters belong to the same instance. Lets the node process the instances
+// side by side, the RenderCallback is used for nodes without one.
+typedef void (*RenderInstancesCallback)(const HGraph* graphs, HNode node, const RenderParameters* const* render_parameters, uint32_t instance_count);
 
 struct NodeRuntimeDescription
 {
-    InitCallback       m_InitCallback;
-    RenderCallback     m_RenderCallback;
-    TContextMemorySize m_ContextMemorySize;
+    InitCallback            m_InitCallback;
+    RenderCallback          m_RenderCallback;
+    TContextMemorySize      m_ContextMemorySize;
+    RenderInstancesCallback m_RenderInstancesCallback; // Optional, fields the node does not set are 0
 };
 
-typedef void (*GetNodeRuntimeDescription)(const GraphRuntimeSettings* graph_runtime_settings, NodeRuntimeDescription* out_node_runtime_desc);
+typedef void (*GetNodeRuntimeDescription)(const GraphRuntimeSettings* graph_runtime_settings, TParameter user_data, NodeRuntimeDescription* out_node_runtime_desc);
 
 struct NodeStaticDescription
 {
@@ -140,8 +191,30 @@ struct NodeStaticDescription
     TParameterIndex               m_ParameterCount;
     TTriggerSocketIndex           m_TriggerInputCount;
     TTriggerSocketIndex           m_TriggerOutputCount;
+    TNodeFlags                    m_Flags;
+    TParameter                    m_UserData; // Passed to the GetNodeRuntimeDescription and InitCallback of the node
 };
 
+// The node produces silence on all outputs when all of its audio inputs are silent. The graph
+// skips rendering the node and marks the outputs as silent, nodes with trigger inputs are always rendered.
+static const TNodeFlags NODE_FLAG_SILENT_IN_SILENT_OUT = 1;
+
+// The node reads audio inputs that are AudioOutput::m_IsConstant. A constant output is filled out
+// to the whole batch by the graph after the node renders unless all of its readers have this flag,
+// outputs that no node reads are always filled out. External audio inputs are never filled out.
+static const TNodeFlags NODE_FLAG_CONSTANT_INPUTS = 2;
+
+// The audio inputs and outputs of the node are planar, every channel is a separate run of frames
+// and starts on a SCRATCH_BUFFER_ALIGNMENT boundary. Where a node reads an
+// output of the other layout the graph inserts a node that converts it, the conversion is shared
+// by all nodes of the same layout reading the output. The conversions are rendered as nodes
+// after the nodes of the graph description, see GetRenderJobCount.
+static const TNodeFlags NODE_FLAG_PLANAR = 4;
+
+// Every connected audio input has one channel or the channel count of output 0, CreateGraph fails
+// for a graph that connects an input with any other channel count.
+static const TNodeFlags NODE_FLAG_MONO_OR_MATCHING_INPUTS = 8;
+
 static const TNodeOffset EXTERNAL_NODE_OFFSET = 0;
 
 struct NodeAudioConnection
@@ -177,17 +250,23 @@ struct GraphDescription
 struct GraphSize
 {
     TGraphSize         m_GraphSize;
-    TScratchBufferSize m_ScratchBufferSize;
+    TScratchBufferSize m_ScratchBufferSize;           // RenderGraph, buffers are reused once all their readers have rendered
+    TScratchBufferSize m_ConcurrentScratchBufferSize; // GetRenderJobs, RenderGraphParallel and RenderGraphWavefront, buffers are reused by nodes depending on all their readers
     TTriggerBufferSize m_TriggerBufferSize;
     TContextMemorySize m_ContextMemorySize;
 };
 
+// Bytes, the scratch buffers must start on this boundary. Every buffer in them then starts on
+// its own cache line so workers rendering in parallel never write to the same line.
+static const uint32_t SCRATCH_BUFFER_ALIGNMENT = 64;
+
 struct GraphBuffers
 {
-    void* m_GraphMem;         // Align to float
-    void* m_ScratchBufferMem; // Align to float
-    void* m_TriggerBufferMem; // Align to TTriggerIndex
-    void* m_ContextMem;       // No need to align,
+    void* m_GraphMem;                   // Align to float
+    void* m_ScratchBufferMem;           // Align to SCRATCH_BUFFER_ALIGNMENT
+    void* m_ConcurrentScratchBufferMem; // Align to SCRATCH_BUFFER_ALIGNMENT, may be 0x0 if the graph is only rendered with RenderGraph
+    void* m_TriggerBufferMem;           // Align to NodeEvent
+    void* m_ContextMem;                 // No need to align,
 };
 
 struct RenderJob
@@ -203,11 +282,121 @@ struct RenderJob
 bool         GetGraphSize(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, GraphSize* out_graph_size);
 HGraph       CreateGraph(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, const GraphBuffers* graph_buffers);
 AudioOutput* GetOutput(HGraph graph, TNodeIndex node_index, TAudioSocketIndex output_index);
+TNodeIndex   GetRenderJobCount(HGraph graph); // Nodes in the graph description and inserted layout conversions
 void         GetRenderJobs(HGraph graph, TFrameIndex frame_count, RenderJob* out_render_jobs);
 bool         SetParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value);
-bool         Trigger(HGraph graph, TNodeIndex node_index, TTriggerSocketIndex trigger_index);
+bool         Trigger(HGraph graph, TNodeIndex node_index, TTriggerSocketIndex trigger_index, TFrameIndex frame_offset);
+bool         ScheduleParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value, TFrameIndex frame_offset);
 bool         SetResource(HGraph graph, TNodeIndex node_index, TResourceIndex resource_index, const Resource* resource);
 void         RenderGraph(HGraph graph, TFrameIndex frame_count);
 AudioOutput* GetAudioOutput(HGraph graph, TNodeIndex node_index, TAudioSocketIndex output_index);
 
+// A graph description resolved once so graphs can be created from it without asking the nodes
+// for their runtime descriptions, resolving channel counts or planning the buffers again.
+// InstantiateGraph copies the resolved graph into graph_buffers, sized by GetPrototypeGraphSize,
+// and calls the InitCallback of the nodes. The prototype does not change after CreatePrototype and
+// may instantiate graphs on any number of threads, the graphs do not refer back to it. External
+// audio inputs of the description are shared by all graphs of the prototype.
+typedef struct GraphPrototype* HGraphPrototype;
+
+bool            GetPrototypeSize(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, TGraphSize* out_prototype_size);
+HGraphPrototype CreatePrototype(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, void* prototype_mem); // Align to void*
+void            GetPrototypeGraphSize(HGraphPrototype prototype, GraphSize* out_graph_size);
+HGraph          InstantiateGraph(HGraphPrototype prototype, const GraphBuffers* graph_buffers);
+
+// A graph compiled to a versioned block of bytes without pointers, to be written to a file and
+// loaded straight from a read only memory mapping of it. It holds the resolved graph with its
+// connections, buffer plan and initial parameters, and for each node the index of its type in
+// node_types. LoadCompiledGraph checks the header, that node_types has the types the graph was
+// compiled with, compared field by field, and that every offset, count, connection and planned
+// buffer in the graph image is what building the graph from those types gives, so a corrupted file
+// is rejected before anything in it is followed. InstantiateCompiledGraph works as InstantiateGraph
+// and never writes to the compiled graph. A compiled graph only loads with the version of sogo and
+// the struct layout it was compiled with. Graphs with external audio inputs can not be compiled.
+typedef const struct CompiledGraph* HCompiledGraph;
+
+bool           GetCompiledGraphSize(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, TGraphSize* out_compiled_graph_size);
+bool           CompileGraph(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, const NodeStaticDescription* const* node_types, uint32_t node_type_count, void* compiled_graph_mem); // Align to void*
+HCompiledGraph LoadCompiledGraph(const void* compiled_graph_mem, TGraphSize compiled_graph_size, const NodeStaticDescription* const* node_types, uint32_t node_type_count);
+void           GetCompiledGraphBuffersSize(HCompiledGraph compiled_graph, GraphSize* out_graph_size);
+HGraph         InstantiateCompiledGraph(HCompiledGraph compiled_graph, const NodeStaticDescription* const* node_types, const GraphBuffers* graph_buffers);
+
+// Queues a command that is applied when the next batch starts rendering. One thread may post
+// commands while another thread renders the graph, no locking is needed around the graph.
+// Returns false if the command queue is full or the node, parameter, trigger or resource index is
+// out of range.
+bool PostParameter(HGraph graph, TNodeIndex node_index, TParameterIndex parameter_index, TParameter value, TFrameIndex frame_offset);
+bool PostTrigger(HGraph graph, TNodeIndex node_index, TTriggerSocketIndex trigger_index, TFrameIndex frame_offset);
+bool PostResource(HGraph graph, TNodeIndex node_index, TResourceIndex resource_index, const Resource* resource);
+
+// Trigger and ScheduleParameter may be called from any number of threads, including nodes firing
+// their TriggerOutputs while the graph renders in parallel. The events are picked up when the
+// node renders, they fail if max_trigger_event_count events are already waiting for the node.
+// Events that are picked up but do not fit next to events carried over from earlier batches are
+// dropped and counted.
+uint32_t GetDroppedEventCount(HGraph graph);
+
+// Renders independent nodes concurrently on a fixed pool of work stealing worker threads,
+// the calling thread participates in the rendering and returns once the batch is complete.
+// Idle workers spin for a while waiting for the next batch and then park until it starts.
+// An executor can render any graph with up to max_node_count render jobs, one batch at a time.
+TExecutorSize GetExecutorSize(uint32_t worker_thread_count, TNodeIndex max_node_count);
+HExecutor     CreateExecutor(void* executor_mem, uint32_t worker_thread_count, TNodeIndex max_node_count);
+void          DisposeExecutor(HExecutor executor);
+bool          RenderGraphParallel(HGraph graph, TFrameIndex frame_count, HExecutor executor);
+
+// Renders the graph one topological level at a time, the nodes in a level are shared between the
+// workers and all of them complete before the next level starts. Lower overhead per node than
+// RenderGraphParallel, suited for wide and shallow graphs with small batches.
+bool RenderGraphWavefront(HGraph graph, TFrameIndex frame_count, HExecutor executor);
+
+// Many instances of one graph description, such as a graph for each sound emitter. The instances
+// share the node table, the render order and the scratch buffer plan, each instance has its own
+// parameters, resources, events, outputs, context memory and scratch buffer and is an HGraph for
+// SetParameter, Trigger, Post*, SetResource and GetAudioOutput. RenderInstancedGraph renders the
+// active instances one node at a time and calls a node with a RenderInstancesCallback once for
+// all of them. Instances are only rendered through RenderInstancedGraph.
+// GetInstancedGraphSize covers all instances, there is no concurrent scratch buffer.
+typedef struct InstancedGraph* HInstancedGraph;
+
+bool            GetInstancedGraphSize(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, uint32_t instance_count, GraphSize* out_graph_size);
+HInstancedGraph CreateInstancedGraph(const GraphDescription* graph_description, const GraphRuntimeSettings* graph_runtime_settings, uint32_t instance_count, const GraphBuffers* graph_buffers);
+HGraph          GetInstance(HInstancedGraph instanced_graph, uint32_t instance_index);
+void            RenderInstancedGraph(HInstancedGraph instanced_graph, TFrameIndex frame_count);
+
+// Instances are created inactive, an inactive instance is not rendered and its outputs are silent.
+// Activating an instance resets its parameters, events and node state to how they were created,
+// resources and posted commands are kept. Not to be called while the instanced graph renders.
+bool SetInstanceActive(HInstancedGraph instanced_graph, uint32_t instance_index, bool is_active);
+
+// Render cost of a node over the recorded batches, in CPU cycles on x86 and nanoseconds elsewhere.
+// For a node type each batch is the summed cost of all nodes of that type in the graph.
+struct NodeProfile
+{
+    uint32_t m_BatchCount;
+    uint32_t m_MinTicks;
+    uint32_t m_AverageTicks;
+    uint32_t m_MaxTicks;
+    uint32_t m_P99Ticks;
+};
+
+// May be called from any thread while the graph renders, covers the batches that have completed
+// rendering. Returns false if profiling is compiled out or nothing has been recorded.
+bool GetNodeProfile(HGraph graph, TNodeIndex node_index, NodeProfile* out_profile);
+bool GetNodeTypeProfile(HGraph graph, const NodeStaticDescription* node_static_description, NodeProfile* out_profile);
+
+// Splits the batch of a node into sub blocks at the frame offsets of its events. NextSubBlock
+// applies the parameter events at the start of the sub block to RenderParameters::m_Parameters,
+// returns the events at the start of the sub block and the number of frames until the next event.
+// Returns false when the whole batch has been visited.
+struct EventIterator
+{
+    const RenderParameters* m_RenderParameters;
+    TTriggerCount           m_EventIndex;
+    TFrameIndex             m_FrameOffset;
+};
+
+void InitEventIterator(EventIterator* event_iterator, const RenderParameters* render_parameters);
+bool NextSubBlock(EventIterator* event_iterator, TFrameIndex* out_frame_offset, TFrameIndex* out_frame_count, const NodeEvent** out_events, TTriggerCount* out_event_count);
+
 } // namespace sogo
@@ -1,5 +1,7 @@
 #include "sogo_nodes.h"
+#include "sogo_simd.h"
 #include <math.h>
+#include <string.h>
 
 namespace sogo {
 
@@ -38,35 +40,21 @@ enum SOGO_SPLIT_AUDIO_OUTPUTS
     SOGO_SPLIT_AUDIO_OUTPUT_COUNT
 };
 
-static void RenderSplit(HGraph graph, HNode node, const RenderParameters* render_parameters)
+// Both outputs share the input buffer, a node that writes to one of them in place gets a copy
+// from the graph so the split never copies itself
+static void RenderSplit(HGraph, HNode, const RenderParameters* render_parameters)
 {
-    AudioOutput* input_data = render_parameters->m_AudioInputs[0].m_AudioOutput;
-    if (input_data->m_Buffer == 0x0)
-    {
-        render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
-        render_parameters->m_AudioOutputs[1].m_Buffer = 0x0;
-        return;
-    }
-    render_parameters->m_AudioOutputs[1].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, input_data->m_ChannelCount, render_parameters->m_FrameCount);
-
-    const float* output1      = input_data->m_Buffer;
-    float*       output2      = render_parameters->m_AudioOutputs[1].m_Buffer;
-    TSampleIndex sample_count = render_parameters->m_FrameCount * input_data->m_ChannelCount;
-    while (sample_count--)
-    {
-        *output2++ = *output1++;
-    }
-
-    render_parameters->m_AudioOutputs[0].m_Buffer = input_data->m_Buffer;
-    input_data->m_Buffer                          = 0x0;
+    float* buffer                                 = render_parameters->m_AudioInputs[SOGO_SPLIT_AUDIO_INPUT].m_AudioOutput->m_Buffer;
+    render_parameters->m_AudioOutputs[0].m_Buffer = buffer;
+    render_parameters->m_AudioOutputs[1].m_Buffer = buffer;
 }
 
 static struct AudioOutputDescription SplitNodeAudioOutputDescriptions[SOGO_SPLIT_AUDIO_OUTPUT_COUNT] = {
-    { AudioOutputDescription::PASS_THROUGH, { 0 } },
-    { AudioOutputDescription::AS_INPUT, { 0 } }
+    { AudioOutputDescription::SHARED, { 0 } },
+    { AudioOutputDescription::SHARED, { 0 } }
 };
 
-static void SplitNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, NodeRuntimeDescription* out_node_runtime_desc)
+static void SplitNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
 {
     out_node_runtime_desc->m_InitCallback      = 0;
     out_node_runtime_desc->m_RenderCallback    = RenderSplit;
@@ -83,7 +71,9 @@ const NodeStaticDescription SplitNodeDesc = {
     SOGO_SPLIT_RESOURCE_COUNT,
     SOGO_SPLIT_PARAMETER_COUNT,
     SOGO_SPLIT_TRIGGER_INPUT_COUNT,
-    SOGO_SPLIT_TRIGGER_OUTPUT_COUNT
+    SOGO_SPLIT_TRIGGER_OUTPUT_COUNT,
+    NODE_FLAG_SILENT_IN_SILENT_OUT,
+    { 0 }
 };
 
 ///////////////////// SOGO MERGE
@@ -121,57 +111,86 @@ enum SOGO_MERGE_AUDIO_OUTPUTS
     SOGO_MERGE_AUDIO_OUTPUT_COUNT
 };
 
-static bool RenderMerge(TFrameIndex frame_count, AudioOutput* input_data_1, AudioOutput* input_data_2)
+static bool RenderMerge(TFrameIndex frame_count, const AudioOutput* input_data_1, const AudioOutput* input_data_2, float* output)
 {
     if (input_data_1->m_ChannelCount != input_data_2->m_ChannelCount)
     {
         // Mixed channel count not yet supported
         return false;
     }
+    if (input_data_1->m_IsConstant)
+    {
+        const AudioOutput* swap = input_data_1;
+        input_data_1            = input_data_2;
+        input_data_2            = swap;
+    }
+    if (input_data_2->m_IsConstant)
+    {
+        // Adds the constant frame to every frame of the other input
+        TChannelIndex channel_count = input_data_1->m_ChannelCount;
+        TFrameIndex   input_frames  = input_data_1->m_IsConstant ? 1 : frame_count;
+        for (TFrameIndex f = 0; f < input_frames; ++f)
+        {
+            for (TChannelIndex c = 0; c < channel_count; ++c)
+            {
+                output[f * channel_count + c] = input_data_1->m_Buffer[f * channel_count + c] + input_data_2->m_Buffer[c];
+            }
+        }
+        return true;
+    }
     for (uint32_t sample = 0; sample < frame_count * input_data_1->m_ChannelCount; ++sample)
     {
-        input_data_1->m_Buffer[sample] += input_data_2->m_Buffer[sample];
+        output[sample] = input_data_1->m_Buffer[sample] + input_data_2->m_Buffer[sample];
     }
     return true;
 }
 
-static void RenderMerge(HGraph, HNode, const RenderParameters* render_parameters)
+static void RenderMerge(HGraph graph, HNode node, const RenderParameters* render_parameters)
 {
-    if (render_parameters->m_AudioInputs[0].m_AudioOutput->m_Buffer == 0x0)
+    AudioOutput* input_data_1 = render_parameters->m_AudioInputs[0].m_AudioOutput;
+    AudioOutput* input_data_2 = render_parameters->m_AudioInputs[1].m_AudioOutput;
+    if (input_data_1->m_Buffer == 0x0 && input_data_2->m_Buffer == 0x0)
     {
-        if (render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer == 0x0)
-        {
-            render_parameters->m_AudioInputs[0].m_AudioOutput->m_Buffer = 0x0;
-            return;
-        }
-        else
+        render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
+        return;
+    }
+
+    TFrameIndex frame_count = render_parameters->m_FrameCount;
+    float*      output      = render_parameters->m_AllocateAudioBuffer(graph, node, render_parameters->m_AudioOutputs[0].m_ChannelCount, frame_count);
+
+    render_parameters->m_AudioOutputs[0].m_Buffer = output;
+    if (output == 0x0)
+    {
+        return;
+    }
+
+    // The output is planned as a buffer of its own so a single input is copied rather than passed on
+    const AudioOutput* single_input = input_data_1->m_Buffer == 0x0 ? input_data_2 : (input_data_2->m_Buffer == 0x0 ? input_data_1 : 0x0);
+    if (single_input != 0x0)
+    {
+        if (single_input->m_ChannelCount != render_parameters->m_AudioOutputs[0].m_ChannelCount)
         {
-            render_parameters->m_AudioOutputs[0].m_Buffer               = render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer;
-            render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer = 0x0;
+            render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
             return;
         }
-    }
-    else if (render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer == 0x0)
-    {
-        render_parameters->m_AudioOutputs[0].m_Buffer               = render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer;
-        render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer = 0x0;
+        memcpy(output, single_input->m_Buffer, sizeof(float) * (single_input->m_IsConstant ? 1 : frame_count) * single_input->m_ChannelCount);
+        render_parameters->m_AudioOutputs[0].m_IsConstant = single_input->m_IsConstant;
         return;
     }
 
-    if (!RenderMerge(render_parameters->m_FrameCount, render_parameters->m_AudioInputs[0].m_AudioOutput, render_parameters->m_AudioInputs[1].m_AudioOutput))
+    if (!RenderMerge(frame_count, input_data_1, input_data_2, output))
     {
         render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
         return;
     }
-    render_parameters->m_AudioOutputs[0].m_Buffer               = render_parameters->m_AudioInputs[0].m_AudioOutput->m_Buffer;
-    render_parameters->m_AudioInputs[1].m_AudioOutput->m_Buffer = 0x0;
+    render_parameters->m_AudioOutputs[0].m_IsConstant = input_data_1->m_IsConstant && input_data_2->m_IsConstant;
 }
 
 static struct AudioOutputDescription MergeNodeAudioOutputDescriptions[SOGO_MERGE_AUDIO_OUTPUT_COUNT] = {
-    { AudioOutputDescription::PASS_THROUGH, { 0 } }
+    { AudioOutputDescription::AS_INPUT, { 0 } }
 };
 
-static void MergeNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, NodeRuntimeDescription* out_node_runtime_desc)
+static void MergeNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
 {
     out_node_runtime_desc->m_InitCallback      = 0;
     out_node_runtime_desc->m_RenderCallback    = RenderMerge;
@@ -188,7 +207,9 @@ const NodeStaticDescription MergeNodeDesc = {
     SOGO_MERGE_RESOURCE_COUNT,
     SOGO_MERGE_PARAMETER_COUNT,
     SOGO_MERGE_TRIGGER_INPUT_COUNT,
-    SOGO_MERGE_TRIGGER_OUTPUT_COUNT
+    SOGO_MERGE_TRIGGER_OUTPUT_COUNT,
+    NODE_FLAG_SILENT_IN_SILENT_OUT | NODE_FLAG_CONSTANT_INPUTS,
+    { 0 }
 };
 
 ///////////////////// SOGO GAIN
@@ -227,104 +248,264 @@ enum SOGO_GAIN_AUDIO_OUTPUTS
     SOGO_GAIN_AUDIO_OUTPUT_COUNT
 };
 
-static bool GainFlat(float* io_buffer, TChannelIndex channel_count, TFrameIndex frame_count, float gain)
+// The gain kernels write input * gain to output, output may be the same buffer as input
+static void GainFlatScalar(float* output, const float* input, uint32_t sample_count, float gain)
 {
-    switch (channel_count)
+    while (sample_count--)
     {
-        case 1:
-            while (frame_count--)
-            {
-                *io_buffer++ *= gain;
-            }
-            return true;
-        case 2:
-            while (frame_count--)
-            {
-                *io_buffer++ *= gain;
-                *io_buffer++ *= gain;
-            }
-            return true;
-        default:
-            return false;
+        *output++ = *input++ * gain;
     }
 }
 
-static bool GainRamp(float* io_buffer, TChannelIndex channel_count, TFrameIndex frame_count, float& gain, float gain_step)
+// The gain of sample s is gain + gain_step * (s / channel_count). The pattern of frame offsets
+// across the lanes of the vectors repeats every lcm(channel_count, lane count) samples, the
+// offsets of one period are set up once and the gain at the start of each period is computed
+// from the period index so rounding errors do not accumulate.
+static uint32_t MakeGainRampOffsets(TChannelIndex channel_count, uint32_t lane_count, float* out_offsets)
 {
-    switch (channel_count)
+    uint32_t period_sample_count = channel_count;
+    while (period_sample_count % lane_count != 0)
     {
-        case 1:
-            while (frame_count--)
-            {
-                *io_buffer++ *= gain;
-                gain += gain_step;
-            }
-            return true;
-        case 2:
-            while (frame_count--)
-            {
-                *io_buffer++ *= gain;
-                *io_buffer++ *= gain;
-                gain += gain_step;
-            }
-            return true;
-        default:
-            return false;
+        period_sample_count += channel_count;
+    }
+    for (uint32_t s = 0; s < period_sample_count; ++s)
+    {
+        out_offsets[s] = (float)(s / channel_count);
+    }
+    return period_sample_count;
+}
+
+static void GainRampScalar(float* output, const float* input, TChannelIndex channel_count, TFrameIndex frame_count, float gain, float gain_step)
+{
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        float frame_gain = gain + gain_step * f;
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            *output++ = *input++ * frame_gain;
+        }
+    }
+}
+
+#if SOGO_SIMD_X86
+static void GainFlatSSE2(float* output, const float* input, uint32_t sample_count, float gain)
+{
+    __m128   gain4        = _mm_set1_ps(gain);
+    uint32_t vector_count = sample_count / 4;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        _mm_storeu_ps(output, _mm_mul_ps(_mm_loadu_ps(input), gain4));
+        output += 4;
+        input += 4;
+    }
+    GainFlatScalar(output, input, sample_count - vector_count * 4, gain);
+}
+
+SOGO_TARGET_AVX2 static void GainFlatAVX2(float* output, const float* input, uint32_t sample_count, float gain)
+{
+    __m256   gain8        = _mm256_set1_ps(gain);
+    uint32_t vector_count = sample_count / 8;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        _mm256_storeu_ps(output, _mm256_mul_ps(_mm256_loadu_ps(input), gain8));
+        output += 8;
+        input += 8;
+    }
+    GainFlatScalar(output, input, sample_count - vector_count * 8, gain);
+}
+
+static void GainRampSSE2(float* output, const float* input, TChannelIndex channel_count, TFrameIndex frame_count, float gain, float gain_step)
+{
+    float    offsets[255 * 4];
+    uint32_t period_sample_count = MakeGainRampOffsets(channel_count, 4, offsets);
+    uint32_t period_frame_count  = period_sample_count / channel_count;
+    uint32_t period_count        = frame_count / period_frame_count;
+    __m128   gain_step4          = _mm_set1_ps(gain_step);
+    for (uint32_t p = 0; p < period_count; ++p)
+    {
+        __m128 period_gain4 = _mm_set1_ps(gain + gain_step * (float)(p * period_frame_count));
+        for (uint32_t s = 0; s < period_sample_count; s += 4)
+        {
+            __m128 gain4 = _mm_add_ps(period_gain4, _mm_mul_ps(gain_step4, _mm_loadu_ps(&offsets[s])));
+            _mm_storeu_ps(output, _mm_mul_ps(_mm_loadu_ps(input), gain4));
+            output += 4;
+            input += 4;
+        }
+    }
+    uint32_t ramped_frame_count = period_count * period_frame_count;
+    GainRampScalar(output, input, channel_count, frame_count - ramped_frame_count, gain + gain_step * ramped_frame_count, gain_step);
+}
+
+SOGO_TARGET_AVX2 static void GainRampAVX2(float* output, const float* input, TChannelIndex channel_count, TFrameIndex frame_count, float gain, float gain_step)
+{
+    float    offsets[255 * 8];
+    uint32_t period_sample_count = MakeGainRampOffsets(channel_count, 8, offsets);
+    uint32_t period_frame_count  = period_sample_count / channel_count;
+    uint32_t period_count        = frame_count / period_frame_count;
+    __m256   gain_step8          = _mm256_set1_ps(gain_step);
+    for (uint32_t p = 0; p < period_count; ++p)
+    {
+        __m256 period_gain8 = _mm256_set1_ps(gain + gain_step * (float)(p * period_frame_count));
+        for (uint32_t s = 0; s < period_sample_count; s += 8)
+        {
+            __m256 gain8 = _mm256_add_ps(period_gain8, _mm256_mul_ps(gain_step8, _mm256_loadu_ps(&offsets[s])));
+            _mm256_storeu_ps(output, _mm256_mul_ps(_mm256_loadu_ps(input), gain8));
+            output += 8;
+            input += 8;
+        }
+    }
+    uint32_t ramped_frame_count = period_count * period_frame_count;
+    GainRampScalar(output, input, channel_count, frame_count - ramped_frame_count, gain + gain_step * ramped_frame_count, gain_step);
+}
+#endif
+
+static const float GAIN_MAX_STEP_PER_FRAME = 1.0f / 32;
+
+struct GainKernels
+{
+    void (*m_Flat)(float* output, const float* input, uint32_t sample_count, float gain);
+    void (*m_Ramp)(float* output, const float* input, TChannelIndex channel_count, TFrameIndex frame_count, float gain, float gain_step);
+};
+
+static GainKernels GetGainKernels(SimdLevel simd_level)
+{
+    GainKernels kernels = { GainFlatScalar, GainRampScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_Flat = GainFlatAVX2;
+        kernels.m_Ramp = GainRampAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_Flat = GainFlatSSE2;
+        kernels.m_Ramp = GainRampSSE2;
     }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
+
+static const GainKernels& GetGainKernels()
+{
+    static const GainKernels kernels = GetGainKernels(GetSimdLevel());
+    return kernels;
 }
 
-static bool RenderGain(TFrameIndex frame_count, AudioOutput* output_data, float gain, float& filtered_gain)
+// Repeats the first frame of a constant input over the output, which may be the input buffer
+static void FillConstant(float* output, const float* input, TChannelIndex channel_count, TFrameIndex frame_count)
 {
-    static const float max_gain_step_per_frame = 1.0f / 32;
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            output[f * channel_count + c] = input[c];
+        }
+    }
+}
 
-    if (fabs(gain - filtered_gain) < 0.001f)
+// Ramps from filtered_gain towards gain at most GAIN_MAX_STEP_PER_FRAME per frame, filtered_gain
+// is left where the ramp ended. Writes input * gain to the output buffer, which is the input buffer
+// unless the graph made a copy on write, and sets it to 0x0 when the gain is silent. A constant
+// input gives a constant output unless the gain ramps.
+static void RenderGain(TFrameIndex frame_count, const AudioOutput* input_data, AudioOutput* output_data, float gain, float& filtered_gain)
+{
+    const GainKernels& kernels       = GetGainKernels();
+    TChannelIndex      channel_count = output_data->m_ChannelCount;
+    const float*       input         = input_data->m_Buffer;
+    float*             output        = output_data->m_Buffer;
+    bool               is_flat       = fabs(gain - filtered_gain) < 0.001f;
+    if (input_data->m_IsConstant && is_flat)
+    {
+        frame_count               = 1;
+        output_data->m_IsConstant = true;
+    }
+    else if (input_data->m_IsConstant)
+    {
+        FillConstant(output, input, channel_count, frame_count);
+        input = output;
+    }
+    if (is_flat)
     {
         filtered_gain = gain;
         if (filtered_gain < 0.001f)
         {
             output_data->m_Buffer = 0x0;
-            return true;
         }
-        return GainFlat(output_data->m_Buffer, output_data->m_ChannelCount, frame_count, gain);
+        else if (gain != 1.f)
+        {
+            kernels.m_Flat(output, input, (uint32_t)channel_count * frame_count, gain);
+        }
+        else if (output != input)
+        {
+            memcpy(output, input, sizeof(float) * channel_count * frame_count);
+        }
+        return;
     }
 
-    TFrameIndex step_count  = (TFrameIndex)(floor(fabs(gain - filtered_gain) / max_gain_step_per_frame));
+    TFrameIndex step_count  = (TFrameIndex)(floor(fabs(gain - filtered_gain) / GAIN_MAX_STEP_PER_FRAME));
     TFrameIndex ramp_frames = (step_count < frame_count) ? step_count : frame_count;
-    float       gain_step   = gain > filtered_gain ? max_gain_step_per_frame : -max_gain_step_per_frame;
+    float       gain_step   = gain > filtered_gain ? GAIN_MAX_STEP_PER_FRAME : -GAIN_MAX_STEP_PER_FRAME;
 
-    if (!GainRamp(output_data->m_Buffer, output_data->m_ChannelCount, ramp_frames, filtered_gain, gain_step))
+    kernels.m_Ramp(output, input, channel_count, ramp_frames, filtered_gain, gain_step);
+    if (ramp_frames < frame_count)
     {
-        return false;
+        filtered_gain = gain;
+        kernels.m_Flat(&output[channel_count * ramp_frames], &input[channel_count * ramp_frames], (uint32_t)channel_count * (frame_count - ramp_frames), gain);
+    }
+    else
+    {
+        filtered_gain += gain_step * ramp_frames;
     }
-    filtered_gain = gain;
-    return GainFlat(&output_data->m_Buffer[output_data->m_ChannelCount * ramp_frames], output_data->m_ChannelCount, frame_count - ramp_frames, gain);
 }
 
 static void RenderGain(HGraph, HNode, const RenderParameters* render_parameters)
 {
-    AudioOutput* input_data    = render_parameters->m_AudioInputs[SOGO_GAIN_AUDIO_INPUT].m_AudioOutput;
-    float        gain          = render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_GAIN_INDEX].m_Float;
-    float        filtered_gain = render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float;
+    const AudioOutput* input_data    = render_parameters->m_AudioInputs[SOGO_GAIN_AUDIO_INPUT].m_AudioOutput;
+    float              gain          = render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_GAIN_INDEX].m_Float;
+    float              filtered_gain = render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float;
     if (input_data->m_Buffer == 0x0)
     {
         // TODO: Hmm, we still want to filter the gain, or can we just hack it and set filtered_gain to gain?
         // Assuming each render call has enough frames, yes, otherwise no. Hack it for now.
-        filtered_gain                                 = gain;
-        render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
+        render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float = gain;
+        render_parameters->m_AudioOutputs[0].m_Buffer                                    = 0x0;
         return;
     }
 
-    render_parameters->m_AudioOutputs[SOGO_GAIN_AUDIO_OUTPUT].m_Buffer = input_data->m_Buffer;
-    input_data->m_Buffer                                               = 0x0;
-    if (!RenderGain(render_parameters->m_FrameCount, &render_parameters->m_AudioOutputs[SOGO_GAIN_AUDIO_OUTPUT], gain, filtered_gain))
+    RenderGain(render_parameters->m_FrameCount, input_data, &render_parameters->m_AudioOutputs[SOGO_GAIN_AUDIO_OUTPUT], gain, filtered_gain);
+    render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float = filtered_gain;
+}
+
+// Instances with a settled gain and a varying input are scaled in one pass with the kernels
+// looked up once, silent inputs, constant inputs and gain ramps take the single instance path.
+static void RenderGainInstances(const HGraph* graphs, HNode node, const RenderParameters* const* render_parameters, uint32_t instance_count)
+{
+    const GainKernels& kernels = GetGainKernels();
+    for (uint32_t i = 0; i < instance_count; ++i)
     {
-        // TODO: Hmm, we still want to filter the gain, or can we just hack it and set filtered_gain to gain?
-        // Assuming each render call has enough frames, yes, otherwise no. Hack it for now.
-        filtered_gain                                 = gain;
-        render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
-        return;
+        const RenderParameters* instance_parameters = render_parameters[i];
+        const AudioOutput*      input_data          = instance_parameters->m_AudioInputs[SOGO_GAIN_AUDIO_INPUT].m_AudioOutput;
+        AudioOutput*            output_data         = &instance_parameters->m_AudioOutputs[SOGO_GAIN_AUDIO_OUTPUT];
+        TParameter*             parameters          = instance_parameters->m_Parameters;
+        float                   gain                = parameters[SOGO_GAIN_PARAMETER_GAIN_INDEX].m_Float;
+        if (input_data->m_Buffer == 0x0 || input_data->m_IsConstant || gain < 0.001f || fabs(gain - parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float) >= 0.001f)
+        {
+            RenderGain(graphs[i], node, instance_parameters);
+            continue;
+        }
+        uint32_t sample_count = (uint32_t)output_data->m_ChannelCount * instance_parameters->m_FrameCount;
+        if (gain != 1.f)
+        {
+            kernels.m_Flat(output_data->m_Buffer, input_data->m_Buffer, sample_count, gain);
+        }
+        else if (output_data->m_Buffer != input_data->m_Buffer)
+        {
+            memcpy(output_data->m_Buffer, input_data->m_Buffer, sizeof(float) * sample_count);
+        }
+        parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float = gain;
     }
-    render_parameters->m_Parameters[SOGO_GAIN_PARAMETER_FILTERED_GAIN_INDEX].m_Float = filtered_gain;
 }
 
 static const ParameterDescription GainParameters[SOGO_GAIN_PARAMETER_COUNT] = {
@@ -336,11 +517,12 @@ static struct AudioOutputDescription GainNodeAudioOutputDescriptions[SOGO_GAIN_A
     { AudioOutputDescription::PASS_THROUGH, { 0 } }
 };
 
-static void GainNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, NodeRuntimeDescription* out_node_runtime_desc)
+static void GainNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
 {
-    out_node_runtime_desc->m_InitCallback      = 0;
-    out_node_runtime_desc->m_RenderCallback    = RenderGain;
-    out_node_runtime_desc->m_ContextMemorySize = 0;
+    out_node_runtime_desc->m_InitCallback            = 0;
+    out_node_runtime_desc->m_RenderCallback          = RenderGain;
+    out_node_runtime_desc->m_ContextMemorySize       = 0;
+    out_node_runtime_desc->m_RenderInstancesCallback = RenderGainInstances;
 }
 
 const NodeStaticDescription GainNodeDesc = {
@@ -353,169 +535,3315 @@ const NodeStaticDescription GainNodeDesc = {
     SOGO_GAIN_RESOURCE_COUNT,
     SOGO_GAIN_PARAMETER_COUNT,
     SOGO_GAIN_TRIGGER_INPUT_COUNT,
-    SOGO_GAIN_TRIGGER_OUTPUT_COUNT
-};
-
-///////////////////// SOGO SINE
-
-enum SOGO_SINE_PARAMETERS
-{
-    SOGO_SINE_PARAMETER_FREQUENCY_INDEX,
-    SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX,
-    SOGO_SINE_PARAMETER_FILTERED_VALUE_INDEX,
-    SOGO_SINE_PARAMETER_COUNT
+    SOGO_GAIN_TRIGGER_OUTPUT_COUNT,
+    NODE_FLAG_SILENT_IN_SILENT_OUT | NODE_FLAG_CONSTANT_INPUTS,
+    { 0 }
 };
 
-enum SOGO_SINE_RESOURCES
-{
-    SOGO_SINE_RESOURCE_COUNT
-};
+///////////////////// SOGO MIXER
 
-enum SOGO_SINE_TRIGGER_INPUTS
+enum SOGO_MIXER_AUDIO_OUTPUTS
 {
-    SOGO_SINE_TRIGGER_START_INDEX,
-    SOGO_SINE_TRIGGER_STOP_INDEX,
-    SOGO_SINE_TRIGGER_INPUT_COUNT
+    SOGO_MIXER_AUDIO_OUTPUT,
+    SOGO_MIXER_AUDIO_OUTPUT_COUNT
 };
 
-enum SOGO_SINE_TRIGGER_OUTPUTS
-{
-    SOGO_SINE_TRIGGER_OUTPUT_COUNT
-};
+static const TFrameIndex MIXER_TILE_FRAME_COUNT = 64; // The output tile stays in L1 while all inputs are added to it
 
-enum SOGO_SINE_AUDIO_INPUTS
+// The gain of each input ramps towards its "Gain<n>" parameter as the gain node does
+struct MixerContext
 {
-    SOGO_SINE_AUDIO_INPUT_COUNT
+    float m_FilteredGains[MIXER_MAX_INPUT_COUNT];
 };
 
-enum SOGO_SINE_AUDIO_OUTPUTS
+static void MixAddScalar(float* io_buffer, const float* input, uint32_t sample_count, float gain)
 {
-    SOGO_SINE_AUDIO_OUTPUT,
-    SOGO_SINE_AUDIO_OUTPUT_COUNT
-};
+    while (sample_count--)
+    {
+        *io_buffer++ += *input++ * gain;
+    }
+}
 
-static void RenderSine(HGraph graph, HNode node, const RenderParameters* render_parameters)
+static void MixAddMonoScalar(float* io_buffer, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, float gain)
 {
-    float frequency          = render_parameters->m_Parameters[SOGO_SINE_PARAMETER_FREQUENCY_INDEX].m_Float;
-    float filtered_frequency = render_parameters->m_Parameters[SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX].m_Float;
-    float value              = render_parameters->m_Parameters[SOGO_SINE_PARAMETER_FILTERED_VALUE_INDEX].m_Float;
-
-    filtered_frequency                            = ((frequency * 15) + filtered_frequency) / 16;
-    float       step                              = ((2.f * 3.141592654f) * filtered_frequency) / render_parameters->m_FrameRate;
-    TFrameIndex frame_count                       = render_parameters->m_FrameCount;
-    render_parameters->m_AudioOutputs[0].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, 1, frame_count);
-    float* io_buffer                              = render_parameters->m_AudioOutputs[0].m_Buffer;
     while (frame_count--)
     {
-        float frame  = sinf(value);
-        *io_buffer++ = frame;
-        value += step;
-        if (value > (2.f * 3.141592654f))
+        float sample = *input++ * gain;
+        for (TChannelIndex c = 0; c < channel_count; ++c)
         {
-            value -= (2.f * 3.141592654f);
+            *io_buffer++ += sample;
         }
     }
-    render_parameters->m_Parameters[SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX].m_Float = filtered_frequency;
-    render_parameters->m_Parameters[SOGO_SINE_PARAMETER_FILTERED_VALUE_INDEX].m_Float     = value;
 }
 
-static const ParameterDescription SineParameters[SOGO_SINE_PARAMETER_COUNT] = {
-    { "Frequency", 4000.0f },
-    { 0x0, 4000.0f },
-    { 0x0, 0.0f }
-};
-
-static const TriggerDescription SineTriggers[SOGO_SINE_TRIGGER_INPUT_COUNT] = {
-    { "Start" },
-    { "Stop" }
-};
-
-static struct AudioOutputDescription SineNodeAudioOutputDescriptions[SOGO_SINE_AUDIO_OUTPUT_COUNT] = {
-    { AudioOutputDescription::FIXED, { 1 } }
-};
-
-static void SineNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, NodeRuntimeDescription* out_node_runtime_desc)
+#if SOGO_SIMD_X86
+static void MixAddSSE2(float* io_buffer, const float* input, uint32_t sample_count, float gain)
 {
-    out_node_runtime_desc->m_InitCallback      = 0;
-    out_node_runtime_desc->m_RenderCallback    = RenderSine;
-    out_node_runtime_desc->m_ContextMemorySize = 0;
+    __m128   gain4        = _mm_set1_ps(gain);
+    uint32_t vector_count = sample_count / 4;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        _mm_storeu_ps(io_buffer, _mm_add_ps(_mm_loadu_ps(io_buffer), _mm_mul_ps(_mm_loadu_ps(input), gain4)));
+        io_buffer += 4;
+        input += 4;
+    }
+    MixAddScalar(io_buffer, input, sample_count - vector_count * 4, gain);
 }
 
-const NodeStaticDescription SineNodeDesc = {
-    SineNodeGetNodeRuntimeDescCallback,
-    SineParameters,
-    SineNodeAudioOutputDescriptions,
-    0x0,
-    SOGO_SINE_AUDIO_INPUT_COUNT,
-    SOGO_SINE_AUDIO_OUTPUT_COUNT,
-    SOGO_SINE_RESOURCE_COUNT,
-    SOGO_SINE_PARAMETER_COUNT,
-    SOGO_SINE_TRIGGER_INPUT_COUNT,
-    SOGO_SINE_TRIGGER_OUTPUT_COUNT
-};
-
-///////////////////// SOGO MAKE_STEREO
-
-enum SOGO_TOSTEREO_PARAMETERS
+static void MixAddMonoSSE2(float* io_buffer, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, float gain)
 {
-    SOGO_TOSTEREO_PARAMETER_COUNT
-};
+    if (channel_count != 2)
+    {
+        MixAddMonoScalar(io_buffer, input, frame_count, channel_count, gain);
+        return;
+    }
+    __m128   gain4        = _mm_set1_ps(gain);
+    uint32_t vector_count = frame_count / 4;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        __m128 mono = _mm_mul_ps(_mm_loadu_ps(input), gain4);
+        _mm_storeu_ps(io_buffer, _mm_add_ps(_mm_loadu_ps(io_buffer), _mm_unpacklo_ps(mono, mono)));
+        _mm_storeu_ps(io_buffer + 4, _mm_add_ps(_mm_loadu_ps(io_buffer + 4), _mm_unpackhi_ps(mono, mono)));
+        io_buffer += 8;
+        input += 4;
+    }
+    MixAddMonoScalar(io_buffer, input, frame_count - vector_count * 4, channel_count, gain);
+}
 
-enum SOGO_TOSTEREO_RESOURCES
+SOGO_TARGET_AVX2 static void MixAddAVX2(float* io_buffer, const float* input, uint32_t sample_count, float gain)
 {
-    SOGO_TOSTEREO_RESOURCE_COUNT
-};
+    __m256   gain8        = _mm256_set1_ps(gain);
+    uint32_t vector_count = sample_count / 8;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        _mm256_storeu_ps(io_buffer, _mm256_add_ps(_mm256_loadu_ps(io_buffer), _mm256_mul_ps(_mm256_loadu_ps(input), gain8)));
+        io_buffer += 8;
+        input += 8;
+    }
+    MixAddScalar(io_buffer, input, sample_count - vector_count * 8, gain);
+}
 
-enum SOGO_TOSTEREO_TRIGGER_INPUTS
+SOGO_TARGET_AVX2 static void MixAddMonoAVX2(float* io_buffer, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, float gain)
 {
-    SOGO_TOSTEREO_TRIGGER_INPUT_COUNT
-};
+    if (channel_count != 2)
+    {
+        MixAddMonoScalar(io_buffer, input, frame_count, channel_count, gain);
+        return;
+    }
+    __m128   gain4        = _mm_set1_ps(gain);
+    uint32_t vector_count = frame_count / 4;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        __m128 mono   = _mm_mul_ps(_mm_loadu_ps(input), gain4);
+        __m256 stereo = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(mono, mono)), _mm_unpackhi_ps(mono, mono), 1);
+        _mm256_storeu_ps(io_buffer, _mm256_add_ps(_mm256_loadu_ps(io_buffer), stereo));
+        io_buffer += 8;
+        input += 4;
+    }
+    MixAddMonoScalar(io_buffer, input, frame_count - vector_count * 4, channel_count, gain);
+}
+#endif
 
-enum SOGO_TOSTEREO_TRIGGER_OUTPUTS
+struct MixKernels
 {
-    SOGO_TOSTEREO_TRIGGER_OUTPUT_COUNT
+    void (*m_Add)(float* io_buffer, const float* input, uint32_t sample_count, float gain);
+    void (*m_AddMono)(float* io_buffer, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, float gain);
 };
 
-enum SOGO_TOSTEREO_AUDIO_INPUTS
+static MixKernels GetMixKernels(SimdLevel simd_level)
 {
-    SOGO_TOSTEREO_AUDIO_INPUT,
-    SOGO_TOSTEREO_AUDIO_INPUT_COUNT
-};
+    MixKernels kernels = { MixAddScalar, MixAddMonoScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_Add     = MixAddAVX2;
+        kernels.m_AddMono = MixAddMonoAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_Add     = MixAddSSE2;
+        kernels.m_AddMono = MixAddMonoSSE2;
+    }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
 
-enum SOGO_TOSTEREO_AUDIO_OUTPUTS
+static const MixKernels& GetMixKernels()
 {
-    SOGO_TOSTEREO_AUDIO_OUTPUT,
-    SOGO_TOSTEREO_AUDIO_OUTPUT_COUNT
-};
+    static const MixKernels kernels = GetMixKernels(GetSimdLevel());
+    return kernels;
+}
 
-static void RenderToStereo(HGraph graph, HNode node, const RenderParameters* render_parameters)
+// Adds a constant input to every frame, a mono input is added to every channel
+static void MixAddConstant(float* io_buffer, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, TChannelIndex input_channel_count, float gain)
 {
-    AudioOutput* input_data = render_parameters->m_AudioInputs[SOGO_TOSTEREO_AUDIO_INPUT].m_AudioOutput;
-    if (input_data == 0x0)
+    float frame[MIXER_MAX_CHANNEL_COUNT];
+    for (TChannelIndex c = 0; c < channel_count; ++c)
     {
-        render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_Buffer = 0x0;
-        return;
+        frame[c] = input[input_channel_count == 1 ? 0 : c] * gain;
     }
-    if (input_data->m_ChannelCount == 2)
+    while (frame_count--)
+    {
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            *io_buffer++ += frame[c];
+        }
+    }
+}
+
+static bool IsMixerGainFlat(float gain, float filtered_gain)
+{
+    return fabsf(gain - filtered_gain) < 0.001f;
+}
+
+// Adds the input of one tile ramped from filtered_gain towards gain, at most
+// GAIN_MAX_STEP_PER_FRAME per frame, and leaves filtered_gain where the ramp ended
+static void MixAddRamp(const MixKernels& kernels, float* tile, const AudioOutput* input, TFrameIndex tile_offset, TFrameIndex tile_frame_count, TChannelIndex channel_count, float gain, float& filtered_gain)
+{
+    const GainKernels& gain_kernels        = GetGainKernels();
+    TChannelIndex      input_channel_count = input->m_ChannelCount;
+    const float*       source              = &input->m_Buffer[tile_offset * input_channel_count];
+    float              ramped[MIXER_TILE_FRAME_COUNT * MIXER_MAX_CHANNEL_COUNT];
+    if (input->m_IsConstant)
+    {
+        FillConstant(ramped, input->m_Buffer, input_channel_count, tile_frame_count);
+        source = ramped;
+    }
+
+    float       step_count        = floorf(fabsf(gain - filtered_gain) / GAIN_MAX_STEP_PER_FRAME);
+    TFrameIndex ramp_frame_count  = step_count < (float)tile_frame_count ? (TFrameIndex)step_count : tile_frame_count;
+    float       gain_step         = gain > filtered_gain ? GAIN_MAX_STEP_PER_FRAME : -GAIN_MAX_STEP_PER_FRAME;
+    uint32_t    ramp_sample_count = (uint32_t)ramp_frame_count * input_channel_count;
+    gain_kernels.m_Ramp(ramped, source, input_channel_count, ramp_frame_count, filtered_gain, gain_step);
+    if (ramp_frame_count < tile_frame_count)
+    {
+        gain_kernels.m_Flat(&ramped[ramp_sample_count], &source[ramp_sample_count], (uint32_t)(tile_frame_count - ramp_frame_count) * input_channel_count, gain);
+        filtered_gain = gain;
+    }
+    else
+    {
+        filtered_gain += gain_step * ramp_frame_count;
+    }
+
+    if (input_channel_count == channel_count)
+    {
+        kernels.m_Add(tile, ramped, (uint32_t)tile_frame_count * channel_count, 1.f);
+    }
+    else
+    {
+        kernels.m_AddMono(tile, ramped, tile_frame_count, channel_count, 1.f);
+    }
+}
+
+static void RenderMixer(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    const AudioInput* inputs         = render_parameters->m_AudioInputs;
+    TAudioSocketIndex input_count    = render_parameters->m_AudioInputCount;
+    TChannelIndex     channel_count  = render_parameters->m_AudioOutputs[SOGO_MIXER_AUDIO_OUTPUT].m_ChannelCount;
+    float*            filtered_gains = ((MixerContext*)render_parameters->m_ContextMemory)->m_FilteredGains;
+
+    // Silent inputs take their gain at once, as the gain node does, a constant output needs
+    // every input to be constant and settled
+    bool has_input   = false;
+    bool is_constant = true;
+    for (TAudioSocketIndex i = 0; i < input_count; ++i)
+    {
+        float gain = render_parameters->m_Parameters[i].m_Float;
+        if (inputs[i].m_AudioOutput->m_Buffer == 0x0)
+        {
+            filtered_gains[i] = gain;
+            continue;
+        }
+        has_input = true;
+        is_constant &= inputs[i].m_AudioOutput->m_IsConstant && IsMixerGainFlat(gain, filtered_gains[i]);
+    }
+    if (!has_input)
+    {
+        render_parameters->m_AudioOutputs[SOGO_MIXER_AUDIO_OUTPUT].m_Buffer = 0x0;
+        return;
+    }
+
+    TFrameIndex frame_count = render_parameters->m_FrameCount;
+    float*      out_buffer  = render_parameters->m_AllocateAudioBuffer(graph, node, channel_count, frame_count);
+    render_parameters->m_AudioOutputs[SOGO_MIXER_AUDIO_OUTPUT].m_Buffer = out_buffer;
+    if (out_buffer == 0x0)
+    {
+        return;
+    }
+
+    const MixKernels& kernels = GetMixKernels();
+    EventIterator     event_iterator;
+    InitEventIterator(&event_iterator, render_parameters);
+    TFrameIndex      sub_block_offset;
+    TFrameIndex      sub_block_count;
+    const NodeEvent* events;
+    TTriggerCount    event_count;
+    while (NextSubBlock(&event_iterator, &sub_block_offset, &sub_block_count, &events, &event_count))
+    {
+        TFrameIndex sub_block_end = sub_block_offset + sub_block_count;
+        if (is_constant && sub_block_count == frame_count)
+        {
+            // Constant inputs and no gain change inside the batch, mix a single frame
+            sub_block_end                                                           = 1;
+            render_parameters->m_AudioOutputs[SOGO_MIXER_AUDIO_OUTPUT].m_IsConstant = true;
+        }
+        for (TFrameIndex tile_offset = sub_block_offset; tile_offset < sub_block_end; tile_offset += MIXER_TILE_FRAME_COUNT)
+        {
+            TFrameIndex tile_frame_count = sub_block_end - tile_offset < MIXER_TILE_FRAME_COUNT ? sub_block_end - tile_offset : MIXER_TILE_FRAME_COUNT;
+            float*      tile             = &out_buffer[tile_offset * channel_count];
+            memset(tile, 0, sizeof(float) * tile_frame_count * channel_count);
+            for (TAudioSocketIndex i = 0; i < input_count; ++i)
+            {
+                const AudioOutput* input = inputs[i].m_AudioOutput;
+                float              gain  = render_parameters->m_Parameters[i].m_Float;
+                if (input->m_Buffer == 0x0)
+                {
+                    continue;
+                }
+                if (!IsMixerGainFlat(gain, filtered_gains[i]))
+                {
+                    MixAddRamp(kernels, tile, input, tile_offset, tile_frame_count, channel_count, gain, filtered_gains[i]);
+                    continue;
+                }
+                filtered_gains[i] = gain;
+                if (gain == 0.f)
+                {
+                    continue;
+                }
+                if (input->m_IsConstant)
+                {
+                    MixAddConstant(tile, input->m_Buffer, tile_frame_count, channel_count, input->m_ChannelCount, gain);
+                }
+                else if (input->m_ChannelCount == channel_count)
+                {
+                    kernels.m_Add(tile, &input->m_Buffer[tile_offset * channel_count], (uint32_t)tile_frame_count * channel_count, gain);
+                }
+                else
+                {
+                    kernels.m_AddMono(tile, &input->m_Buffer[tile_offset], tile_frame_count, channel_count, gain);
+                }
+            }
+        }
+    }
+}
+
+#define SOGO_MIXER_GAIN(tens, ones) { "Gain" #tens #ones, 1.f }
+#define SOGO_MIXER_GAINS(tens)                                                                          \
+    SOGO_MIXER_GAIN(tens, 0), SOGO_MIXER_GAIN(tens, 1), SOGO_MIXER_GAIN(tens, 2), SOGO_MIXER_GAIN(tens, 3), \
+        SOGO_MIXER_GAIN(tens, 4), SOGO_MIXER_GAIN(tens, 5), SOGO_MIXER_GAIN(tens, 6),                   \
+        SOGO_MIXER_GAIN(tens, 7), SOGO_MIXER_GAIN(tens, 8), SOGO_MIXER_GAIN(tens, 9)
+
+// "Gain0" to "Gain63"
+static const ParameterDescription MixerParameters[MIXER_MAX_INPUT_COUNT] = {
+    SOGO_MIXER_GAINS(),
+    SOGO_MIXER_GAINS(1),
+    SOGO_MIXER_GAINS(2),
+    SOGO_MIXER_GAINS(3),
+    SOGO_MIXER_GAINS(4),
+    SOGO_MIXER_GAINS(5),
+    SOGO_MIXER_GAIN(6, 0),
+    SOGO_MIXER_GAIN(6, 1),
+    SOGO_MIXER_GAIN(6, 2),
+    SOGO_MIXER_GAIN(6, 3)
+};
+
+#undef SOGO_MIXER_GAINS
+#undef SOGO_MIXER_GAIN
+
+// A single FIXED output, indexed by channel count - 1
+static const AudioOutputDescription FixedAudioOutputDescriptions[MIXER_MAX_CHANNEL_COUNT] = {
+    { AudioOutputDescription::FIXED, { 1 } },
+    { AudioOutputDescription::FIXED, { 2 } },
+    { AudioOutputDescription::FIXED, { 3 } },
+    { AudioOutputDescription::FIXED, { 4 } },
+    { AudioOutputDescription::FIXED, { 5 } },
+    { AudioOutputDescription::FIXED, { 6 } },
+    { AudioOutputDescription::FIXED, { 7 } },
+    { AudioOutputDescription::FIXED, { 8 } }
+};
+
+// The filtered gains start at the initial value of the "Gain<n>" parameters
+static void InitMixer(HGraph, HNode, const GraphRuntimeSettings*, TParameter, void* context_memory)
+{
+    MixerContext* context = (MixerContext*)context_memory;
+    for (TAudioSocketIndex i = 0; i < MIXER_MAX_INPUT_COUNT; ++i)
+    {
+        context->m_FilteredGains[i] = MixerParameters[i].m_InitialValue.m_Float;
+    }
+}
+
+static void MixerNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitMixer;
+    out_node_runtime_desc->m_RenderCallback    = RenderMixer;
+    out_node_runtime_desc->m_ContextMemorySize = sizeof(MixerContext);
+}
+
+bool MakeMixerNodeDesc(TAudioSocketIndex input_count, TChannelIndex channel_count, NodeStaticDescription* out_node_static_description)
+{
+    if (input_count == 0 || input_count > MIXER_MAX_INPUT_COUNT || channel_count == 0 || channel_count > MIXER_MAX_CHANNEL_COUNT)
+    {
+        return false;
+    }
+    out_node_static_description->m_GetNodeRuntimeDescCallback = MixerNodeGetNodeRuntimeDescCallback;
+    out_node_static_description->m_ParameterDescriptions      = MixerParameters;
+    out_node_static_description->m_AudioOutputDescriptions    = &FixedAudioOutputDescriptions[channel_count - 1];
+    out_node_static_description->m_Triggers                   = 0x0;
+    out_node_static_description->m_AudioInputCount            = input_count;
+    out_node_static_description->m_AudioOutputCount           = SOGO_MIXER_AUDIO_OUTPUT_COUNT;
+    out_node_static_description->m_ResourceCount              = 0;
+    out_node_static_description->m_ParameterCount             = input_count;
+    out_node_static_description->m_TriggerInputCount          = 0;
+    out_node_static_description->m_TriggerOutputCount         = 0;
+    out_node_static_description->m_Flags                      = NODE_FLAG_SILENT_IN_SILENT_OUT | NODE_FLAG_CONSTANT_INPUTS | NODE_FLAG_MONO_OR_MATCHING_INPUTS;
+    out_node_static_description->m_UserData.m_Int             = 0;
+    return true;
+}
+
+///////////////////// SOGO CHANNEL MATRIX
+
+enum SOGO_CHANNEL_MATRIX_RESOURCES
+{
+    SOGO_CHANNEL_MATRIX_RESOURCE_MATRIX,
+    SOGO_CHANNEL_MATRIX_RESOURCE_COUNT
+};
+
+enum SOGO_CHANNEL_MATRIX_AUDIO_INPUTS
+{
+    SOGO_CHANNEL_MATRIX_AUDIO_INPUT,
+    SOGO_CHANNEL_MATRIX_AUDIO_INPUT_COUNT
+};
+
+enum SOGO_CHANNEL_MATRIX_AUDIO_OUTPUTS
+{
+    SOGO_CHANNEL_MATRIX_AUDIO_OUTPUT,
+    SOGO_CHANNEL_MATRIX_AUDIO_OUTPUT_COUNT
+};
+
+enum Speaker
+{
+    SPEAKER_L,
+    SPEAKER_R,
+    SPEAKER_C,
+    SPEAKER_LFE,
+    SPEAKER_LB,
+    SPEAKER_RB,
+    SPEAKER_LS,
+    SPEAKER_RS,
+    SPEAKER_NONE
+};
+
+static const uint8_t MonoSpeakers[1]     = { SPEAKER_C };
+static const uint8_t StereoSpeakers[2]   = { SPEAKER_L, SPEAKER_R };
+static const uint8_t QuadSpeakers[4]     = { SPEAKER_L, SPEAKER_R, SPEAKER_LB, SPEAKER_RB };
+static const uint8_t Surround51Speakers[6] = { SPEAKER_L, SPEAKER_R, SPEAKER_C, SPEAKER_LFE, SPEAKER_LS, SPEAKER_RS };
+static const uint8_t Surround71Speakers[8] = { SPEAKER_L, SPEAKER_R, SPEAKER_C, SPEAKER_LFE, SPEAKER_LB, SPEAKER_RB, SPEAKER_LS, SPEAKER_RS };
+
+static const uint8_t* GetSpeakers(TChannelIndex channel_count)
+{
+    switch (channel_count)
+    {
+        case 1:
+            return MonoSpeakers;
+        case 2:
+            return StereoSpeakers;
+        case 4:
+            return QuadSpeakers;
+        case 6:
+            return Surround51Speakers;
+        case 8:
+            return Surround71Speakers;
+        default:
+            return 0x0;
+    }
+}
+
+static TChannelIndex FindSpeaker(const uint8_t* speakers, TChannelIndex channel_count, uint8_t speaker)
+{
+    for (TChannelIndex c = 0; c < channel_count; ++c)
+    {
+        if (speakers[c] == speaker)
+        {
+            return c;
+        }
+    }
+    return CHANNEL_MATRIX_MAX_CHANNEL_COUNT;
+}
+
+// Adds the input speaker to the output, a speaker the output does not have goes to the speakers
+// next to it: back and side surrounds stand in for each other, center and surrounds fold into
+// front left and right at -3 dB and LFE is dropped. A mono input plays on both front speakers
+// at full level, like ToStereo.
+static void AddSpeaker(uint8_t speaker, bool is_mono, TChannelIndex input_channel, TChannelIndex input_channel_count, const uint8_t* output_speakers, TChannelIndex output_channel_count, float* out_matrix)
+{
+    static const float minus_3db = 0.70710678f;
+
+    TChannelIndex output_channel = FindSpeaker(output_speakers, output_channel_count, speaker);
+    if (output_channel < output_channel_count)
+    {
+        out_matrix[output_channel * input_channel_count + input_channel] += 1.f;
+        return;
+    }
+    uint8_t left_speaker  = SPEAKER_L;
+    uint8_t right_speaker = SPEAKER_R;
+    float   level         = is_mono ? 1.f : minus_3db;
+    switch (speaker)
+    {
+        case SPEAKER_LFE:
+            return;
+        case SPEAKER_LB:
+        case SPEAKER_LS:
+        case SPEAKER_RB:
+        case SPEAKER_RS:
+        {
+            bool    is_left  = speaker == SPEAKER_LB || speaker == SPEAKER_LS;
+            uint8_t neighbour = (speaker == SPEAKER_LB) ? SPEAKER_LS : (speaker == SPEAKER_LS) ? SPEAKER_LB : (speaker == SPEAKER_RB) ? SPEAKER_RS : SPEAKER_RB;
+            output_channel    = FindSpeaker(output_speakers, output_channel_count, neighbour);
+            if (output_channel < output_channel_count)
+            {
+                out_matrix[output_channel * input_channel_count + input_channel] += 1.f;
+                return;
+            }
+            left_speaker  = is_left ? SPEAKER_L : SPEAKER_NONE;
+            right_speaker = is_left ? SPEAKER_NONE : SPEAKER_R;
+            break;
+        }
+        default:
+            break;
+    }
+    TChannelIndex left_channel  = FindSpeaker(output_speakers, output_channel_count, left_speaker);
+    TChannelIndex right_channel = FindSpeaker(output_speakers, output_channel_count, right_speaker);
+    if (left_channel < output_channel_count)
+    {
+        out_matrix[left_channel * input_channel_count + input_channel] += level;
+    }
+    if (right_channel < output_channel_count)
+    {
+        out_matrix[right_channel * input_channel_count + input_channel] += level;
+    }
+}
+
+bool GetStandardChannelMatrix(TChannelIndex input_channel_count, TChannelIndex output_channel_count, float* out_matrix)
+{
+    const uint8_t* input_speakers  = GetSpeakers(input_channel_count);
+    const uint8_t* output_speakers = GetSpeakers(output_channel_count);
+    if (input_speakers == 0x0 || output_speakers == 0x0)
+    {
+        return false;
+    }
+    memset(out_matrix, 0, sizeof(float) * input_channel_count * output_channel_count);
+    if (output_channel_count == 1 && input_channel_count > 1)
+    {
+        // The average of the stereo down mix
+        float stereo_matrix[2 * CHANNEL_MATRIX_MAX_CHANNEL_COUNT];
+        GetStandardChannelMatrix(input_channel_count, 2, stereo_matrix);
+        for (TChannelIndex i = 0; i < input_channel_count; ++i)
+        {
+            out_matrix[i] = 0.5f * (stereo_matrix[i] + stereo_matrix[input_channel_count + i]);
+        }
+        return true;
+    }
+    for (TChannelIndex i = 0; i < input_channel_count; ++i)
+    {
+        AddSpeaker(input_speakers[i], input_channel_count == 1, i, input_channel_count, output_speakers, output_channel_count, out_matrix);
+    }
+    return true;
+}
+
+// The non zero coefficients of a channel matrix
+struct ChannelMatrix
+{
+    TChannelIndex m_InputChannelCount;
+    TChannelIndex m_OutputChannelCount;
+    TChannelIndex m_UsedInputCount; // Input channels with a non zero coefficient for any output channel
+    TChannelIndex m_UsedInputs[CHANNEL_MATRIX_MAX_CHANNEL_COUNT];
+    TChannelIndex m_TermCounts[CHANNEL_MATRIX_MAX_CHANNEL_COUNT]; // Non zero coefficients of each output channel
+    TChannelIndex m_TermInputs[CHANNEL_MATRIX_MAX_CHANNEL_COUNT][CHANNEL_MATRIX_MAX_CHANNEL_COUNT];
+    float         m_Coefficients[CHANNEL_MATRIX_MAX_CHANNEL_COUNT * CHANNEL_MATRIX_MAX_CHANNEL_COUNT]; // Row o is output channel o
+    bool          m_IsIdentity;
+};
+
+static void MakeChannelMatrix(TChannelIndex input_channel_count, TChannelIndex output_channel_count, const float* coefficients, ChannelMatrix* out_matrix)
+{
+    out_matrix->m_InputChannelCount  = input_channel_count;
+    out_matrix->m_OutputChannelCount = output_channel_count;
+    out_matrix->m_UsedInputCount     = 0;
+    out_matrix->m_IsIdentity         = input_channel_count == output_channel_count;
+    memcpy(out_matrix->m_Coefficients, coefficients, sizeof(float) * input_channel_count * output_channel_count);
+    bool is_used[CHANNEL_MATRIX_MAX_CHANNEL_COUNT] = { false };
+    for (TChannelIndex o = 0; o < output_channel_count; ++o)
+    {
+        out_matrix->m_TermCounts[o] = 0;
+        for (TChannelIndex i = 0; i < input_channel_count; ++i)
+        {
+            float coefficient = coefficients[o * input_channel_count + i];
+            out_matrix->m_IsIdentity &= coefficient == (o == i ? 1.f : 0.f);
+            if (coefficient != 0.f)
+            {
+                out_matrix->m_TermInputs[o][out_matrix->m_TermCounts[o]++] = i;
+                is_used[i]                                                  = true;
+            }
+        }
+    }
+    for (TChannelIndex i = 0; i < input_channel_count; ++i)
+    {
+        if (is_used[i])
+        {
+            out_matrix->m_UsedInputs[out_matrix->m_UsedInputCount++] = i;
+        }
+    }
+}
+
+static void ChannelMatrixScalar(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix)
+{
+    TChannelIndex input_channel_count  = matrix->m_InputChannelCount;
+    TChannelIndex output_channel_count = matrix->m_OutputChannelCount;
+    while (frame_count--)
+    {
+        for (TChannelIndex o = 0; o < output_channel_count; ++o)
+        {
+            const float* row = &matrix->m_Coefficients[o * input_channel_count];
+            float        sum = 0.f;
+            for (TChannelIndex t = 0; t < matrix->m_TermCounts[o]; ++t)
+            {
+                TChannelIndex i = matrix->m_TermInputs[o][t];
+                sum += input[i] * row[i];
+            }
+            *output++ = sum;
+        }
+        input += input_channel_count;
+    }
+}
+
+#if SOGO_SIMD_X86
+// One input channel to any number of output channels, each frame is the input sample times the
+// coefficient column. Stereo output unpacks four mono frames at a time.
+static void ChannelMatrixUpmixMonoSSE2(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix)
+{
+    TChannelIndex output_channel_count = matrix->m_OutputChannelCount;
+    TFrameIndex   frame                = 0;
+    if (output_channel_count == 2)
+    {
+        __m128 coefficients = _mm_setr_ps(matrix->m_Coefficients[0], matrix->m_Coefficients[1], matrix->m_Coefficients[0], matrix->m_Coefficients[1]);
+        for (; frame + 4 <= frame_count; frame += 4)
+        {
+            __m128 mono = _mm_loadu_ps(&input[frame]);
+            _mm_storeu_ps(&output[frame * 2], _mm_mul_ps(_mm_unpacklo_ps(mono, mono), coefficients));
+            _mm_storeu_ps(&output[frame * 2 + 4], _mm_mul_ps(_mm_unpackhi_ps(mono, mono), coefficients));
+        }
+    }
+    else if (output_channel_count >= 4)
+    {
+        TChannelIndex vector_channel_count = output_channel_count & ~3;
+        for (; frame < frame_count; ++frame)
+        {
+            __m128 sample = _mm_set1_ps(input[frame]);
+            float* out    = &output[frame * output_channel_count];
+            for (TChannelIndex o = 0; o < vector_channel_count; o += 4)
+            {
+                _mm_storeu_ps(&out[o], _mm_mul_ps(sample, _mm_loadu_ps(&matrix->m_Coefficients[o])));
+            }
+            for (TChannelIndex o = vector_channel_count; o < output_channel_count; ++o)
+            {
+                out[o] = input[frame] * matrix->m_Coefficients[o];
+            }
+        }
+    }
+    ChannelMatrixScalar(&output[frame * output_channel_count], &input[frame], frame_count - frame, matrix);
+}
+
+// Any number of input channels to one or two output channels. Four frames of each used input
+// channel are gathered into a vector so both output channels are accumulated four frames at a time.
+static void ChannelMatrixDownmixSSE2(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix)
+{
+    TChannelIndex input_channel_count  = matrix->m_InputChannelCount;
+    TChannelIndex output_channel_count = matrix->m_OutputChannelCount;
+    TFrameIndex   frame                = 0;
+    for (; frame + 4 <= frame_count; frame += 4)
+    {
+        const float* in    = &input[frame * input_channel_count];
+        __m128       left  = _mm_setzero_ps();
+        __m128       right = _mm_setzero_ps();
+        for (TChannelIndex u = 0; u < matrix->m_UsedInputCount; ++u)
+        {
+            TChannelIndex i       = matrix->m_UsedInputs[u];
+            __m128        samples = _mm_setr_ps(in[i], in[input_channel_count + i], in[input_channel_count * 2 + i], in[input_channel_count * 3 + i]);
+            left                  = _mm_add_ps(left, _mm_mul_ps(samples, _mm_set1_ps(matrix->m_Coefficients[i])));
+            if (output_channel_count == 2)
+            {
+                right = _mm_add_ps(right, _mm_mul_ps(samples, _mm_set1_ps(matrix->m_Coefficients[input_channel_count + i])));
+            }
+        }
+        if (output_channel_count == 2)
+        {
+            _mm_storeu_ps(&output[frame * 2], _mm_unpacklo_ps(left, right));
+            _mm_storeu_ps(&output[frame * 2 + 4], _mm_unpackhi_ps(left, right));
+        }
+        else
+        {
+            _mm_storeu_ps(&output[frame], left);
+        }
+    }
+    ChannelMatrixScalar(&output[frame * output_channel_count], &input[frame * input_channel_count], frame_count - frame, matrix);
+}
+
+SOGO_TARGET_AVX2 static void ChannelMatrixUpmixMonoAVX2(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix)
+{
+    if (matrix->m_OutputChannelCount != 8)
+    {
+        ChannelMatrixUpmixMonoSSE2(output, input, frame_count, matrix);
+        return;
+    }
+    __m256 coefficients = _mm256_loadu_ps(matrix->m_Coefficients);
+    for (TFrameIndex frame = 0; frame < frame_count; ++frame)
+    {
+        _mm256_storeu_ps(&output[frame * 8], _mm256_mul_ps(_mm256_set1_ps(input[frame]), coefficients));
+    }
+}
+
+// Gathers eight frames of each used input channel
+SOGO_TARGET_AVX2 static void ChannelMatrixDownmixAVX2(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix)
+{
+    TChannelIndex input_channel_count  = matrix->m_InputChannelCount;
+    TChannelIndex output_channel_count = matrix->m_OutputChannelCount;
+    __m256i       frame_offsets        = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(input_channel_count));
+    TFrameIndex   frame                = 0;
+    for (; frame + 8 <= frame_count; frame += 8)
+    {
+        const float* in    = &input[frame * input_channel_count];
+        __m256       left  = _mm256_setzero_ps();
+        __m256       right = _mm256_setzero_ps();
+        for (TChannelIndex u = 0; u < matrix->m_UsedInputCount; ++u)
+        {
+            TChannelIndex i       = matrix->m_UsedInputs[u];
+            __m256        samples = _mm256_i32gather_ps(&in[i], frame_offsets, 4);
+            left                  = _mm256_add_ps(left, _mm256_mul_ps(samples, _mm256_set1_ps(matrix->m_Coefficients[i])));
+            if (output_channel_count == 2)
+            {
+                right = _mm256_add_ps(right, _mm256_mul_ps(samples, _mm256_set1_ps(matrix->m_Coefficients[input_channel_count + i])));
+            }
+        }
+        if (output_channel_count == 2)
+        {
+            __m256 low  = _mm256_unpacklo_ps(left, right);
+            __m256 high = _mm256_unpackhi_ps(left, right);
+            _mm256_storeu_ps(&output[frame * 2], _mm256_permute2f128_ps(low, high, 0x20));
+            _mm256_storeu_ps(&output[frame * 2 + 8], _mm256_permute2f128_ps(low, high, 0x31));
+        }
+        else
+        {
+            _mm256_storeu_ps(&output[frame], left);
+        }
+    }
+    ChannelMatrixScalar(&output[frame * output_channel_count], &input[frame * input_channel_count], frame_count - frame, matrix);
+}
+#endif
+
+struct ChannelMatrixKernels
+{
+    void (*m_UpmixMono)(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix);
+    void (*m_Downmix)(float* output, const float* input, TFrameIndex frame_count, const ChannelMatrix* matrix); // One or two output channels
+};
+
+static ChannelMatrixKernels GetChannelMatrixKernels(SimdLevel simd_level)
+{
+    ChannelMatrixKernels kernels = { ChannelMatrixScalar, ChannelMatrixScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_UpmixMono = ChannelMatrixUpmixMonoAVX2;
+        kernels.m_Downmix   = ChannelMatrixDownmixAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_UpmixMono = ChannelMatrixUpmixMonoSSE2;
+        kernels.m_Downmix   = ChannelMatrixDownmixSSE2;
+    }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
+
+static const ChannelMatrixKernels& GetChannelMatrixKernels()
+{
+    static const ChannelMatrixKernels kernels = GetChannelMatrixKernels(GetSimdLevel());
+    return kernels;
+}
+
+static void RenderChannelMatrix(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    const AudioOutput* input_data           = render_parameters->m_AudioInputs[SOGO_CHANNEL_MATRIX_AUDIO_INPUT].m_AudioOutput;
+    AudioOutput*       output_data          = &render_parameters->m_AudioOutputs[SOGO_CHANNEL_MATRIX_AUDIO_OUTPUT];
+    TChannelIndex      input_channel_count  = input_data->m_ChannelCount;
+    TChannelIndex      output_channel_count = output_data->m_ChannelCount;
+    output_data->m_Buffer                   = 0x0;
+    if (input_data->m_Buffer == 0x0 || input_channel_count == 0 || input_channel_count > CHANNEL_MATRIX_MAX_CHANNEL_COUNT)
+    {
+        return;
+    }
+
+    float           coefficients[CHANNEL_MATRIX_MAX_CHANNEL_COUNT * CHANNEL_MATRIX_MAX_CHANNEL_COUNT];
+    const Resource* resource = &render_parameters->m_Resources[SOGO_CHANNEL_MATRIX_RESOURCE_MATRIX];
+    if (resource->m_Data != 0x0)
+    {
+        if (resource->m_Size != sizeof(float) * input_channel_count * output_channel_count)
+        {
+            return;
+        }
+        memcpy(coefficients, resource->m_Data, resource->m_Size);
+    }
+    else if (!GetStandardChannelMatrix(input_channel_count, output_channel_count, coefficients))
+    {
+        return;
+    }
+
+    ChannelMatrix matrix;
+    MakeChannelMatrix(input_channel_count, output_channel_count, coefficients, &matrix);
+    if (matrix.m_UsedInputCount == 0)
+    {
+        return;
+    }
+
+    TFrameIndex frame_count = render_parameters->m_FrameCount;
+    float*      output      = render_parameters->m_AllocateAudioBuffer(graph, node, output_channel_count, frame_count);
+    output_data->m_Buffer   = output;
+    if (output == 0x0)
+    {
+        return;
+    }
+
+    if (input_data->m_IsConstant)
+    {
+        frame_count               = 1;
+        output_data->m_IsConstant = true;
+    }
+
+    const ChannelMatrixKernels& kernels = GetChannelMatrixKernels();
+    if (matrix.m_IsIdentity)
+    {
+        memcpy(output, input_data->m_Buffer, sizeof(float) * frame_count * output_channel_count);
+    }
+    else if (input_channel_count == 1)
+    {
+        kernels.m_UpmixMono(output, input_data->m_Buffer, frame_count, &matrix);
+    }
+    else if (output_channel_count <= 2)
+    {
+        kernels.m_Downmix(output, input_data->m_Buffer, frame_count, &matrix);
+    }
+    else
+    {
+        ChannelMatrixScalar(output, input_data->m_Buffer, frame_count, &matrix);
+    }
+}
+
+static void ChannelMatrixNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = RenderChannelMatrix;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+bool MakeChannelMatrixNodeDesc(TChannelIndex output_channel_count, NodeStaticDescription* out_node_static_description)
+{
+    if (output_channel_count == 0 || output_channel_count > CHANNEL_MATRIX_MAX_CHANNEL_COUNT)
+    {
+        return false;
+    }
+    out_node_static_description->m_GetNodeRuntimeDescCallback = ChannelMatrixNodeGetNodeRuntimeDescCallback;
+    out_node_static_description->m_ParameterDescriptions      = 0x0;
+    out_node_static_description->m_AudioOutputDescriptions    = &FixedAudioOutputDescriptions[output_channel_count - 1];
+    out_node_static_description->m_Triggers                   = 0x0;
+    out_node_static_description->m_AudioInputCount            = SOGO_CHANNEL_MATRIX_AUDIO_INPUT_COUNT;
+    out_node_static_description->m_AudioOutputCount           = SOGO_CHANNEL_MATRIX_AUDIO_OUTPUT_COUNT;
+    out_node_static_description->m_ResourceCount              = SOGO_CHANNEL_MATRIX_RESOURCE_COUNT;
+    out_node_static_description->m_ParameterCount             = 0;
+    out_node_static_description->m_TriggerInputCount          = 0;
+    out_node_static_description->m_TriggerOutputCount         = 0;
+    out_node_static_description->m_Flags                      = NODE_FLAG_SILENT_IN_SILENT_OUT | NODE_FLAG_CONSTANT_INPUTS;
+    out_node_static_description->m_UserData.m_Int             = 0;
+    return true;
+}
+
+///////////////////// SOGO BIQUAD
+
+enum SOGO_BIQUAD_PARAMETERS
+{
+    SOGO_BIQUAD_PARAMETER_TYPE_INDEX,
+    SOGO_BIQUAD_PARAMETER_FREQUENCY_INDEX,
+    SOGO_BIQUAD_PARAMETER_Q_INDEX,
+    SOGO_BIQUAD_PARAMETER_GAIN_INDEX,
+    SOGO_BIQUAD_PARAMETER_STAGE_COUNT_INDEX,
+    SOGO_BIQUAD_PARAMETER_COUNT
+};
+
+enum SOGO_BIQUAD_AUDIO_INPUTS
+{
+    SOGO_BIQUAD_AUDIO_INPUT,
+    SOGO_BIQUAD_AUDIO_INPUT_COUNT
+};
+
+enum SOGO_BIQUAD_AUDIO_OUTPUTS
+{
+    SOGO_BIQUAD_AUDIO_OUTPUT,
+    SOGO_BIQUAD_AUDIO_OUTPUT_COUNT
+};
+
+enum SOGO_BIQUAD_COEFFICIENTS
+{
+    SOGO_BIQUAD_B0,
+    SOGO_BIQUAD_B1,
+    SOGO_BIQUAD_B2,
+    SOGO_BIQUAD_A1,
+    SOGO_BIQUAD_A2,
+    SOGO_BIQUAD_COEFFICIENT_COUNT
+};
+
+struct BiquadContext
+{
+    TParameter m_Parameters[SOGO_BIQUAD_PARAMETER_STAGE_COUNT_INDEX]; // The parameters m_Coefficients were computed from
+    bool       m_HasCoefficients;
+    bool       m_HasState;
+    float      m_Coefficients[SOGO_BIQUAD_COEFFICIENT_COUNT]; // Normalized so a0 is 1
+    float      m_State[BIQUAD_MAX_STAGE_COUNT][2][BIQUAD_MAX_CHANNEL_COUNT];
+};
+
+// Audio EQ cookbook coefficients, the frequency is kept below Nyquist
+static void GetBiquadCoefficients(const TParameter* parameters, TFrameRate frame_rate, float* out_coefficients)
+{
+    static const double pi = 3.14159265358979323846;
+
+    double frequency = parameters[SOGO_BIQUAD_PARAMETER_FREQUENCY_INDEX].m_Float;
+    double q         = parameters[SOGO_BIQUAD_PARAMETER_Q_INDEX].m_Float;
+    frequency        = frequency < 1.0 ? 1.0 : (frequency > frame_rate * 0.49 ? frame_rate * 0.49 : frequency);
+    q                = q < 0.01 ? 0.01 : q;
+
+    double w0     = 2.0 * pi * frequency / frame_rate;
+    double cos_w0 = cos(w0);
+    double alpha  = sin(w0) / (2.0 * q);
+    double a      = pow(10.0, parameters[SOGO_BIQUAD_PARAMETER_GAIN_INDEX].m_Float / 40.0);
+    double sqrt_a = 2.0 * sqrt(a) * alpha;
+    double b0, b1, b2, a0, a1, a2;
+    switch (parameters[SOGO_BIQUAD_PARAMETER_TYPE_INDEX].m_Int)
+    {
+        case BIQUAD_HIGH_PASS:
+            b0 = (1.0 + cos_w0) / 2.0;
+            b1 = -(1.0 + cos_w0);
+            b2 = b0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cos_w0;
+            a2 = 1.0 - alpha;
+            break;
+        case BIQUAD_BAND_PASS:
+            b0 = alpha;
+            b1 = 0.0;
+            b2 = -alpha;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cos_w0;
+            a2 = 1.0 - alpha;
+            break;
+        case BIQUAD_LOW_SHELF:
+            b0 = a * ((a + 1.0) - (a - 1.0) * cos_w0 + sqrt_a);
+            b1 = 2.0 * a * ((a - 1.0) - (a + 1.0) * cos_w0);
+            b2 = a * ((a + 1.0) - (a - 1.0) * cos_w0 - sqrt_a);
+            a0 = (a + 1.0) + (a - 1.0) * cos_w0 + sqrt_a;
+            a1 = -2.0 * ((a - 1.0) + (a + 1.0) * cos_w0);
+            a2 = (a + 1.0) + (a - 1.0) * cos_w0 - sqrt_a;
+            break;
+        case BIQUAD_HIGH_SHELF:
+            b0 = a * ((a + 1.0) + (a - 1.0) * cos_w0 + sqrt_a);
+            b1 = -2.0 * a * ((a - 1.0) + (a + 1.0) * cos_w0);
+            b2 = a * ((a + 1.0) + (a - 1.0) * cos_w0 - sqrt_a);
+            a0 = (a + 1.0) - (a - 1.0) * cos_w0 + sqrt_a;
+            a1 = 2.0 * ((a - 1.0) - (a + 1.0) * cos_w0);
+            a2 = (a + 1.0) - (a - 1.0) * cos_w0 - sqrt_a;
+            break;
+        case BIQUAD_PEAK:
+            b0 = 1.0 + alpha * a;
+            b1 = -2.0 * cos_w0;
+            b2 = 1.0 - alpha * a;
+            a0 = 1.0 + alpha / a;
+            a1 = -2.0 * cos_w0;
+            a2 = 1.0 - alpha / a;
+            break;
+        case BIQUAD_LOW_PASS:
+        default:
+            b0 = (1.0 - cos_w0) / 2.0;
+            b1 = 1.0 - cos_w0;
+            b2 = b0;
+            a0 = 1.0 + alpha;
+            a1 = -2.0 * cos_w0;
+            a2 = 1.0 - alpha;
+            break;
+    }
+    out_coefficients[SOGO_BIQUAD_B0] = (float)(b0 / a0);
+    out_coefficients[SOGO_BIQUAD_B1] = (float)(b1 / a0);
+    out_coefficients[SOGO_BIQUAD_B2] = (float)(b2 / a0);
+    out_coefficients[SOGO_BIQUAD_A1] = (float)(a1 / a0);
+    out_coefficients[SOGO_BIQUAD_A2] = (float)(a2 / a0);
+}
+
+// Transposed direct form II, every stage uses the same coefficients. The state is
+// state[stage][0 or 1][channel] and the output may be the input buffer.
+static void BiquadScalar(float* output, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, uint32_t stage_count, const float* coefficients, float* state)
+{
+    float b0 = coefficients[SOGO_BIQUAD_B0];
+    float b1 = coefficients[SOGO_BIQUAD_B1];
+    float b2 = coefficients[SOGO_BIQUAD_B2];
+    float a1 = coefficients[SOGO_BIQUAD_A1];
+    float a2 = coefficients[SOGO_BIQUAD_A2];
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            float x = input[f * channel_count + c];
+            for (uint32_t s = 0; s < stage_count; ++s)
+            {
+                float* z = &state[s * 2 * BIQUAD_MAX_CHANNEL_COUNT];
+                float  y = b0 * x + z[c];
+                z[c]     = b1 * x - a1 * y + z[BIQUAD_MAX_CHANNEL_COUNT + c];
+                z[BIQUAD_MAX_CHANNEL_COUNT + c] = b2 * x - a2 * y;
+                x        = y;
+            }
+            output[f * channel_count + c] = x;
+        }
+    }
+}
+
+#if SOGO_SIMD_X86
+// Each channel is a lane, one or two vectors of four channels per frame. Frames with a channel
+// count that is not a multiple of four go through a zero padded copy.
+static void BiquadSSE2(float* output, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, uint32_t stage_count, const float* coefficients, float* state)
+{
+    __m128   b0           = _mm_set1_ps(coefficients[SOGO_BIQUAD_B0]);
+    __m128   b1           = _mm_set1_ps(coefficients[SOGO_BIQUAD_B1]);
+    __m128   b2           = _mm_set1_ps(coefficients[SOGO_BIQUAD_B2]);
+    __m128   a1           = _mm_set1_ps(coefficients[SOGO_BIQUAD_A1]);
+    __m128   a2           = _mm_set1_ps(coefficients[SOGO_BIQUAD_A2]);
+    uint32_t vector_count = (channel_count + 3u) / 4u;
+    bool     is_padded    = (channel_count & 3) != 0;
+
+    __m128 z1[BIQUAD_MAX_STAGE_COUNT][2];
+    __m128 z2[BIQUAD_MAX_STAGE_COUNT][2];
+    for (uint32_t s = 0; s < stage_count; ++s)
+    {
+        for (uint32_t v = 0; v < vector_count; ++v)
+        {
+            z1[s][v] = _mm_loadu_ps(&state[s * 2 * BIQUAD_MAX_CHANNEL_COUNT + v * 4]);
+            z2[s][v] = _mm_loadu_ps(&state[(s * 2 + 1) * BIQUAD_MAX_CHANNEL_COUNT + v * 4]);
+        }
+    }
+
+    float frame[BIQUAD_MAX_CHANNEL_COUNT] = { 0.f };
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        const float* in  = &input[f * channel_count];
+        float*       out = &output[f * channel_count];
+        if (is_padded)
+        {
+            for (TChannelIndex c = 0; c < channel_count; ++c)
+            {
+                frame[c] = in[c];
+            }
+            in  = frame;
+            out = frame;
+        }
+        for (uint32_t v = 0; v < vector_count; ++v)
+        {
+            __m128 x = _mm_loadu_ps(&in[v * 4]);
+            for (uint32_t s = 0; s < stage_count; ++s)
+            {
+                __m128 y = _mm_add_ps(_mm_mul_ps(b0, x), z1[s][v]);
+                z1[s][v] = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, x), _mm_mul_ps(a1, y)), z2[s][v]);
+                z2[s][v] = _mm_sub_ps(_mm_mul_ps(b2, x), _mm_mul_ps(a2, y));
+                x        = y;
+            }
+            _mm_storeu_ps(&out[v * 4], x);
+        }
+        if (is_padded)
+        {
+            for (TChannelIndex c = 0; c < channel_count; ++c)
+            {
+                output[f * channel_count + c] = frame[c];
+            }
+        }
+    }
+
+    for (uint32_t s = 0; s < stage_count; ++s)
+    {
+        for (uint32_t v = 0; v < vector_count; ++v)
+        {
+            _mm_storeu_ps(&state[s * 2 * BIQUAD_MAX_CHANNEL_COUNT + v * 4], z1[s][v]);
+            _mm_storeu_ps(&state[(s * 2 + 1) * BIQUAD_MAX_CHANNEL_COUNT + v * 4], z2[s][v]);
+        }
+    }
+}
+
+// Five to eight channels in a single vector
+SOGO_TARGET_AVX2 static void BiquadAVX2(float* output, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, uint32_t stage_count, const float* coefficients, float* state)
+{
+    if (channel_count <= 4)
+    {
+        BiquadSSE2(output, input, frame_count, channel_count, stage_count, coefficients, state);
+        return;
+    }
+    __m256 b0        = _mm256_set1_ps(coefficients[SOGO_BIQUAD_B0]);
+    __m256 b1        = _mm256_set1_ps(coefficients[SOGO_BIQUAD_B1]);
+    __m256 b2        = _mm256_set1_ps(coefficients[SOGO_BIQUAD_B2]);
+    __m256 a1        = _mm256_set1_ps(coefficients[SOGO_BIQUAD_A1]);
+    __m256 a2        = _mm256_set1_ps(coefficients[SOGO_BIQUAD_A2]);
+    bool   is_padded = channel_count != 8;
+
+    __m256 z1[BIQUAD_MAX_STAGE_COUNT];
+    __m256 z2[BIQUAD_MAX_STAGE_COUNT];
+    for (uint32_t s = 0; s < stage_count; ++s)
+    {
+        z1[s] = _mm256_loadu_ps(&state[s * 2 * BIQUAD_MAX_CHANNEL_COUNT]);
+        z2[s] = _mm256_loadu_ps(&state[(s * 2 + 1) * BIQUAD_MAX_CHANNEL_COUNT]);
+    }
+
+    float frame[BIQUAD_MAX_CHANNEL_COUNT] = { 0.f };
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        const float* in  = &input[f * channel_count];
+        float*       out = &output[f * channel_count];
+        if (is_padded)
+        {
+            for (TChannelIndex c = 0; c < channel_count; ++c)
+            {
+                frame[c] = in[c];
+            }
+            in  = frame;
+            out = frame;
+        }
+        __m256 x = _mm256_loadu_ps(in);
+        for (uint32_t s = 0; s < stage_count; ++s)
+        {
+            __m256 y = _mm256_add_ps(_mm256_mul_ps(b0, x), z1[s]);
+            z1[s]    = _mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(b1, x), _mm256_mul_ps(a1, y)), z2[s]);
+            z2[s]    = _mm256_sub_ps(_mm256_mul_ps(b2, x), _mm256_mul_ps(a2, y));
+            x        = y;
+        }
+        _mm256_storeu_ps(out, x);
+        if (is_padded)
+        {
+            for (TChannelIndex c = 0; c < channel_count; ++c)
+            {
+                output[f * channel_count + c] = frame[c];
+            }
+        }
+    }
+
+    for (uint32_t s = 0; s < stage_count; ++s)
+    {
+        _mm256_storeu_ps(&state[s * 2 * BIQUAD_MAX_CHANNEL_COUNT], z1[s]);
+        _mm256_storeu_ps(&state[(s * 2 + 1) * BIQUAD_MAX_CHANNEL_COUNT], z2[s]);
+    }
+}
+#endif
+
+struct BiquadKernels
+{
+    void (*m_Process)(float* output, const float* input, TFrameIndex frame_count, TChannelIndex channel_count, uint32_t stage_count, const float* coefficients, float* state);
+};
+
+static BiquadKernels GetBiquadKernels(SimdLevel simd_level)
+{
+    BiquadKernels kernels = { BiquadScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_Process = BiquadAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_Process = BiquadSSE2;
+    }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
+
+static const BiquadKernels& GetBiquadKernels()
+{
+    static const BiquadKernels kernels = GetBiquadKernels(GetSimdLevel());
+    return kernels;
+}
+
+static void InitBiquad(HGraph, HNode, const GraphRuntimeSettings*, TParameter, void* context_memory)
+{
+    memset(context_memory, 0, sizeof(BiquadContext));
+}
+
+// The tail has rung out once the output and the state stay below this level
+static const float BIQUAD_QUIET_LEVEL = 1e-6f;
+
+static void RenderBiquad(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    const AudioOutput* input_data      = render_parameters->m_AudioInputs[SOGO_BIQUAD_AUDIO_INPUT].m_AudioOutput;
+    AudioOutput*       output_data     = &render_parameters->m_AudioOutputs[SOGO_BIQUAD_AUDIO_OUTPUT];
+    BiquadContext*     context         = (BiquadContext*)render_parameters->m_ContextMemory;
+    TChannelIndex      channel_count   = output_data->m_ChannelCount;
+    TFrameIndex        frame_count     = render_parameters->m_FrameCount;
+    bool               is_input_silent = input_data->m_Buffer == 0x0;
+    if ((is_input_silent && !context->m_HasState) || channel_count > BIQUAD_MAX_CHANNEL_COUNT)
+    {
+        output_data->m_Buffer = 0x0;
+        return;
+    }
+    float* output         = render_parameters->m_AllocateAudioBuffer(graph, node, channel_count, frame_count);
+    output_data->m_Buffer = output;
+    if (output == 0x0)
+    {
+        return;
+    }
+
+    int32_t      stage_count_parameter = (int32_t)render_parameters->m_Parameters[SOGO_BIQUAD_PARAMETER_STAGE_COUNT_INDEX].m_Float;
+    uint32_t     stage_count           = stage_count_parameter < 1 ? 1u : (stage_count_parameter > (int32_t)BIQUAD_MAX_STAGE_COUNT ? BIQUAD_MAX_STAGE_COUNT : (uint32_t)stage_count_parameter);
+    float*       state                 = &context->m_State[0][0][0];
+    const float* input                 = input_data->m_Buffer;
+    if (is_input_silent)
+    {
+        // The filter keeps ringing on silence until the tail has decayed
+        memset(output, 0, sizeof(float) * channel_count * frame_count);
+        input = output;
+    }
+    else if (input_data->m_IsConstant)
+    {
+        FillConstant(output, input, channel_count, frame_count);
+        input = output;
+    }
+
+    const BiquadKernels& kernels = GetBiquadKernels();
+    EventIterator        event_iterator;
+    InitEventIterator(&event_iterator, render_parameters);
+    TFrameIndex      sub_block_offset;
+    TFrameIndex      sub_block_count;
+    const NodeEvent* events;
+    TTriggerCount    event_count;
+    while (NextSubBlock(&event_iterator, &sub_block_offset, &sub_block_count, &events, &event_count))
+    {
+        if (!context->m_HasCoefficients || memcmp(context->m_Parameters, render_parameters->m_Parameters, sizeof(context->m_Parameters)) != 0)
+        {
+            memcpy(context->m_Parameters, render_parameters->m_Parameters, sizeof(context->m_Parameters));
+            GetBiquadCoefficients(context->m_Parameters, render_parameters->m_FrameRate, context->m_Coefficients);
+            context->m_HasCoefficients = true;
+        }
+        uint32_t offset = sub_block_offset * channel_count;
+        kernels.m_Process(&output[offset], &input[offset], sub_block_count, channel_count, stage_count, context->m_Coefficients, state);
+    }
+
+    // Decaying state would otherwise end up as denormals
+    float peak = 0.f;
+    for (uint32_t i = 0; i < stage_count * 2 * BIQUAD_MAX_CHANNEL_COUNT; ++i)
+    {
+        if (fabsf(state[i]) < 1e-20f)
+        {
+            state[i] = 0.f;
+        }
+        peak = fabsf(state[i]) > peak ? fabsf(state[i]) : peak;
+    }
+    if (is_input_silent)
+    {
+        for (uint32_t i = 0; i < (uint32_t)channel_count * frame_count; ++i)
+        {
+            peak = fabsf(output[i]) > peak ? fabsf(output[i]) : peak;
+        }
+    }
+    // The state is cleared once the tail is inaudible so the next batch of silence is skipped
+    context->m_HasState = !is_input_silent || peak >= BIQUAD_QUIET_LEVEL;
+    if (!context->m_HasState)
+    {
+        memset(context->m_State, 0, sizeof(context->m_State));
+    }
+}
+
+// The stage count is a hidden parameter with its initial value set by MakeBiquadNodeDesc
+static const ParameterDescription BiquadParameters[BIQUAD_MAX_STAGE_COUNT][SOGO_BIQUAD_PARAMETER_COUNT] = {
+    { { "Type", 0.f }, { "Frequency", 1000.f }, { "Q", 0.70710678f }, { "Gain", 0.f }, { 0x0, 1.f } },
+    { { "Type", 0.f }, { "Frequency", 1000.f }, { "Q", 0.70710678f }, { "Gain", 0.f }, { 0x0, 2.f } },
+    { { "Type", 0.f }, { "Frequency", 1000.f }, { "Q", 0.70710678f }, { "Gain", 0.f }, { 0x0, 3.f } },
+    { { "Type", 0.f }, { "Frequency", 1000.f }, { "Q", 0.70710678f }, { "Gain", 0.f }, { 0x0, 4.f } }
+};
+
+// Not PASS_THROUGH, the tail is rendered into a buffer of its own while the input is silent
+static struct AudioOutputDescription BiquadNodeAudioOutputDescriptions[SOGO_BIQUAD_AUDIO_OUTPUT_COUNT] = {
+    { AudioOutputDescription::AS_INPUT, { 0 } }
+};
+
+static void BiquadNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitBiquad;
+    out_node_runtime_desc->m_RenderCallback    = RenderBiquad;
+    out_node_runtime_desc->m_ContextMemorySize = sizeof(BiquadContext);
+}
+
+bool MakeBiquadNodeDesc(uint32_t stage_count, NodeStaticDescription* out_node_static_description)
+{
+    if (stage_count == 0 || stage_count > BIQUAD_MAX_STAGE_COUNT)
+    {
+        return false;
+    }
+    out_node_static_description->m_GetNodeRuntimeDescCallback = BiquadNodeGetNodeRuntimeDescCallback;
+    out_node_static_description->m_ParameterDescriptions      = BiquadParameters[stage_count - 1];
+    out_node_static_description->m_AudioOutputDescriptions    = BiquadNodeAudioOutputDescriptions;
+    out_node_static_description->m_Triggers                   = 0x0;
+    out_node_static_description->m_AudioInputCount            = SOGO_BIQUAD_AUDIO_INPUT_COUNT;
+    out_node_static_description->m_AudioOutputCount           = SOGO_BIQUAD_AUDIO_OUTPUT_COUNT;
+    out_node_static_description->m_ResourceCount              = 0;
+    out_node_static_description->m_ParameterCount             = SOGO_BIQUAD_PARAMETER_COUNT;
+    out_node_static_description->m_TriggerInputCount          = 0;
+    out_node_static_description->m_TriggerOutputCount         = 0;
+    out_node_static_description->m_Flags                      = NODE_FLAG_CONSTANT_INPUTS;
+    out_node_static_description->m_UserData.m_Int             = 0;
+    return true;
+}
+
+///////////////////// SOGO CONVOLUTION
+
+// Uniformly partitioned overlap save. Every block of CONVOLUTION_PARTITION_FRAME_COUNT input
+// frames is transformed with a real FFT of twice the block size into a frequency domain delay
+// line, multiplied with the spectrum of each partition of the impulse response and transformed
+// back. The spectra are packed in CONVOLUTION_BIN_COUNT complex bins, the real Nyquist bin is
+// stored in the imaginary part of the DC bin.
+static const uint32_t CONVOLUTION_FFT_SIZE  = CONVOLUTION_PARTITION_FRAME_COUNT * 2;
+static const uint32_t CONVOLUTION_BIN_COUNT = CONVOLUTION_PARTITION_FRAME_COUNT;
+
+// Twiddles for the complex FFT of CONVOLUTION_BIN_COUNT points, the stage with span s uses
+// m_Twiddle*[s, 2s). m_Real* is e^(-2 pi i k / CONVOLUTION_FFT_SIZE) for the real FFT.
+struct FFTTables
+{
+    float    m_TwiddleRe[CONVOLUTION_BIN_COUNT];
+    float    m_TwiddleIm[CONVOLUTION_BIN_COUNT];
+    float    m_RealRe[CONVOLUTION_BIN_COUNT];
+    float    m_RealIm[CONVOLUTION_BIN_COUNT];
+    uint16_t m_BitReverse[CONVOLUTION_BIN_COUNT];
+};
+
+static FFTTables MakeFFTTables()
+{
+    static const double pi = 3.14159265358979323846;
+
+    FFTTables tables;
+    tables.m_TwiddleRe[0] = 1.f;
+    tables.m_TwiddleIm[0] = 0.f;
+    for (uint32_t span = 1; span < CONVOLUTION_BIN_COUNT; span *= 2)
+    {
+        for (uint32_t j = 0; j < span; ++j)
+        {
+            tables.m_TwiddleRe[span + j] = (float)cos(-pi * j / span);
+            tables.m_TwiddleIm[span + j] = (float)sin(-pi * j / span);
+        }
+    }
+    uint32_t bit_count = 0;
+    while ((1u << bit_count) < CONVOLUTION_BIN_COUNT)
+    {
+        ++bit_count;
+    }
+    for (uint32_t k = 0; k < CONVOLUTION_BIN_COUNT; ++k)
+    {
+        tables.m_RealRe[k] = (float)cos(-2.0 * pi * k / CONVOLUTION_FFT_SIZE);
+        tables.m_RealIm[k] = (float)sin(-2.0 * pi * k / CONVOLUTION_FFT_SIZE);
+        uint32_t reverse   = 0;
+        for (uint32_t b = 0; b < bit_count; ++b)
+        {
+            reverse |= ((k >> b) & 1u) << (bit_count - 1 - b);
+        }
+        tables.m_BitReverse[k] = (uint16_t)reverse;
+    }
+    return tables;
+}
+
+static const FFTTables& GetFFTTables()
+{
+    static const FFTTables tables = MakeFFTTables();
+    return tables;
+}
+
+// One radix 2 stage over all CONVOLUTION_BIN_COUNT points, the inverse uses conjugated twiddles
+static void FFTStageScalar(float* re, float* im, const float* twiddle_re, const float* twiddle_im, uint32_t span, bool inverse)
+{
+    float sign = inverse ? -1.f : 1.f;
+    for (uint32_t start = 0; start < CONVOLUTION_BIN_COUNT; start += span * 2)
+    {
+        for (uint32_t j = 0; j < span; ++j)
+        {
+            uint32_t a  = start + j;
+            uint32_t b  = a + span;
+            float    wr = twiddle_re[j];
+            float    wi = twiddle_im[j] * sign;
+            float    tr = re[b] * wr - im[b] * wi;
+            float    ti = re[b] * wi + im[b] * wr;
+            re[b]       = re[a] - tr;
+            im[b]       = im[a] - ti;
+            re[a] += tr;
+            im[a] += ti;
+        }
+    }
+}
+
+// acc += x * h over count complex bins
+static void ComplexMultiplyAddScalar(float* acc_re, float* acc_im, const float* x_re, const float* x_im, const float* h_re, const float* h_im, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        acc_re[i] += x_re[i] * h_re[i] - x_im[i] * h_im[i];
+        acc_im[i] += x_re[i] * h_im[i] + x_im[i] * h_re[i];
+    }
+}
+
+#if SOGO_SIMD_X86
+static void FFTStageSSE2(float* re, float* im, const float* twiddle_re, const float* twiddle_im, uint32_t span, bool inverse)
+{
+    if (span < 4)
+    {
+        FFTStageScalar(re, im, twiddle_re, twiddle_im, span, inverse);
+        return;
+    }
+    __m128 sign = _mm_set1_ps(inverse ? -1.f : 1.f);
+    for (uint32_t start = 0; start < CONVOLUTION_BIN_COUNT; start += span * 2)
+    {
+        for (uint32_t j = 0; j < span; j += 4)
+        {
+            uint32_t a  = start + j;
+            uint32_t b  = a + span;
+            __m128   wr = _mm_loadu_ps(&twiddle_re[j]);
+            __m128   wi = _mm_mul_ps(_mm_loadu_ps(&twiddle_im[j]), sign);
+            __m128   br = _mm_loadu_ps(&re[b]);
+            __m128   bi = _mm_loadu_ps(&im[b]);
+            __m128   ar = _mm_loadu_ps(&re[a]);
+            __m128   ai = _mm_loadu_ps(&im[a]);
+            __m128   tr = _mm_sub_ps(_mm_mul_ps(br, wr), _mm_mul_ps(bi, wi));
+            __m128   ti = _mm_add_ps(_mm_mul_ps(br, wi), _mm_mul_ps(bi, wr));
+            _mm_storeu_ps(&re[b], _mm_sub_ps(ar, tr));
+            _mm_storeu_ps(&im[b], _mm_sub_ps(ai, ti));
+            _mm_storeu_ps(&re[a], _mm_add_ps(ar, tr));
+            _mm_storeu_ps(&im[a], _mm_add_ps(ai, ti));
+        }
+    }
+}
+
+static void ComplexMultiplyAddSSE2(float* acc_re, float* acc_im, const float* x_re, const float* x_im, const float* h_re, const float* h_im, uint32_t count)
+{
+    uint32_t vector_count = count / 4;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        uint32_t i  = v * 4;
+        __m128   xr = _mm_loadu_ps(&x_re[i]);
+        __m128   xi = _mm_loadu_ps(&x_im[i]);
+        __m128   hr = _mm_loadu_ps(&h_re[i]);
+        __m128   hi = _mm_loadu_ps(&h_im[i]);
+        _mm_storeu_ps(&acc_re[i], _mm_add_ps(_mm_loadu_ps(&acc_re[i]), _mm_sub_ps(_mm_mul_ps(xr, hr), _mm_mul_ps(xi, hi))));
+        _mm_storeu_ps(&acc_im[i], _mm_add_ps(_mm_loadu_ps(&acc_im[i]), _mm_add_ps(_mm_mul_ps(xr, hi), _mm_mul_ps(xi, hr))));
+    }
+    uint32_t done = vector_count * 4;
+    ComplexMultiplyAddScalar(&acc_re[done], &acc_im[done], &x_re[done], &x_im[done], &h_re[done], &h_im[done], count - done);
+}
+
+SOGO_TARGET_AVX2 static void FFTStageAVX2(float* re, float* im, const float* twiddle_re, const float* twiddle_im, uint32_t span, bool inverse)
+{
+    if (span < 8)
+    {
+        FFTStageSSE2(re, im, twiddle_re, twiddle_im, span, inverse);
+        return;
+    }
+    __m256 sign = _mm256_set1_ps(inverse ? -1.f : 1.f);
+    for (uint32_t start = 0; start < CONVOLUTION_BIN_COUNT; start += span * 2)
+    {
+        for (uint32_t j = 0; j < span; j += 8)
+        {
+            uint32_t a  = start + j;
+            uint32_t b  = a + span;
+            __m256   wr = _mm256_loadu_ps(&twiddle_re[j]);
+            __m256   wi = _mm256_mul_ps(_mm256_loadu_ps(&twiddle_im[j]), sign);
+            __m256   br = _mm256_loadu_ps(&re[b]);
+            __m256   bi = _mm256_loadu_ps(&im[b]);
+            __m256   ar = _mm256_loadu_ps(&re[a]);
+            __m256   ai = _mm256_loadu_ps(&im[a]);
+            __m256   tr = _mm256_sub_ps(_mm256_mul_ps(br, wr), _mm256_mul_ps(bi, wi));
+            __m256   ti = _mm256_add_ps(_mm256_mul_ps(br, wi), _mm256_mul_ps(bi, wr));
+            _mm256_storeu_ps(&re[b], _mm256_sub_ps(ar, tr));
+            _mm256_storeu_ps(&im[b], _mm256_sub_ps(ai, ti));
+            _mm256_storeu_ps(&re[a], _mm256_add_ps(ar, tr));
+            _mm256_storeu_ps(&im[a], _mm256_add_ps(ai, ti));
+        }
+    }
+}
+
+SOGO_TARGET_AVX2 static void ComplexMultiplyAddAVX2(float* acc_re, float* acc_im, const float* x_re, const float* x_im, const float* h_re, const float* h_im, uint32_t count)
+{
+    uint32_t vector_count = count / 8;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        uint32_t i  = v * 8;
+        __m256   xr = _mm256_loadu_ps(&x_re[i]);
+        __m256   xi = _mm256_loadu_ps(&x_im[i]);
+        __m256   hr = _mm256_loadu_ps(&h_re[i]);
+        __m256   hi = _mm256_loadu_ps(&h_im[i]);
+        _mm256_storeu_ps(&acc_re[i], _mm256_add_ps(_mm256_loadu_ps(&acc_re[i]), _mm256_sub_ps(_mm256_mul_ps(xr, hr), _mm256_mul_ps(xi, hi))));
+        _mm256_storeu_ps(&acc_im[i], _mm256_add_ps(_mm256_loadu_ps(&acc_im[i]), _mm256_add_ps(_mm256_mul_ps(xr, hi), _mm256_mul_ps(xi, hr))));
+    }
+    uint32_t done = vector_count * 8;
+    ComplexMultiplyAddScalar(&acc_re[done], &acc_im[done], &x_re[done], &x_im[done], &h_re[done], &h_im[done], count - done);
+}
+#endif
+
+struct ConvolutionKernels
+{
+    void (*m_FFTStage)(float* re, float* im, const float* twiddle_re, const float* twiddle_im, uint32_t span, bool inverse);
+    void (*m_ComplexMultiplyAdd)(float* acc_re, float* acc_im, const float* x_re, const float* x_im, const float* h_re, const float* h_im, uint32_t count);
+};
+
+static ConvolutionKernels GetConvolutionKernels(SimdLevel simd_level)
+{
+    ConvolutionKernels kernels = { FFTStageScalar, ComplexMultiplyAddScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_FFTStage           = FFTStageAVX2;
+        kernels.m_ComplexMultiplyAdd = ComplexMultiplyAddAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_FFTStage           = FFTStageSSE2;
+        kernels.m_ComplexMultiplyAdd = ComplexMultiplyAddSSE2;
+    }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
+
+static const ConvolutionKernels& GetConvolutionKernels()
+{
+    static const ConvolutionKernels kernels = GetConvolutionKernels(GetSimdLevel());
+    return kernels;
+}
+
+// Complex FFT of CONVOLUTION_BIN_COUNT points in place, unscaled in both directions
+static void ComplexFFT(float* re, float* im, bool inverse)
+{
+    const FFTTables& tables = GetFFTTables();
+    for (uint32_t k = 0; k < CONVOLUTION_BIN_COUNT; ++k)
+    {
+        uint32_t reverse = tables.m_BitReverse[k];
+        if (k < reverse)
+        {
+            float r     = re[k];
+            float i     = im[k];
+            re[k]       = re[reverse];
+            im[k]       = im[reverse];
+            re[reverse] = r;
+            im[reverse] = i;
+        }
+    }
+    const ConvolutionKernels& kernels = GetConvolutionKernels();
+    for (uint32_t span = 1; span < CONVOLUTION_BIN_COUNT; span *= 2)
+    {
+        kernels.m_FFTStage(re, im, &tables.m_TwiddleRe[span], &tables.m_TwiddleIm[span], span, inverse);
+    }
+}
+
+// Packed spectrum of CONVOLUTION_FFT_SIZE real frames, the even frames are the real and the odd
+// frames the imaginary part of a complex FFT of half the size
+static void RealFFT(const float* input, float* out_re, float* out_im)
+{
+    float z_re[CONVOLUTION_BIN_COUNT];
+    float z_im[CONVOLUTION_BIN_COUNT];
+    for (uint32_t n = 0; n < CONVOLUTION_BIN_COUNT; ++n)
+    {
+        z_re[n] = input[n * 2];
+        z_im[n] = input[n * 2 + 1];
+    }
+    ComplexFFT(z_re, z_im, false);
+
+    const FFTTables& tables = GetFFTTables();
+    out_re[0]               = z_re[0] + z_im[0];
+    out_im[0]               = z_re[0] - z_im[0];
+    for (uint32_t k = 1; k < CONVOLUTION_BIN_COUNT; ++k)
+    {
+        uint32_t m    = CONVOLUTION_BIN_COUNT - k;
+        float    e_re = (z_re[k] + z_re[m]) * 0.5f;
+        float    e_im = (z_im[k] - z_im[m]) * 0.5f;
+        float    o_re = (z_im[k] + z_im[m]) * 0.5f;
+        float    o_im = (z_re[m] - z_re[k]) * 0.5f;
+        float    w_re = tables.m_RealRe[k];
+        float    w_im = tables.m_RealIm[k];
+        out_re[k]     = e_re + w_re * o_re - w_im * o_im;
+        out_im[k]     = e_im + w_re * o_im + w_im * o_re;
+    }
+}
+
+// Inverse of RealFFT scaled by CONVOLUTION_BIN_COUNT, only the second half of the frames is written
+static void InverseRealFFT(const float* in_re, const float* in_im, float* output)
+{
+    const FFTTables& tables = GetFFTTables();
+    float            z_re[CONVOLUTION_BIN_COUNT];
+    float            z_im[CONVOLUTION_BIN_COUNT];
+    z_re[0] = (in_re[0] + in_im[0]) * 0.5f;
+    z_im[0] = (in_re[0] - in_im[0]) * 0.5f;
+    for (uint32_t k = 1; k < CONVOLUTION_BIN_COUNT; ++k)
+    {
+        uint32_t m    = CONVOLUTION_BIN_COUNT - k;
+        float    e_re = (in_re[k] + in_re[m]) * 0.5f;
+        float    e_im = (in_im[k] - in_im[m]) * 0.5f;
+        float    d_re = (in_re[k] - in_re[m]) * 0.5f;
+        float    d_im = (in_im[k] + in_im[m]) * 0.5f;
+        float    w_re = tables.m_RealRe[k];
+        float    w_im = -tables.m_RealIm[k];
+        float    o_re = d_re * w_re - d_im * w_im;
+        float    o_im = d_re * w_im + d_im * w_re;
+        z_re[k]       = e_re - o_im;
+        z_im[k]       = e_im + o_re;
+    }
+    ComplexFFT(z_re, z_im, true);
+    for (uint32_t n = CONVOLUTION_BIN_COUNT / 2; n < CONVOLUTION_BIN_COUNT; ++n)
+    {
+        output[n * 2]     = z_re[n];
+        output[n * 2 + 1] = z_im[n];
+    }
+}
+
+enum SOGO_CONVOLUTION_RESOURCES
+{
+    SOGO_CONVOLUTION_RESOURCE_IMPULSE,
+    SOGO_CONVOLUTION_RESOURCE_COUNT
+};
+
+enum SOGO_CONVOLUTION_AUDIO_INPUTS
+{
+    SOGO_CONVOLUTION_AUDIO_INPUT,
+    SOGO_CONVOLUTION_AUDIO_INPUT_COUNT
+};
+
+enum SOGO_CONVOLUTION_AUDIO_OUTPUTS
+{
+    SOGO_CONVOLUTION_AUDIO_OUTPUT,
+    SOGO_CONVOLUTION_AUDIO_OUTPUT_COUNT
+};
+
+// The resource made by PrepareConvolutionImpulse, this header followed by the spectra of the
+// m_PartitionCount partitions of each channel
+struct ConvolutionImpulse
+{
+    uint32_t m_ChannelCount;
+    uint32_t m_PartitionCount;
+};
+
+// The context memory is this header followed by floats, partition_capacity delay line spectra and
+// then the input history and output block of CONVOLUTION_MAX_CHANNEL_COUNT channels. The
+// partitions are split evenly between the channels.
+struct ConvolutionContext
+{
+    uint32_t m_PartitionCapacity;
+    uint32_t m_FramePosition; // Frames of the current block that have been read
+    uint32_t m_DelayLineHead;
+    uint32_t m_SilentBlockCount;
+    bool     m_IsBlockSilent;
+};
+
+static const uint32_t CONVOLUTION_SPECTRUM_SIZE = CONVOLUTION_BIN_COUNT * 2;
+static const uint32_t CONVOLUTION_HEADER_SIZE   = (sizeof(ConvolutionContext) + sizeof(float) - 1) & ~(uint32_t)(sizeof(float) - 1);
+
+static float* GetConvolutionDelayLine(ConvolutionContext* context)
+{
+    return (float*)&((uint8_t*)context)[CONVOLUTION_HEADER_SIZE];
+}
+
+// CONVOLUTION_FFT_SIZE frames per channel, the previous block and the block being read
+static float* GetConvolutionHistory(ConvolutionContext* context, TChannelIndex channel)
+{
+    return &GetConvolutionDelayLine(context)[context->m_PartitionCapacity * CONVOLUTION_SPECTRUM_SIZE + channel * CONVOLUTION_FFT_SIZE];
+}
+
+static float* GetConvolutionOutputBlock(ConvolutionContext* context, TChannelIndex channel)
+{
+    return &GetConvolutionHistory(context, CONVOLUTION_MAX_CHANNEL_COUNT)[channel * CONVOLUTION_PARTITION_FRAME_COUNT];
+}
+
+static TContextMemorySize GetConvolutionContextMemorySize(uint32_t partition_capacity)
+{
+    return CONVOLUTION_HEADER_SIZE +
+           sizeof(float) * (partition_capacity * CONVOLUTION_SPECTRUM_SIZE +
+                            CONVOLUTION_MAX_CHANNEL_COUNT * (CONVOLUTION_FFT_SIZE + CONVOLUTION_PARTITION_FRAME_COUNT));
+}
+
+uint32_t GetConvolutionImpulseSize(TChannelIndex channel_count, uint32_t impulse_frame_count)
+{
+    uint32_t partition_count = (impulse_frame_count + CONVOLUTION_PARTITION_FRAME_COUNT - 1) / CONVOLUTION_PARTITION_FRAME_COUNT;
+    return sizeof(ConvolutionImpulse) + sizeof(float) * channel_count * partition_count * CONVOLUTION_SPECTRUM_SIZE;
+}
+
+bool PrepareConvolutionImpulse(TChannelIndex channel_count, const float* samples, uint32_t impulse_frame_count, void* out_impulse_mem)
+{
+    if (channel_count == 0 || channel_count > CONVOLUTION_MAX_CHANNEL_COUNT)
+    {
+        return false;
+    }
+    ConvolutionImpulse* impulse = (ConvolutionImpulse*)out_impulse_mem;
+    impulse->m_ChannelCount     = channel_count;
+    impulse->m_PartitionCount   = (impulse_frame_count + CONVOLUTION_PARTITION_FRAME_COUNT - 1) / CONVOLUTION_PARTITION_FRAME_COUNT;
+
+    float* spectra = (float*)&impulse[1];
+    float  frames[CONVOLUTION_FFT_SIZE];
+    for (TChannelIndex c = 0; c < channel_count; ++c)
+    {
+        for (uint32_t p = 0; p < impulse->m_PartitionCount; ++p)
+        {
+            // The inverse FFT is unscaled, the impulse response takes the scale instead
+            memset(frames, 0, sizeof(frames));
+            uint32_t first = p * CONVOLUTION_PARTITION_FRAME_COUNT;
+            for (uint32_t f = 0; f < CONVOLUTION_PARTITION_FRAME_COUNT && first + f < impulse_frame_count; ++f)
+            {
+                frames[f] = samples[(first + f) * channel_count + c] * (1.f / CONVOLUTION_BIN_COUNT);
+            }
+            float* spectrum = &spectra[(c * impulse->m_PartitionCount + p) * CONVOLUTION_SPECTRUM_SIZE];
+            RealFFT(frames, spectrum, &spectrum[CONVOLUTION_BIN_COUNT]);
+        }
+    }
+    return true;
+}
+
+// The partitions of the impulse response that fit in the delay line, 0 if the resource is not
+// a prepared impulse response with the channel count of the node
+static uint32_t GetConvolutionPartitionCount(const ConvolutionContext* context, const Resource* impulse, TChannelIndex channel_count)
+{
+    if (impulse->m_Data == 0x0 || impulse->m_Size < sizeof(ConvolutionImpulse))
+    {
+        return 0;
+    }
+    const ConvolutionImpulse* header = (const ConvolutionImpulse*)impulse->m_Data;
+    if (header->m_ChannelCount != channel_count || (impulse->m_Size - sizeof(ConvolutionImpulse)) / (sizeof(float) * channel_count * CONVOLUTION_SPECTRUM_SIZE) < header->m_PartitionCount)
+    {
+        return 0;
+    }
+    uint32_t max_partition_count = context->m_PartitionCapacity / channel_count;
+    return header->m_PartitionCount < max_partition_count ? header->m_PartitionCount : max_partition_count;
+}
+
+static void ConvolveBlock(ConvolutionContext* context, const ConvolutionImpulse* impulse, uint32_t partition_count, TChannelIndex channel_count)
+{
+    const ConvolutionKernels& kernels             = GetConvolutionKernels();
+    uint32_t                  max_partition_count = context->m_PartitionCapacity / channel_count;
+    uint32_t                  head                = context->m_DelayLineHead;
+    const float*              spectra             = (const float*)&impulse[1];
+    float*                    delay_line          = GetConvolutionDelayLine(context);
+    float                     acc_re[CONVOLUTION_BIN_COUNT];
+    float                     acc_im[CONVOLUTION_BIN_COUNT];
+    for (TChannelIndex c = 0; c < channel_count; ++c)
+    {
+        float*       history   = GetConvolutionHistory(context, c);
+        float*       channel_x = &delay_line[c * max_partition_count * CONVOLUTION_SPECTRUM_SIZE];
+        const float* channel_h = &spectra[c * impulse->m_PartitionCount * CONVOLUTION_SPECTRUM_SIZE];
+        RealFFT(history, &channel_x[head * CONVOLUTION_SPECTRUM_SIZE], &channel_x[head * CONVOLUTION_SPECTRUM_SIZE + CONVOLUTION_BIN_COUNT]);
+        memcpy(history, &history[CONVOLUTION_PARTITION_FRAME_COUNT], sizeof(float) * CONVOLUTION_PARTITION_FRAME_COUNT);
+
+        memset(acc_re, 0, sizeof(acc_re));
+        memset(acc_im, 0, sizeof(acc_im));
+        for (uint32_t p = 0; p < partition_count; ++p)
+        {
+            uint32_t     slot = (head + max_partition_count - p) % max_partition_count;
+            const float* x_re = &channel_x[slot * CONVOLUTION_SPECTRUM_SIZE];
+            const float* x_im = x_re + CONVOLUTION_BIN_COUNT;
+            const float* h_re = &channel_h[p * CONVOLUTION_SPECTRUM_SIZE];
+            const float* h_im = h_re + CONVOLUTION_BIN_COUNT;
+            // DC and Nyquist are real and packed in bin 0
+            acc_re[0] += x_re[0] * h_re[0];
+            acc_im[0] += x_im[0] * h_im[0];
+            kernels.m_ComplexMultiplyAdd(&acc_re[1], &acc_im[1], &x_re[1], &x_im[1], &h_re[1], &h_im[1], CONVOLUTION_BIN_COUNT - 1);
+        }
+
+        float frames[CONVOLUTION_FFT_SIZE];
+        InverseRealFFT(acc_re, acc_im, frames);
+        memcpy(GetConvolutionOutputBlock(context, c), &frames[CONVOLUTION_PARTITION_FRAME_COUNT], sizeof(float) * CONVOLUTION_PARTITION_FRAME_COUNT);
+    }
+    context->m_DelayLineHead = (head + 1) % max_partition_count;
+}
+
+static void RenderConvolution(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    ConvolutionContext* context       = (ConvolutionContext*)render_parameters->m_ContextMemory;
+    AudioOutput*        output_data   = &render_parameters->m_AudioOutputs[SOGO_CONVOLUTION_AUDIO_OUTPUT];
+    const AudioOutput*  input_data    = render_parameters->m_AudioInputs[SOGO_CONVOLUTION_AUDIO_INPUT].m_AudioOutput;
+    TChannelIndex       channel_count = output_data->m_ChannelCount;
+    TFrameIndex         frame_count   = render_parameters->m_FrameCount;
+
+    const Resource* impulse         = &render_parameters->m_Resources[SOGO_CONVOLUTION_RESOURCE_IMPULSE];
+    uint32_t        partition_count = GetConvolutionPartitionCount(context, impulse, channel_count);
+
+    // Inputs of other channel counts are treated as silence
+    const float*  input               = input_data->m_Buffer;
+    TChannelIndex input_channel_count = input_data->m_ChannelCount;
+    if (input_channel_count != channel_count && input_channel_count != 1)
+    {
+        input = 0x0;
+    }
+    // Once the tail has passed through every partition the output stays silent until the input returns
+    if (partition_count == 0 || (input == 0x0 && context->m_SilentBlockCount > partition_count))
+    {
+        output_data->m_Buffer = 0x0;
+        return;
+    }
+
+    output_data->m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, channel_count, frame_count);
+    float* output         = output_data->m_Buffer;
+    if (output == 0x0)
+    {
+        return;
+    }
+    TFrameIndex f = 0;
+    while (f < frame_count)
+    {
+        uint32_t position = context->m_FramePosition;
+        uint32_t count    = CONVOLUTION_PARTITION_FRAME_COUNT - position;
+        count             = count < (uint32_t)(frame_count - f) ? count : (uint32_t)(frame_count - f);
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            float*        history       = &GetConvolutionHistory(context, c)[CONVOLUTION_PARTITION_FRAME_COUNT + position];
+            const float*  output_block  = &GetConvolutionOutputBlock(context, c)[position];
+            TChannelIndex input_channel = input_channel_count == 1 ? 0 : c;
+            for (uint32_t i = 0; i < count; ++i)
+            {
+                history[i]                          = input == 0x0 ? 0.f : input[(f + i) * input_channel_count + input_channel];
+                output[(f + i) * channel_count + c] = output_block[i];
+            }
+        }
+        context->m_IsBlockSilent = context->m_IsBlockSilent && input == 0x0;
+        context->m_FramePosition = position + count;
+        f += (TFrameIndex)count;
+        if (context->m_FramePosition == CONVOLUTION_PARTITION_FRAME_COUNT)
+        {
+            ConvolveBlock(context, (const ConvolutionImpulse*)impulse->m_Data, partition_count, channel_count);
+            context->m_SilentBlockCount = context->m_IsBlockSilent ? context->m_SilentBlockCount + 1 : 0;
+            context->m_IsBlockSilent    = true;
+            context->m_FramePosition    = 0;
+        }
+    }
+}
+
+static void InitConvolution(HGraph, HNode, const GraphRuntimeSettings*, TParameter user_data, void* context_memory)
+{
+    uint32_t partition_capacity = user_data.m_Int;
+    memset(context_memory, 0, GetConvolutionContextMemorySize(partition_capacity));
+    ConvolutionContext* context  = (ConvolutionContext*)context_memory;
+    context->m_PartitionCapacity = partition_capacity;
+    context->m_IsBlockSilent     = true;
+}
+
+// The user data is the partition capacity, the partitions of all channels
+static void ConvolutionNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter user_data, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitConvolution;
+    out_node_runtime_desc->m_RenderCallback    = RenderConvolution;
+    out_node_runtime_desc->m_ContextMemorySize = GetConvolutionContextMemorySize(user_data.m_Int);
+}
+
+static const uint32_t CONVOLUTION_MAX_PARTITION_CAPACITY = 1024;
+
+bool MakeConvolutionNodeDesc(TChannelIndex channel_count, uint32_t max_impulse_frame_count, NodeStaticDescription* out_node_static_description)
+{
+    if (channel_count == 0 || channel_count > CONVOLUTION_MAX_CHANNEL_COUNT || max_impulse_frame_count == 0)
+    {
+        return false;
+    }
+    uint32_t partition_count = (max_impulse_frame_count + CONVOLUTION_PARTITION_FRAME_COUNT - 1) / CONVOLUTION_PARTITION_FRAME_COUNT;
+    if (partition_count > CONVOLUTION_MAX_PARTITION_CAPACITY / channel_count)
+    {
+        return false;
+    }
+    out_node_static_description->m_GetNodeRuntimeDescCallback = ConvolutionNodeGetNodeRuntimeDescCallback;
+    out_node_static_description->m_ParameterDescriptions      = 0x0;
+    out_node_static_description->m_AudioOutputDescriptions    = &FixedAudioOutputDescriptions[channel_count - 1];
+    out_node_static_description->m_Triggers                   = 0x0;
+    out_node_static_description->m_AudioInputCount            = SOGO_CONVOLUTION_AUDIO_INPUT_COUNT;
+    out_node_static_description->m_AudioOutputCount           = SOGO_CONVOLUTION_AUDIO_OUTPUT_COUNT;
+    out_node_static_description->m_ResourceCount              = SOGO_CONVOLUTION_RESOURCE_COUNT;
+    out_node_static_description->m_ParameterCount             = 0;
+    out_node_static_description->m_TriggerInputCount          = 0;
+    out_node_static_description->m_TriggerOutputCount         = 0;
+    out_node_static_description->m_Flags                      = 0;
+    out_node_static_description->m_UserData.m_Int             = partition_count * channel_count;
+    return true;
+}
+
+///////////////////// SOGO DELAY
+
+enum SOGO_DELAY_PARAMETERS
+{
+    SOGO_DELAY_PARAMETER_DELAY_INDEX,
+    SOGO_DELAY_PARAMETER_DEPTH_INDEX,
+    SOGO_DELAY_PARAMETER_RATE_INDEX,
+    SOGO_DELAY_PARAMETER_FEEDBACK_INDEX,
+    SOGO_DELAY_PARAMETER_DRY_INDEX,
+    SOGO_DELAY_PARAMETER_WET_INDEX,
+    SOGO_DELAY_PARAMETER_COUNT
+};
+
+enum SOGO_MULTI_TAP_DELAY_PARAMETERS
+{
+    SOGO_MULTI_TAP_DELAY_PARAMETER_DRY_INDEX,
+    SOGO_MULTI_TAP_DELAY_PARAMETER_TAP_COUNT_INDEX,
+    SOGO_MULTI_TAP_DELAY_PARAMETER_FIRST_TAP_INDEX // Delay<n> and Gain<n> of each tap
+};
+
+enum SOGO_DELAY_AUDIO_INPUTS
+{
+    SOGO_DELAY_AUDIO_INPUT,
+    SOGO_DELAY_AUDIO_INPUT_COUNT
+};
+
+enum SOGO_DELAY_AUDIO_OUTPUTS
+{
+    SOGO_DELAY_AUDIO_OUTPUT,
+    SOGO_DELAY_AUDIO_OUTPUT_COUNT
+};
+
+// Every channel can delay by up to m_CapacityFrameCount / channel_count frames. Its ring has
+// DELAY_GUARD_FRAME_COUNT frames more so a block never overwrites frames it still reads, and is
+// followed by a guard that mirrors the first DELAY_GUARD_FRAME_COUNT frames of the ring. A read of
+// up to the guard size starting anywhere in the ring is one contiguous run, only the write position
+// wraps and the nodes render in blocks that end where it does.
+struct DelayContext
+{
+    uint32_t m_CapacityFrameCount;
+    uint32_t m_WritePosition;
+    uint32_t m_QuietFrameCount; // Frames since a sample above DELAY_QUIET_LEVEL was written to the ring
+    float    m_Phase;           // Of the delay modulation, in cycles
+};
+
+static const uint32_t DELAY_GUARD_FRAME_COUNT           = 64;
+static const uint32_t DELAY_MODULATED_BLOCK_FRAME_COUNT = 16;
+static const float    DELAY_QUIET_LEVEL                 = 1e-6f;
+
+static uint32_t GetDelayCapacityFrameCount(const GraphRuntimeSettings* graph_runtime_settings, float capacity_seconds)
+{
+    return (uint32_t)ceilf(graph_runtime_settings->m_FrameRate * capacity_seconds);
+}
+
+static TContextMemorySize GetDelayContextMemorySize(const GraphRuntimeSettings* graph_runtime_settings, float capacity_seconds)
+{
+    return sizeof(DelayContext) + sizeof(float) * (GetDelayCapacityFrameCount(graph_runtime_settings, capacity_seconds) + DELAY_MAX_CHANNEL_COUNT * DELAY_GUARD_FRAME_COUNT * 2);
+}
+
+// The user data is the capacity in channel seconds, channel_count * max_delay_seconds
+static void InitDelay(HGraph, HNode, const GraphRuntimeSettings* graph_runtime_settings, TParameter user_data, void* context_memory)
+{
+    memset(context_memory, 0, GetDelayContextMemorySize(graph_runtime_settings, user_data.m_Float));
+    DelayContext* context         = (DelayContext*)context_memory;
+    context->m_CapacityFrameCount = GetDelayCapacityFrameCount(graph_runtime_settings, user_data.m_Float);
+}
+
+static uint32_t GetDelayRingSize(const DelayContext* context, TChannelIndex channel_count)
+{
+    return channel_count == 0 || channel_count > DELAY_MAX_CHANNEL_COUNT ? 0 : context->m_CapacityFrameCount / channel_count + DELAY_GUARD_FRAME_COUNT;
+}
+
+static float* GetDelayRing(DelayContext* context, uint32_t ring_size, TChannelIndex channel)
+{
+    return &((float*)&context[1])[channel * (ring_size + DELAY_GUARD_FRAME_COUNT)];
+}
+
+// The block must end at or before the end of the ring
+static void WriteDelayRing(float* ring, uint32_t ring_size, uint32_t position, const float* frames, uint32_t frame_count)
+{
+    memcpy(&ring[position], frames, sizeof(float) * frame_count);
+    if (position < DELAY_GUARD_FRAME_COUNT)
+    {
+        uint32_t mirror_count = DELAY_GUARD_FRAME_COUNT - position;
+        memcpy(&ring[ring_size + position], frames, sizeof(float) * (mirror_count < frame_count ? mirror_count : frame_count));
+    }
+}
+
+static uint32_t GetDelayReadPosition(uint32_t write_position, uint32_t ring_size, uint32_t delay_frame_count)
+{
+    return write_position >= delay_frame_count ? write_position - delay_frame_count : write_position + ring_size - delay_frame_count;
+}
+
+// Returns 0x0 once the input is silent and everything in the ring is quiet, otherwise the
+// output buffer with the input channel count
+static float* BeginDelay(HGraph graph, HNode node, const RenderParameters* render_parameters, uint32_t ring_size)
+{
+    DelayContext*      context    = (DelayContext*)render_parameters->m_ContextMemory;
+    const AudioOutput* input_data = render_parameters->m_AudioInputs[SOGO_DELAY_AUDIO_INPUT].m_AudioOutput;
+    AudioOutput*       output     = &render_parameters->m_AudioOutputs[SOGO_DELAY_AUDIO_OUTPUT];
+    if (input_data->m_Buffer == 0x0 && context->m_QuietFrameCount >= ring_size)
+    {
+        output->m_Buffer = 0x0;
+        return 0x0;
+    }
+    output->m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, input_data->m_ChannelCount, render_parameters->m_FrameCount);
+    return output->m_Buffer;
+}
+
+static void EndDelayBlock(DelayContext* context, uint32_t ring_size, uint32_t frame_count, float peak)
+{
+    context->m_QuietFrameCount = peak >= DELAY_QUIET_LEVEL ? 0 : context->m_QuietFrameCount + frame_count;
+    context->m_WritePosition += frame_count;
+    if (context->m_WritePosition == ring_size)
+    {
+        context->m_WritePosition = 0;
+    }
+}
+
+static void RenderDelay(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    DelayContext*      context       = (DelayContext*)render_parameters->m_ContextMemory;
+    const AudioOutput* input_data    = render_parameters->m_AudioInputs[SOGO_DELAY_AUDIO_INPUT].m_AudioOutput;
+    TChannelIndex      channel_count = input_data->m_ChannelCount;
+    uint32_t           ring_size     = GetDelayRingSize(context, channel_count);
+    if (ring_size <= DELAY_GUARD_FRAME_COUNT)
+    {
+        render_parameters->m_AudioOutputs[SOGO_DELAY_AUDIO_OUTPUT].m_Buffer = 0x0;
+        return;
+    }
+    float* output = BeginDelay(graph, node, render_parameters, ring_size);
+    if (output == 0x0)
+    {
+        return;
+    }
+
+    const TParameter* parameters  = render_parameters->m_Parameters;
+    float             frame_rate  = (float)render_parameters->m_FrameRate;
+    float             max_delay   = (float)(ring_size - DELAY_GUARD_FRAME_COUNT);
+    float             delay       = parameters[SOGO_DELAY_PARAMETER_DELAY_INDEX].m_Float * frame_rate;
+    float             depth       = parameters[SOGO_DELAY_PARAMETER_DEPTH_INDEX].m_Float * frame_rate;
+    float             phase_step  = parameters[SOGO_DELAY_PARAMETER_RATE_INDEX].m_Float / frame_rate;
+    float             feedback    = parameters[SOGO_DELAY_PARAMETER_FEEDBACK_INDEX].m_Float;
+    float             dry         = parameters[SOGO_DELAY_PARAMETER_DRY_INDEX].m_Float;
+    float             wet         = parameters[SOGO_DELAY_PARAMETER_WET_INDEX].m_Float;
+    const float*      input       = input_data->m_Buffer;
+    TFrameIndex       frame_count = render_parameters->m_FrameCount;
+    feedback                      = feedback < -0.99f ? -0.99f : (feedback > 0.99f ? 0.99f : feedback);
+    delay                         = delay < 1.f ? 1.f : (delay > max_delay ? max_delay : delay);
+
+    float    x[DELAY_GUARD_FRAME_COUNT];
+    float    y[DELAY_GUARD_FRAME_COUNT];
+    float    delays[DELAY_MODULATED_BLOCK_FRAME_COUNT];
+    uint32_t f = 0;
+    while (f < frame_count)
+    {
+        uint32_t write_position = context->m_WritePosition;
+        uint32_t block_count    = frame_count - f;
+        block_count             = block_count < ring_size - write_position ? block_count : ring_size - write_position;
+
+        // Every frame of the block reads frames written before the block, fixed delays read one
+        // contiguous run per channel and modulated delays interpolate between two frames
+        uint32_t read_position;
+        uint32_t read_offsets[DELAY_MODULATED_BLOCK_FRAME_COUNT];
+        float    read_fractions[DELAY_MODULATED_BLOCK_FRAME_COUNT];
+        bool     is_modulated = depth != 0.f;
+        if (!is_modulated)
+        {
+            uint32_t delay_frame_count = (uint32_t)(delay + 0.5f);
+            block_count                = block_count < DELAY_GUARD_FRAME_COUNT ? block_count : DELAY_GUARD_FRAME_COUNT;
+            block_count                = block_count < delay_frame_count ? block_count : delay_frame_count;
+            read_position              = GetDelayReadPosition(write_position, ring_size, delay_frame_count);
+        }
+        else
+        {
+            block_count        = block_count < DELAY_MODULATED_BLOCK_FRAME_COUNT ? block_count : DELAY_MODULATED_BLOCK_FRAME_COUNT;
+            float    min_delay = max_delay;
+            float    max_read  = 0.f;
+            float    phase     = context->m_Phase;
+            uint32_t n         = 0;
+            for (; n < block_count; ++n)
+            {
+                float d = delay + depth * sinf(6.28318531f * phase);
+                d       = d < 1.f ? 1.f : (d > max_delay ? max_delay : d);
+                // Stop where a frame would read inside the block or the reads outgrow the guard
+                float block_min = d < min_delay ? d : min_delay;
+                float block_max = d > max_read ? d : max_read;
+                if (n > 0 && (block_min < (float)(n + 1) || block_max - block_min + n + 4 > (float)DELAY_GUARD_FRAME_COUNT))
+                {
+                    break;
+                }
+                delays[n] = d;
+                min_delay = block_min;
+                max_read  = block_max;
+                phase += phase_step;
+                phase -= (float)(int32_t)phase;
+            }
+            block_count              = n;
+            context->m_Phase         = phase;
+            uint32_t read_back_count = (uint32_t)max_read + 1;
+            read_position            = GetDelayReadPosition(write_position, ring_size, read_back_count);
+            for (uint32_t i = 0; i < block_count; ++i)
+            {
+                float offset      = (float)(read_back_count + i) - delays[i];
+                read_offsets[i]   = (uint32_t)offset;
+                read_fractions[i] = offset - (float)read_offsets[i];
+            }
+        }
+
+        float peak = 0.f;
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            float*       ring = GetDelayRing(context, ring_size, c);
+            const float* read = &ring[read_position];
+            for (uint32_t i = 0; i < block_count; ++i)
+            {
+                x[i] = input == 0x0 ? 0.f : input[(f + i) * channel_count + c];
+            }
+            if (!is_modulated)
+            {
+                memcpy(y, read, sizeof(float) * block_count);
+            }
+            else
+            {
+                for (uint32_t i = 0; i < block_count; ++i)
+                {
+                    float a = read[read_offsets[i]];
+                    float b = read[read_offsets[i] + 1];
+                    y[i]    = a + (b - a) * read_fractions[i];
+                }
+            }
+            for (uint32_t i = 0; i < block_count; ++i)
+            {
+                output[(f + i) * channel_count + c] = dry * x[i] + wet * y[i];
+                x[i] += feedback * y[i];
+                peak = fabsf(x[i]) > peak ? fabsf(x[i]) : peak;
+            }
+            WriteDelayRing(ring, ring_size, write_position, x, block_count);
+        }
+        EndDelayBlock(context, ring_size, block_count, peak);
+        f += block_count;
+    }
+}
+
+static void RenderMultiTapDelay(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    DelayContext*      context       = (DelayContext*)render_parameters->m_ContextMemory;
+    const AudioOutput* input_data    = render_parameters->m_AudioInputs[SOGO_DELAY_AUDIO_INPUT].m_AudioOutput;
+    TChannelIndex      channel_count = input_data->m_ChannelCount;
+    uint32_t           ring_size     = GetDelayRingSize(context, channel_count);
+    if (ring_size <= DELAY_GUARD_FRAME_COUNT)
+    {
+        render_parameters->m_AudioOutputs[SOGO_DELAY_AUDIO_OUTPUT].m_Buffer = 0x0;
+        return;
+    }
+    float* output = BeginDelay(graph, node, render_parameters, ring_size);
+    if (output == 0x0)
+    {
+        return;
+    }
+
+    const TParameter* parameters  = render_parameters->m_Parameters;
+    uint32_t          tap_count   = (uint32_t)parameters[SOGO_MULTI_TAP_DELAY_PARAMETER_TAP_COUNT_INDEX].m_Float;
+    float             dry         = parameters[SOGO_MULTI_TAP_DELAY_PARAMETER_DRY_INDEX].m_Float;
+    const float*      input       = input_data->m_Buffer;
+    TFrameIndex       frame_count = render_parameters->m_FrameCount;
+
+    // The block is written before the taps read it, a tap may read frames of the block itself
+    uint32_t tap_delays[DELAY_MAX_TAP_COUNT];
+    float    tap_gains[DELAY_MAX_TAP_COUNT];
+    for (uint32_t t = 0; t < tap_count; ++t)
+    {
+        float delay     = parameters[SOGO_MULTI_TAP_DELAY_PARAMETER_FIRST_TAP_INDEX + t * 2].m_Float * render_parameters->m_FrameRate;
+        float max_delay = (float)(ring_size - DELAY_GUARD_FRAME_COUNT);
+        delay           = delay < 0.f ? 0.f : (delay > max_delay ? max_delay : delay);
+        tap_delays[t]   = (uint32_t)(delay + 0.5f);
+        tap_gains[t]    = parameters[SOGO_MULTI_TAP_DELAY_PARAMETER_FIRST_TAP_INDEX + t * 2 + 1].m_Float;
+    }
+
+    float    x[DELAY_GUARD_FRAME_COUNT];
+    uint32_t f = 0;
+    while (f < frame_count)
+    {
+        uint32_t write_position = context->m_WritePosition;
+        uint32_t block_count    = frame_count - f;
+        block_count             = block_count < ring_size - write_position ? block_count : ring_size - write_position;
+        block_count             = block_count < DELAY_GUARD_FRAME_COUNT ? block_count : DELAY_GUARD_FRAME_COUNT;
+
+        float peak = 0.f;
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            float* ring = GetDelayRing(context, ring_size, c);
+            for (uint32_t i = 0; i < block_count; ++i)
+            {
+                x[i] = input == 0x0 ? 0.f : input[(f + i) * channel_count + c];
+                peak = fabsf(x[i]) > peak ? fabsf(x[i]) : peak;
+            }
+            WriteDelayRing(ring, ring_size, write_position, x, block_count);
+            for (uint32_t i = 0; i < block_count; ++i)
+            {
+                x[i] *= dry;
+            }
+            for (uint32_t t = 0; t < tap_count; ++t)
+            {
+                const float* read = &ring[GetDelayReadPosition(write_position, ring_size, tap_delays[t])];
+                float        gain = tap_gains[t];
+                for (uint32_t i = 0; i < block_count; ++i)
+                {
+                    x[i] += gain * read[i];
+                }
+            }
+            for (uint32_t i = 0; i < block_count; ++i)
+            {
+                output[(f + i) * channel_count + c] = x[i];
+            }
+        }
+        EndDelayBlock(context, ring_size, block_count, peak);
+        f += block_count;
+    }
+}
+
+static const ParameterDescription DelayParameters[SOGO_DELAY_PARAMETER_COUNT] = {
+    { "Delay", 0.25f },
+    { "Depth", 0.0f },
+    { "Rate", 1.0f },
+    { "Feedback", 0.0f },
+    { "Dry", 1.0f },
+    { "Wet", 1.0f }
+};
+
+// Every row has all taps, the parameter count of the node cuts it to the tap count
+#define SOGO_MULTI_TAP_DELAY_PARAMETERS(tap_count)                                                                      \
+    {                                                                                                                   \
+        { "Dry", 1.0f }, { 0x0, tap_count },                                                                            \
+            { "Delay0", 0.1f }, { "Gain0", 0.5f }, { "Delay1", 0.2f }, { "Gain1", 0.5f },                               \
+            { "Delay2", 0.3f }, { "Gain2", 0.5f }, { "Delay3", 0.4f }, { "Gain3", 0.5f },                               \
+            { "Delay4", 0.5f }, { "Gain4", 0.5f }, { "Delay5", 0.6f }, { "Gain5", 0.5f },                               \
+            { "Delay6", 0.7f }, { "Gain6", 0.5f }, { "Delay7", 0.8f }, { "Gain7", 0.5f }                                \
+    }
+
+static const ParameterDescription MultiTapDelayParameters[DELAY_MAX_TAP_COUNT][SOGO_MULTI_TAP_DELAY_PARAMETER_FIRST_TAP_INDEX + DELAY_MAX_TAP_COUNT * 2] = {
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(1.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(2.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(3.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(4.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(5.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(6.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(7.f),
+    SOGO_MULTI_TAP_DELAY_PARAMETERS(8.f)
+};
+
+#undef SOGO_MULTI_TAP_DELAY_PARAMETERS
+
+static struct AudioOutputDescription DelayNodeAudioOutputDescriptions[SOGO_DELAY_AUDIO_OUTPUT_COUNT] = {
+    { AudioOutputDescription::AS_INPUT, { 0 } }
+};
+
+static void DelayNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings* graph_runtime_settings, TParameter user_data, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitDelay;
+    out_node_runtime_desc->m_RenderCallback    = RenderDelay;
+    out_node_runtime_desc->m_ContextMemorySize = GetDelayContextMemorySize(graph_runtime_settings, user_data.m_Float);
+}
+
+static void MultiTapDelayNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings* graph_runtime_settings, TParameter user_data, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitDelay;
+    out_node_runtime_desc->m_RenderCallback    = RenderMultiTapDelay;
+    out_node_runtime_desc->m_ContextMemorySize = GetDelayContextMemorySize(graph_runtime_settings, user_data.m_Float);
+}
+
+static bool MakeDelayNodeStaticDescription(GetNodeRuntimeDescription get_node_runtime_desc_callback, TChannelIndex channel_count, float max_delay_seconds, const ParameterDescription* parameter_descriptions, TParameterIndex parameter_count, NodeStaticDescription* out_node_static_description)
+{
+    if (channel_count == 0 || channel_count > DELAY_MAX_CHANNEL_COUNT || !(max_delay_seconds > 0.f) || channel_count * max_delay_seconds > DELAY_MAX_CAPACITY_SECONDS)
+    {
+        return false;
+    }
+    out_node_static_description->m_GetNodeRuntimeDescCallback = get_node_runtime_desc_callback;
+    out_node_static_description->m_ParameterDescriptions      = parameter_descriptions;
+    out_node_static_description->m_AudioOutputDescriptions    = DelayNodeAudioOutputDescriptions;
+    out_node_static_description->m_Triggers                   = 0x0;
+    out_node_static_description->m_AudioInputCount            = SOGO_DELAY_AUDIO_INPUT_COUNT;
+    out_node_static_description->m_AudioOutputCount           = SOGO_DELAY_AUDIO_OUTPUT_COUNT;
+    out_node_static_description->m_ResourceCount              = 0;
+    out_node_static_description->m_ParameterCount             = parameter_count;
+    out_node_static_description->m_TriggerInputCount          = 0;
+    out_node_static_description->m_TriggerOutputCount         = 0;
+    out_node_static_description->m_Flags                      = 0;
+    out_node_static_description->m_UserData.m_Float           = channel_count * max_delay_seconds;
+    return true;
+}
+
+bool MakeDelayNodeDesc(TChannelIndex channel_count, float max_delay_seconds, NodeStaticDescription* out_node_static_description)
+{
+    return MakeDelayNodeStaticDescription(DelayNodeGetNodeRuntimeDescCallback, channel_count, max_delay_seconds, DelayParameters, SOGO_DELAY_PARAMETER_COUNT, out_node_static_description);
+}
+
+bool MakeMultiTapDelayNodeDesc(TChannelIndex channel_count, float max_delay_seconds, uint32_t tap_count, NodeStaticDescription* out_node_static_description)
+{
+    if (tap_count == 0 || tap_count > DELAY_MAX_TAP_COUNT)
+    {
+        return false;
+    }
+    return MakeDelayNodeStaticDescription(MultiTapDelayNodeGetNodeRuntimeDescCallback, channel_count, max_delay_seconds, MultiTapDelayParameters[tap_count - 1], (TParameterIndex)(SOGO_MULTI_TAP_DELAY_PARAMETER_FIRST_TAP_INDEX + tap_count * 2), out_node_static_description);
+}
+
+///////////////////// SOGO SINE
+
+enum SOGO_SINE_PARAMETERS
+{
+    SOGO_SINE_PARAMETER_FREQUENCY_INDEX,
+    SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX,
+    SOGO_SINE_PARAMETER_PHASE_INDEX,
+    SOGO_SINE_PARAMETER_PLAYING_INDEX,
+    SOGO_SINE_PARAMETER_COUNT
+};
+
+enum SOGO_SINE_RESOURCES
+{
+    SOGO_SINE_RESOURCE_COUNT
+};
+
+enum SOGO_SINE_TRIGGER_INPUTS
+{
+    SOGO_SINE_TRIGGER_START_INDEX,
+    SOGO_SINE_TRIGGER_STOP_INDEX,
+    SOGO_SINE_TRIGGER_INPUT_COUNT
+};
+
+enum SOGO_SINE_TRIGGER_OUTPUTS
+{
+    SOGO_SINE_TRIGGER_OUTPUT_COUNT
+};
+
+enum SOGO_SINE_AUDIO_INPUTS
+{
+    SOGO_SINE_AUDIO_INPUT_COUNT
+};
+
+enum SOGO_SINE_AUDIO_OUTPUTS
+{
+    SOGO_SINE_AUDIO_OUTPUT,
+    SOGO_SINE_AUDIO_OUTPUT_COUNT
+};
+
+// sin(2 * pi * phase) for a phase in cycles. The phase is reduced to [-0.5, 0.5] and folded
+// to [-0.25, 0.25] where a degree 9 odd polynomial is used, the absolute error is below 5e-6
+// for any phase. The same polynomial is used by all kernels so they produce the same signal.
+static const float SINE_C1 = 6.28318531f;  // 2 * pi
+static const float SINE_C3 = -41.3417022f; // -(2 * pi)^3 / 3!
+static const float SINE_C5 = 81.6052493f;  // (2 * pi)^5 / 5!
+static const float SINE_C7 = -76.7058597f; // -(2 * pi)^7 / 7!
+static const float SINE_C9 = 42.0586940f;  // (2 * pi)^9 / 9!
+
+static float SineScalar(float phase)
+{
+    float x      = phase - floorf(phase + 0.5f);
+    float abs_x  = fabsf(x);
+    float folded = abs_x < 0.5f - abs_x ? abs_x : 0.5f - abs_x;
+    float x2     = folded * folded;
+    float sine   = folded * (SINE_C1 + x2 * (SINE_C3 + x2 * (SINE_C5 + x2 * (SINE_C7 + x2 * SINE_C9))));
+    return x < 0.f ? -sine : sine;
+}
+
+// Renders frame_count frames starting at phase advancing step cycles per frame, returns the
+// phase after the last frame wrapped to (-1, 1)
+static float SineOscillatorScalar(float* out_buffer, TFrameIndex frame_count, float phase, float step)
+{
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        *out_buffer++ = SineScalar(phase);
+        phase += step;
+        phase -= (float)(int32_t)phase;
+    }
+    return phase;
+}
+
+// Renders frame_count frames of each oscillator to its own buffer, the phases are left where the
+// oscillators ended. Each oscillator advances exactly like SineOscillatorScalar.
+static void SineOscillatorsScalar(float* const* out_buffers, uint32_t oscillator_count, TFrameIndex frame_count, float* io_phases, const float* steps)
+{
+    for (uint32_t o = 0; o < oscillator_count; ++o)
+    {
+        io_phases[o] = SineOscillatorScalar(out_buffers[o], frame_count, io_phases[o], steps[o]);
+    }
+}
+
+#if SOGO_SIMD_X86
+static __m128 SineSSE2(__m128 phase)
+{
+    const __m128 sign_mask = _mm_set1_ps(-0.f);
+    __m128       x         = _mm_sub_ps(phase, _mm_cvtepi32_ps(_mm_cvtps_epi32(phase)));
+    __m128       sign      = _mm_and_ps(x, sign_mask);
+    __m128       abs_x     = _mm_andnot_ps(sign_mask, x);
+    __m128       folded    = _mm_min_ps(abs_x, _mm_sub_ps(_mm_set1_ps(0.5f), abs_x));
+    __m128       x2        = _mm_mul_ps(folded, folded);
+    __m128       sine      = _mm_add_ps(_mm_set1_ps(SINE_C7), _mm_mul_ps(x2, _mm_set1_ps(SINE_C9)));
+    sine                   = _mm_add_ps(_mm_set1_ps(SINE_C5), _mm_mul_ps(x2, sine));
+    sine                   = _mm_add_ps(_mm_set1_ps(SINE_C3), _mm_mul_ps(x2, sine));
+    sine                   = _mm_add_ps(_mm_set1_ps(SINE_C1), _mm_mul_ps(x2, sine));
+    return _mm_or_ps(_mm_mul_ps(folded, sine), sign);
+}
+
+static float SineOscillatorSSE2(float* out_buffer, TFrameIndex frame_count, float phase, float step)
+{
+    const __m128 lanes = _mm_mul_ps(_mm_set_ps(3.f, 2.f, 1.f, 0.f), _mm_set1_ps(step));
+
+    uint32_t vector_count = frame_count / 4;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        _mm_storeu_ps(out_buffer, SineSSE2(_mm_add_ps(_mm_set1_ps(phase), lanes)));
+        out_buffer += 4;
+        phase += step * 4;
+        phase -= (float)(int32_t)phase;
+    }
+    return SineOscillatorScalar(out_buffer, frame_count - vector_count * 4, phase, step);
+}
+
+// phase + step with the whole cycles removed, as in SineOscillatorScalar
+static __m128 NextSinePhaseSSE2(__m128 phase, __m128 step)
+{
+    phase = _mm_add_ps(phase, step);
+    return _mm_sub_ps(phase, _mm_cvtepi32_ps(_mm_cvttps_epi32(phase)));
+}
+
+// Four oscillators at a time with one oscillator per lane, four frames are transposed to a
+// vector for each oscillator
+static void SineOscillatorsSSE2(float* const* out_buffers, uint32_t oscillator_count, TFrameIndex frame_count, float* io_phases, const float* steps)
+{
+    for (uint32_t o = 0; o < oscillator_count; o += 4)
+    {
+        uint32_t lane_count     = oscillator_count - o < 4 ? oscillator_count - o : 4;
+        float    lane_phases[4] = { 0.f, 0.f, 0.f, 0.f };
+        float    lane_steps[4]  = { 0.f, 0.f, 0.f, 0.f };
+        memcpy(lane_phases, &io_phases[o], sizeof(float) * lane_count);
+        memcpy(lane_steps, &steps[o], sizeof(float) * lane_count);
+        __m128 phase = _mm_loadu_ps(lane_phases);
+        __m128 step  = _mm_loadu_ps(lane_steps);
+
+        TFrameIndex f = 0;
+        for (; f + 4 <= frame_count; f += 4)
+        {
+            __m128 frames[4];
+            for (uint32_t i = 0; i < 4; ++i)
+            {
+                frames[i] = SineSSE2(phase);
+                phase     = NextSinePhaseSSE2(phase, step);
+            }
+            _MM_TRANSPOSE4_PS(frames[0], frames[1], frames[2], frames[3]);
+            for (uint32_t l = 0; l < lane_count; ++l)
+            {
+                _mm_storeu_ps(&out_buffers[o + l][f], frames[l]);
+            }
+        }
+        for (; f < frame_count; ++f)
+        {
+            float lane_samples[4];
+            _mm_storeu_ps(lane_samples, SineSSE2(phase));
+            phase = NextSinePhaseSSE2(phase, step);
+            for (uint32_t l = 0; l < lane_count; ++l)
+            {
+                out_buffers[o + l][f] = lane_samples[l];
+            }
+        }
+        _mm_storeu_ps(lane_phases, phase);
+        memcpy(&io_phases[o], lane_phases, sizeof(float) * lane_count);
+    }
+}
+
+SOGO_TARGET_AVX2 static __m256 SineAVX2(__m256 phase)
+{
+    const __m256 sign_mask = _mm256_set1_ps(-0.f);
+    __m256       x         = _mm256_sub_ps(phase, _mm256_round_ps(phase, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+    __m256       sign      = _mm256_and_ps(x, sign_mask);
+    __m256       abs_x     = _mm256_andnot_ps(sign_mask, x);
+    __m256       folded    = _mm256_min_ps(abs_x, _mm256_sub_ps(_mm256_set1_ps(0.5f), abs_x));
+    __m256       x2        = _mm256_mul_ps(folded, folded);
+    __m256       sine      = _mm256_add_ps(_mm256_set1_ps(SINE_C7), _mm256_mul_ps(x2, _mm256_set1_ps(SINE_C9)));
+    sine                   = _mm256_add_ps(_mm256_set1_ps(SINE_C5), _mm256_mul_ps(x2, sine));
+    sine                   = _mm256_add_ps(_mm256_set1_ps(SINE_C3), _mm256_mul_ps(x2, sine));
+    sine                   = _mm256_add_ps(_mm256_set1_ps(SINE_C1), _mm256_mul_ps(x2, sine));
+    return _mm256_or_ps(_mm256_mul_ps(folded, sine), sign);
+}
+
+SOGO_TARGET_AVX2 static float SineOscillatorAVX2(float* out_buffer, TFrameIndex frame_count, float phase, float step)
+{
+    const __m256 lanes = _mm256_mul_ps(_mm256_set_ps(7.f, 6.f, 5.f, 4.f, 3.f, 2.f, 1.f, 0.f), _mm256_set1_ps(step));
+
+    uint32_t vector_count = frame_count / 8;
+    for (uint32_t v = 0; v < vector_count; ++v)
+    {
+        _mm256_storeu_ps(out_buffer, SineAVX2(_mm256_add_ps(_mm256_set1_ps(phase), lanes)));
+        out_buffer += 8;
+        phase += step * 8;
+        phase -= (float)(int32_t)phase;
+    }
+    return SineOscillatorScalar(out_buffer, frame_count - vector_count * 8, phase, step);
+}
+
+SOGO_TARGET_AVX2 static __m256 NextSinePhaseAVX2(__m256 phase, __m256 step)
+{
+    phase = _mm256_add_ps(phase, step);
+    return _mm256_sub_ps(phase, _mm256_round_ps(phase, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC));
+}
+
+// Row i of the result is lane i of every input row
+SOGO_TARGET_AVX2 static void Transpose8x8AVX2(__m256* rows)
+{
+    __m256 t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+    __m256 t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+    __m256 t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+    __m256 t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+    __m256 t4 = _mm256_unpacklo_ps(rows[4], rows[5]);
+    __m256 t5 = _mm256_unpackhi_ps(rows[4], rows[5]);
+    __m256 t6 = _mm256_unpacklo_ps(rows[6], rows[7]);
+    __m256 t7 = _mm256_unpackhi_ps(rows[6], rows[7]);
+    __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+    rows[0]   = _mm256_permute2f128_ps(s0, s4, 0x20);
+    rows[1]   = _mm256_permute2f128_ps(s1, s5, 0x20);
+    rows[2]   = _mm256_permute2f128_ps(s2, s6, 0x20);
+    rows[3]   = _mm256_permute2f128_ps(s3, s7, 0x20);
+    rows[4]   = _mm256_permute2f128_ps(s0, s4, 0x31);
+    rows[5]   = _mm256_permute2f128_ps(s1, s5, 0x31);
+    rows[6]   = _mm256_permute2f128_ps(s2, s6, 0x31);
+    rows[7]   = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+SOGO_TARGET_AVX2 static void SineOscillatorsAVX2(float* const* out_buffers, uint32_t oscillator_count, TFrameIndex frame_count, float* io_phases, const float* steps)
+{
+    for (uint32_t o = 0; o < oscillator_count; o += 8)
+    {
+        uint32_t lane_count     = oscillator_count - o < 8 ? oscillator_count - o : 8;
+        float    lane_phases[8] = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+        float    lane_steps[8]  = { 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f };
+        memcpy(lane_phases, &io_phases[o], sizeof(float) * lane_count);
+        memcpy(lane_steps, &steps[o], sizeof(float) * lane_count);
+        __m256 phase = _mm256_loadu_ps(lane_phases);
+        __m256 step  = _mm256_loadu_ps(lane_steps);
+
+        TFrameIndex f = 0;
+        for (; f + 8 <= frame_count; f += 8)
+        {
+            __m256 frames[8];
+            for (uint32_t i = 0; i < 8; ++i)
+            {
+                frames[i] = SineAVX2(phase);
+                phase     = NextSinePhaseAVX2(phase, step);
+            }
+            Transpose8x8AVX2(frames);
+            for (uint32_t l = 0; l < lane_count; ++l)
+            {
+                _mm256_storeu_ps(&out_buffers[o + l][f], frames[l]);
+            }
+        }
+        for (; f < frame_count; ++f)
+        {
+            float lane_samples[8];
+            _mm256_storeu_ps(lane_samples, SineAVX2(phase));
+            phase = NextSinePhaseAVX2(phase, step);
+            for (uint32_t l = 0; l < lane_count; ++l)
+            {
+                out_buffers[o + l][f] = lane_samples[l];
+            }
+        }
+        _mm256_storeu_ps(lane_phases, phase);
+        memcpy(&io_phases[o], lane_phases, sizeof(float) * lane_count);
+    }
+}
+#endif
+
+struct SineKernels
+{
+    float (*m_Oscillator)(float* out_buffer, TFrameIndex frame_count, float phase, float step);
+    void (*m_Oscillators)(float* const* out_buffers, uint32_t oscillator_count, TFrameIndex frame_count, float* io_phases, const float* steps);
+};
+
+static SineKernels GetSineKernels(SimdLevel simd_level)
+{
+    SineKernels kernels = { SineOscillatorScalar, SineOscillatorsScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_Oscillator  = SineOscillatorAVX2;
+        kernels.m_Oscillators = SineOscillatorsAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_Oscillator  = SineOscillatorSSE2;
+        kernels.m_Oscillators = SineOscillatorsSSE2;
+    }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
+
+static const SineKernels& GetSineKernels()
+{
+    static const SineKernels kernels = GetSineKernels(GetSimdLevel());
+    return kernels;
+}
+
+float SineOscillator(SimdLevel simd_level, float* out_buffer, uint32_t frame_count, float phase, float step)
+{
+    return GetSineKernels(simd_level).m_Oscillator(out_buffer, frame_count, phase, step);
+}
+
+void SineOscillators(SimdLevel simd_level, float* const* out_buffers, uint32_t oscillator_count, uint32_t frame_count, float* io_phases, const float* steps)
+{
+    GetSineKernels(simd_level).m_Oscillators(out_buffers, oscillator_count, frame_count, io_phases, steps);
+}
+
+static void RenderSine(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    TParameter* parameters         = render_parameters->m_Parameters;
+    float       filtered_frequency = parameters[SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX].m_Float;
+    float       phase              = parameters[SOGO_SINE_PARAMETER_PHASE_INDEX].m_Float;
+    bool        is_playing         = parameters[SOGO_SINE_PARAMETER_PLAYING_INDEX].m_Float != 0.f;
+
+    TFrameIndex       frame_count = render_parameters->m_FrameCount;
+    const EventInput* event_input = render_parameters->m_EventInput;
+    if (!is_playing && (event_input->m_Count == 0 || event_input->m_Events[0].m_FrameOffset >= frame_count))
+    {
+        render_parameters->m_AudioOutputs[0].m_Buffer = 0x0;
+        return;
+    }
+
+    render_parameters->m_AudioOutputs[0].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, 1, frame_count);
+    float* out_buffer                             = render_parameters->m_AudioOutputs[0].m_Buffer;
+
+    EventIterator event_iterator;
+    InitEventIterator(&event_iterator, render_parameters);
+    TFrameIndex      sub_block_offset;
+    TFrameIndex      sub_block_count;
+    const NodeEvent* events;
+    TTriggerCount    event_count;
+    while (NextSubBlock(&event_iterator, &sub_block_offset, &sub_block_count, &events, &event_count))
+    {
+        for (TTriggerCount e = 0; e < event_count; ++e)
+        {
+            if (events[e].m_Type != NodeEvent::TRIGGER)
+            {
+                continue;
+            }
+            if (events[e].m_Index == SOGO_SINE_TRIGGER_START_INDEX)
+            {
+                is_playing = true;
+                phase      = 0.f;
+            }
+            else if (events[e].m_Index == SOGO_SINE_TRIGGER_STOP_INDEX)
+            {
+                is_playing = false;
+            }
+        }
+        float* io_buffer = &out_buffer[sub_block_offset];
+        if (!is_playing)
+        {
+            memset(io_buffer, 0, sizeof(float) * sub_block_count);
+            continue;
+        }
+        float frequency    = parameters[SOGO_SINE_PARAMETER_FREQUENCY_INDEX].m_Float;
+        filtered_frequency = ((frequency * 15) + filtered_frequency) / 16;
+        float step         = filtered_frequency / render_parameters->m_FrameRate;
+        phase              = GetSineKernels().m_Oscillator(io_buffer, sub_block_count, phase, step);
+    }
+    parameters[SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX].m_Float = filtered_frequency;
+    parameters[SOGO_SINE_PARAMETER_PHASE_INDEX].m_Float              = phase;
+    parameters[SOGO_SINE_PARAMETER_PLAYING_INDEX].m_Float            = is_playing ? 1.f : 0.f;
+}
+
+static void RenderSineOscillators(float* const* out_buffers, TParameter* const* parameters, float* phases, const float* steps, uint32_t oscillator_count, TFrameIndex frame_count)
+{
+    GetSineKernels().m_Oscillators(out_buffers, oscillator_count, frame_count, phases, steps);
+    for (uint32_t o = 0; o < oscillator_count; ++o)
+    {
+        parameters[o][SOGO_SINE_PARAMETER_PHASE_INDEX].m_Float = phases[o];
+    }
+}
+
+// Instances that play through the whole batch without events are rendered side by side, one
+// oscillator per lane. The others are rendered one at a time.
+static void RenderSineInstances(const HGraph* graphs, HNode node, const RenderParameters* const* render_parameters, uint32_t instance_count)
+{
+    static const uint32_t OSCILLATOR_COUNT = 32;
+
+    float*      out_buffers[OSCILLATOR_COUNT];
+    float       phases[OSCILLATOR_COUNT];
+    float       steps[OSCILLATOR_COUNT];
+    TParameter* oscillator_parameters[OSCILLATOR_COUNT];
+    uint32_t    oscillator_count = 0;
+    TFrameIndex frame_count      = render_parameters[0]->m_FrameCount;
+    for (uint32_t i = 0; i < instance_count; ++i)
+    {
+        const RenderParameters* instance_parameters = render_parameters[i];
+        TParameter*             parameters          = instance_parameters->m_Parameters;
+        const EventInput*       event_input         = instance_parameters->m_EventInput;
+        bool                    has_events          = event_input->m_Count > 0 && event_input->m_Events[0].m_FrameOffset < frame_count;
+        if (has_events || parameters[SOGO_SINE_PARAMETER_PLAYING_INDEX].m_Float == 0.f)
+        {
+            RenderSine(graphs[i], node, instance_parameters);
+            continue;
+        }
+
+        float frequency                                                  = parameters[SOGO_SINE_PARAMETER_FREQUENCY_INDEX].m_Float;
+        float filtered_frequency                                         = ((frequency * 15) + parameters[SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX].m_Float) / 16;
+        parameters[SOGO_SINE_PARAMETER_FILTERED_FREQUENCY_INDEX].m_Float = filtered_frequency;
+
+        instance_parameters->m_AudioOutputs[0].m_Buffer = instance_parameters->m_AllocateAudioBuffer(graphs[i], node, 1, frame_count);
+        out_buffers[oscillator_count]                   = instance_parameters->m_AudioOutputs[0].m_Buffer;
+        phases[oscillator_count]                        = parameters[SOGO_SINE_PARAMETER_PHASE_INDEX].m_Float;
+        steps[oscillator_count]                         = filtered_frequency / instance_parameters->m_FrameRate;
+        oscillator_parameters[oscillator_count]         = parameters;
+        if (++oscillator_count == OSCILLATOR_COUNT)
+        {
+            RenderSineOscillators(out_buffers, oscillator_parameters, phases, steps, oscillator_count, frame_count);
+            oscillator_count = 0;
+        }
+    }
+    RenderSineOscillators(out_buffers, oscillator_parameters, phases, steps, oscillator_count, frame_count);
+}
+
+static const ParameterDescription SineParameters[SOGO_SINE_PARAMETER_COUNT] = {
+    { "Frequency", 4000.0f },
+    { 0x0, 4000.0f },
+    { 0x0, 0.0f },
+    { 0x0, 1.0f }
+};
+
+static const TriggerDescription SineTriggers[SOGO_SINE_TRIGGER_INPUT_COUNT] = {
+    { "Start" },
+    { "Stop" }
+};
+
+static struct AudioOutputDescription SineNodeAudioOutputDescriptions[SOGO_SINE_AUDIO_OUTPUT_COUNT] = {
+    { AudioOutputDescription::FIXED, { 1 } }
+};
+
+static void SineNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback            = 0;
+    out_node_runtime_desc->m_RenderCallback          = RenderSine;
+    out_node_runtime_desc->m_ContextMemorySize       = 0;
+    out_node_runtime_desc->m_RenderInstancesCallback = RenderSineInstances;
+}
+
+const NodeStaticDescription SineNodeDesc = {
+    SineNodeGetNodeRuntimeDescCallback,
+    SineParameters,
+    SineNodeAudioOutputDescriptions,
+    SineTriggers,
+    SOGO_SINE_AUDIO_INPUT_COUNT,
+    SOGO_SINE_AUDIO_OUTPUT_COUNT,
+    SOGO_SINE_RESOURCE_COUNT,
+    SOGO_SINE_PARAMETER_COUNT,
+    SOGO_SINE_TRIGGER_INPUT_COUNT,
+    SOGO_SINE_TRIGGER_OUTPUT_COUNT,
+    0,
+    { 0 }
+};
+
+///////////////////// SOGO RESAMPLER
+
+// Each quality has a table of RESAMPLER_PHASE_COUNT + 1 rows of tap_count Kaiser windowed sinc
+// coefficients, row r is the filter for a fraction of r / RESAMPLER_PHASE_COUNT. Fractions in
+// between interpolate linearly between two rows.
+static const uint32_t RESAMPLER_PHASE_COUNT = 128;
+
+static const uint32_t RESAMPLER_LOW_TAP_COUNT    = 8;
+static const uint32_t RESAMPLER_MEDIUM_TAP_COUNT = 16;
+static const uint32_t RESAMPLER_HIGH_TAP_COUNT   = 32;
+
+struct ResamplerTables
+{
+    float m_Low[(RESAMPLER_PHASE_COUNT + 1) * RESAMPLER_LOW_TAP_COUNT];
+    float m_Medium[(RESAMPLER_PHASE_COUNT + 1) * RESAMPLER_MEDIUM_TAP_COUNT];
+    float m_High[(RESAMPLER_PHASE_COUNT + 1) * RESAMPLER_HIGH_TAP_COUNT];
+};
+
+static double BesselI0(double x)
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    for (uint32_t k = 1; k < 32; ++k)
+    {
+        term *= (x / (2.0 * k)) * (x / (2.0 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// cutoff is relative to Nyquist, every row is normalized to unity gain at DC
+static void MakeResamplerTable(float* table, uint32_t tap_count, double cutoff, double beta)
+{
+    static const double pi = 3.14159265358979323846;
+
+    double half = tap_count / 2.0;
+    for (uint32_t r = 0; r <= RESAMPLER_PHASE_COUNT; ++r)
+    {
+        float* row = &table[r * tap_count];
+        double sum = 0.0;
+        for (uint32_t k = 0; k < tap_count; ++k)
+        {
+            double x      = (double)k - (half - 1.0) - (double)r / RESAMPLER_PHASE_COUNT;
+            double w      = x / half;
+            double window = w * w < 1.0 ? BesselI0(beta * sqrt(1.0 - w * w)) / BesselI0(beta) : 0.0;
+            double sinc   = x == 0.0 ? 1.0 : sin(pi * cutoff * x) / (pi * cutoff * x);
+            row[k]        = (float)(cutoff * sinc * window);
+            sum += row[k];
+        }
+        for (uint32_t k = 0; k < tap_count; ++k)
+        {
+            row[k] = (float)(row[k] / sum);
+        }
+    }
+}
+
+static ResamplerTables MakeResamplerTables()
+{
+    ResamplerTables tables;
+    MakeResamplerTable(tables.m_Low, RESAMPLER_LOW_TAP_COUNT, 0.80, 5.0);
+    MakeResamplerTable(tables.m_Medium, RESAMPLER_MEDIUM_TAP_COUNT, 0.88, 7.0);
+    MakeResamplerTable(tables.m_High, RESAMPLER_HIGH_TAP_COUNT, 0.94, 9.0);
+    return tables;
+}
+
+static const float* GetResamplerTable(ResamplerQuality quality)
+{
+    static const ResamplerTables tables = MakeResamplerTables();
+    switch (quality)
+    {
+        case RESAMPLER_QUALITY_LOW:
+            return tables.m_Low;
+        case RESAMPLER_QUALITY_MEDIUM:
+            return tables.m_Medium;
+        case RESAMPLER_QUALITY_HIGH:
+            return tables.m_High;
+        default:
+            return 0x0;
+    }
+}
+
+uint32_t GetResamplerTapCount(ResamplerQuality quality)
+{
+    switch (quality)
+    {
+        case RESAMPLER_QUALITY_LOW:
+            return RESAMPLER_LOW_TAP_COUNT;
+        case RESAMPLER_QUALITY_MEDIUM:
+            return RESAMPLER_MEDIUM_TAP_COUNT;
+        case RESAMPLER_QUALITY_HIGH:
+            return RESAMPLER_HIGH_TAP_COUNT;
+        default:
+            return 2;
+    }
+}
+
+static void AdvanceResamplePosition(ResamplePosition* position, uint32_t step_frames, float step_fraction)
+{
+    position->m_Fraction += step_fraction;
+    uint32_t carry = (uint32_t)position->m_Fraction;
+    position->m_Fraction -= (float)carry;
+    position->m_Frame += step_frames + carry;
+}
+
+uint32_t GetResampleInputFrameCount(TFrameIndex frame_count, ResamplerQuality quality, float step, const ResamplePosition* position)
+{
+    if (frame_count == 0)
+    {
+        return 0;
+    }
+    ResamplePosition last          = *position;
+    uint32_t         step_frames   = (uint32_t)step;
+    float            step_fraction = step - (float)step_frames;
+    for (TFrameIndex f = 1; f < frame_count; ++f)
+    {
+        AdvanceResamplePosition(&last, step_frames, step_fraction);
+    }
+    return last.m_Frame + GetResamplerTapCount(quality);
+}
+
+static void ResampleLinear(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, float step, ResamplePosition* position)
+{
+    uint32_t step_frames   = (uint32_t)step;
+    float    step_fraction = step - (float)step_frames;
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        const float* in = &input[position->m_Frame];
+        output[f * output_stride] = in[0] + (in[1] - in[0]) * position->m_Fraction;
+        AdvanceResamplePosition(position, step_frames, step_fraction);
+    }
+}
+
+static void ResampleScalar(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, const float* table, uint32_t tap_count, float step, ResamplePosition* position)
+{
+    uint32_t step_frames   = (uint32_t)step;
+    float    step_fraction = step - (float)step_frames;
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        float        phase = position->m_Fraction * RESAMPLER_PHASE_COUNT;
+        uint32_t     row   = (uint32_t)phase;
+        float        t     = phase - (float)row;
+        const float* r0    = &table[row * tap_count];
+        const float* r1    = r0 + tap_count;
+        const float* in    = &input[position->m_Frame];
+        float        sum   = 0.f;
+        for (uint32_t k = 0; k < tap_count; ++k)
+        {
+            sum += (r0[k] + (r1[k] - r0[k]) * t) * in[k];
+        }
+        output[f * output_stride] = sum;
+        AdvanceResamplePosition(position, step_frames, step_fraction);
+    }
+}
+
+#if SOGO_SIMD_X86
+// Four taps per vector, every tap count is a multiple of eight
+static void ResampleSSE2(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, const float* table, uint32_t tap_count, float step, ResamplePosition* position)
+{
+    uint32_t step_frames   = (uint32_t)step;
+    float    step_fraction = step - (float)step_frames;
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        float        phase = position->m_Fraction * RESAMPLER_PHASE_COUNT;
+        uint32_t     row   = (uint32_t)phase;
+        __m128       t     = _mm_set1_ps(phase - (float)row);
+        const float* r0    = &table[row * tap_count];
+        const float* r1    = r0 + tap_count;
+        const float* in    = &input[position->m_Frame];
+        __m128       sum   = _mm_setzero_ps();
+        for (uint32_t k = 0; k < tap_count; k += 4)
+        {
+            __m128 c0 = _mm_loadu_ps(&r0[k]);
+            __m128 c  = _mm_add_ps(c0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&r1[k]), c0), t));
+            sum       = _mm_add_ps(sum, _mm_mul_ps(c, _mm_loadu_ps(&in[k])));
+        }
+        sum                       = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum                       = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        output[f * output_stride] = _mm_cvtss_f32(sum);
+        AdvanceResamplePosition(position, step_frames, step_fraction);
+    }
+}
+
+SOGO_TARGET_AVX2 static void ResampleAVX2(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, const float* table, uint32_t tap_count, float step, ResamplePosition* position)
+{
+    uint32_t step_frames   = (uint32_t)step;
+    float    step_fraction = step - (float)step_frames;
+    for (TFrameIndex f = 0; f < frame_count; ++f)
+    {
+        float        phase = position->m_Fraction * RESAMPLER_PHASE_COUNT;
+        uint32_t     row   = (uint32_t)phase;
+        __m256       t     = _mm256_set1_ps(phase - (float)row);
+        const float* r0    = &table[row * tap_count];
+        const float* r1    = r0 + tap_count;
+        const float* in    = &input[position->m_Frame];
+        __m256       sum   = _mm256_setzero_ps();
+        for (uint32_t k = 0; k < tap_count; k += 8)
+        {
+            __m256 c0 = _mm256_loadu_ps(&r0[k]);
+            __m256 c  = _mm256_add_ps(c0, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(&r1[k]), c0), t));
+            sum       = _mm256_add_ps(sum, _mm256_mul_ps(c, _mm256_loadu_ps(&in[k])));
+        }
+        __m128 half               = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        half                      = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half                      = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+        output[f * output_stride] = _mm_cvtss_f32(half);
+        AdvanceResamplePosition(position, step_frames, step_fraction);
+    }
+}
+#endif
+
+struct ResamplerKernels
+{
+    void (*m_Resample)(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, const float* table, uint32_t tap_count, float step, ResamplePosition* position);
+};
+
+static ResamplerKernels GetResamplerKernels(SimdLevel simd_level)
+{
+    ResamplerKernels kernels = { ResampleScalar };
+#if SOGO_SIMD_X86
+    if (simd_level == SIMD_LEVEL_AVX2)
+    {
+        kernels.m_Resample = ResampleAVX2;
+    }
+    else if (simd_level == SIMD_LEVEL_SSE2)
+    {
+        kernels.m_Resample = ResampleSSE2;
+    }
+#else
+    (void)simd_level;
+#endif
+    return kernels;
+}
+
+static const ResamplerKernels& GetResamplerKernels()
+{
+    static const ResamplerKernels kernels = GetResamplerKernels(GetSimdLevel());
+    return kernels;
+}
+
+void Resample(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, ResamplerQuality quality, float step, ResamplePosition* position)
+{
+    const float* table = GetResamplerTable(quality);
+    if (table == 0x0)
     {
-        render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_Buffer       = input_data->m_Buffer;
-        render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_ChannelCount = input_data->m_ChannelCount;
-        input_data->m_Buffer                                                         = 0x0;
+        ResampleLinear(output, output_stride, frame_count, input, step, position);
         return;
     }
-    if (input_data->m_ChannelCount != 1)
+    GetResamplerKernels().m_Resample(output, output_stride, frame_count, input, table, GetResamplerTapCount(quality), step, position);
+}
+
+///////////////////// SOGO SAMPLE PLAYER
+
+enum SOGO_SAMPLE_PLAYER_PARAMETERS
+{
+    SOGO_SAMPLE_PLAYER_PARAMETER_SPEED_INDEX,
+    SOGO_SAMPLE_PLAYER_PARAMETER_FRAME_RATE_INDEX,
+    SOGO_SAMPLE_PLAYER_PARAMETER_QUALITY_INDEX,
+    SOGO_SAMPLE_PLAYER_PARAMETER_COUNT
+};
+
+enum SOGO_SAMPLE_PLAYER_RESOURCES
+{
+    SOGO_SAMPLE_PLAYER_RESOURCE_SAMPLE,
+    SOGO_SAMPLE_PLAYER_RESOURCE_COUNT
+};
+
+enum SOGO_SAMPLE_PLAYER_TRIGGER_INPUTS
+{
+    SOGO_SAMPLE_PLAYER_TRIGGER_START_INDEX,
+    SOGO_SAMPLE_PLAYER_TRIGGER_STOP_INDEX,
+    SOGO_SAMPLE_PLAYER_TRIGGER_LOOP_INDEX,
+    SOGO_SAMPLE_PLAYER_TRIGGER_INPUT_COUNT
+};
+
+enum SOGO_SAMPLE_PLAYER_AUDIO_OUTPUTS
+{
+    SOGO_SAMPLE_PLAYER_AUDIO_OUTPUT,
+    SOGO_SAMPLE_PLAYER_AUDIO_OUTPUT_COUNT
+};
+
+enum SamplePlayerState
+{
+    SAMPLE_PLAYER_STOPPED,
+    SAMPLE_PLAYER_PLAYING,
+    SAMPLE_PLAYER_LOOPING
+};
+
+// The position is a whole frame and a fraction, a float alone runs out of fraction bits for long
+// samples and context memory is only aligned for floats
+struct SamplePlayerContext
+{
+    ResamplePosition m_Position;
+    uint32_t         m_State;
+};
+
+// Frames of each channel converted to float for the resampler per pass
+static const uint32_t SAMPLE_PLAYER_WINDOW_FRAME_COUNT = 256;
+
+static float ReadSample(const void* data, uint32_t index, SampleFormat format)
+{
+    if (format == SAMPLE_FORMAT_S16)
+    {
+        return ((const int16_t*)data)[index] * (1.f / 32768.f);
+    }
+    return ((const float*)data)[index];
+}
+
+// Plays from the current position advancing speed frames of the sample per output frame with
+// linear interpolation, returns the number of frames rendered before a non looping sample ended
+static TFrameIndex PlaySample(float* out_buffer, TFrameIndex frame_count, TChannelIndex channel_count, const void* data, uint32_t sample_frame_count, SampleFormat format, float step, SamplePlayerContext* context)
+{
+    bool             is_looping    = context->m_State == SAMPLE_PLAYER_LOOPING;
+    ResamplePosition position      = context->m_Position;
+    uint32_t         step_frames   = (uint32_t)step;
+    float            step_fraction = step - (float)step_frames;
+    for (TFrameIndex f = 0; f < frame_count; ++f)
     {
-        render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_Buffer = 0x0;
+        if (position.m_Frame >= sample_frame_count)
+        {
+            if (!is_looping)
+            {
+                context->m_Position = position;
+                context->m_State    = SAMPLE_PLAYER_STOPPED;
+                return f;
+            }
+            position.m_Frame %= sample_frame_count;
+        }
+        uint32_t index = position.m_Frame;
+        uint32_t next  = index + 1 < sample_frame_count ? index + 1 : (is_looping ? 0 : index);
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            float a       = ReadSample(data, index * channel_count + c, format);
+            float b       = ReadSample(data, next * channel_count + c, format);
+            *out_buffer++ = a + (b - a) * position.m_Fraction;
+        }
+        AdvanceResamplePosition(&position, step_frames, step_fraction);
+    }
+    context->m_Position = position;
+    return frame_count;
+}
+
+// Same as PlaySample but through the polyphase resampler. Each pass converts exactly the sample
+// frames the resampler needs to planar floats, frames outside a non looping sample are silent.
+static TFrameIndex PlaySampleResampled(float* out_buffer, TFrameIndex frame_count, TChannelIndex channel_count, const void* data, uint32_t sample_frame_count, SampleFormat format, ResamplerQuality quality, float step, SamplePlayerContext* context)
+{
+    float    window[SAMPLE_PLAYER_MAX_CHANNEL_COUNT][SAMPLE_PLAYER_WINDOW_FRAME_COUNT];
+    bool     is_looping     = context->m_State == SAMPLE_PLAYER_LOOPING;
+    uint32_t tap_count      = GetResamplerTapCount(quality);
+    int64_t  pre_roll       = tap_count / 2 - 1;
+    uint32_t max_pass_count = step > 0.f ? (uint32_t)((SAMPLE_PLAYER_WINDOW_FRAME_COUNT - tap_count - 2) / step) + 1 : frame_count;
+
+    TFrameIndex rendered_count = 0;
+    while (rendered_count < frame_count)
+    {
+        ResamplePosition* position = &context->m_Position;
+        if (position->m_Frame >= sample_frame_count)
+        {
+            if (!is_looping)
+            {
+                context->m_State = SAMPLE_PLAYER_STOPPED;
+                return rendered_count;
+            }
+            position->m_Frame %= sample_frame_count;
+        }
+        uint32_t pass_count = frame_count - rendered_count;
+        pass_count          = pass_count < max_pass_count ? pass_count : max_pass_count;
+        if (!is_looping && step > 0.f)
+        {
+            uint32_t end_count = (uint32_t)ceilf((sample_frame_count - position->m_Frame - position->m_Fraction) / step);
+            pass_count         = pass_count < end_count ? pass_count : (end_count > 0 ? end_count : 1);
+        }
+
+        ResamplePosition window_position = { 0, position->m_Fraction };
+        uint32_t         input_count     = GetResampleInputFrameCount((TFrameIndex)pass_count, quality, step, &window_position);
+        for (uint32_t i = 0; i < input_count; ++i)
+        {
+            int64_t frame = (int64_t)position->m_Frame - pre_roll + i;
+            if (is_looping)
+            {
+                frame = ((frame % sample_frame_count) + sample_frame_count) % sample_frame_count;
+            }
+            bool is_inside = frame >= 0 && frame < (int64_t)sample_frame_count;
+            for (TChannelIndex c = 0; c < channel_count; ++c)
+            {
+                window[c][i] = is_inside ? ReadSample(data, (uint32_t)frame * channel_count + c, format) : 0.f;
+            }
+        }
+        for (TChannelIndex c = 0; c < channel_count; ++c)
+        {
+            window_position = { 0, position->m_Fraction };
+            Resample(&out_buffer[rendered_count * channel_count + c], channel_count, (TFrameIndex)pass_count, window[c], quality, step, &window_position);
+        }
+        position->m_Frame += window_position.m_Frame;
+        position->m_Fraction = window_position.m_Fraction;
+        rendered_count += (TFrameIndex)pass_count;
+    }
+    return frame_count;
+}
+
+static void InitSamplePlayer(HGraph, HNode, const GraphRuntimeSettings*, TParameter, void* context_memory)
+{
+    memset(context_memory, 0, sizeof(SamplePlayerContext));
+}
+
+// The sample data is only read while playing, a node that is never triggered does not touch it
+static void RenderSamplePlayer(HGraph graph, HNode node, const RenderParameters* render_parameters, SampleFormat format)
+{
+    SamplePlayerContext* context       = (SamplePlayerContext*)render_parameters->m_ContextMemory;
+    AudioOutput*         output_data   = &render_parameters->m_AudioOutputs[SOGO_SAMPLE_PLAYER_AUDIO_OUTPUT];
+    TChannelIndex        channel_count = output_data->m_ChannelCount;
+    TFrameIndex          frame_count   = render_parameters->m_FrameCount;
+    const EventInput*    event_input   = render_parameters->m_EventInput;
+    if (context->m_State == SAMPLE_PLAYER_STOPPED && (event_input->m_Count == 0 || event_input->m_Events[0].m_FrameOffset >= frame_count))
+    {
+        output_data->m_Buffer = 0x0;
         return;
     }
 
-    float* mono_input = input_data->m_Buffer;
+    const Resource* sample             = &render_parameters->m_Resources[SOGO_SAMPLE_PLAYER_RESOURCE_SAMPLE];
+    uint32_t        frame_size         = (uint32_t)channel_count * (format == SAMPLE_FORMAT_S16 ? sizeof(int16_t) : sizeof(float));
+    uint32_t        sample_frame_count = sample->m_Data == 0x0 ? 0 : sample->m_Size / frame_size;
+
+    output_data->m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, channel_count, frame_count);
+    float* out_buffer     = output_data->m_Buffer;
+    if (out_buffer == 0x0)
+    {
+        return;
+    }
+
+    EventIterator event_iterator;
+    InitEventIterator(&event_iterator, render_parameters);
+    TFrameIndex      sub_block_offset;
+    TFrameIndex      sub_block_count;
+    const NodeEvent* events;
+    TTriggerCount    event_count;
+    while (NextSubBlock(&event_iterator, &sub_block_offset, &sub_block_count, &events, &event_count))
+    {
+        for (TTriggerCount e = 0; e < event_count; ++e)
+        {
+            if (events[e].m_Type != NodeEvent::TRIGGER)
+            {
+                continue;
+            }
+            if (events[e].m_Index == SOGO_SAMPLE_PLAYER_TRIGGER_START_INDEX)
+            {
+                context->m_State    = SAMPLE_PLAYER_PLAYING;
+                context->m_Position = ResamplePosition { 0, 0.f };
+            }
+            else if (events[e].m_Index == SOGO_SAMPLE_PLAYER_TRIGGER_LOOP_INDEX)
+            {
+                context->m_State    = SAMPLE_PLAYER_LOOPING;
+                context->m_Position = ResamplePosition { 0, 0.f };
+            }
+            else if (events[e].m_Index == SOGO_SAMPLE_PLAYER_TRIGGER_STOP_INDEX)
+            {
+                context->m_State = SAMPLE_PLAYER_STOPPED;
+            }
+        }
+        if (sample_frame_count == 0)
+        {
+            context->m_State = SAMPLE_PLAYER_STOPPED;
+        }
+        float*      io_buffer    = &out_buffer[sub_block_offset * channel_count];
+        TFrameIndex played_count = 0;
+        if (context->m_State != SAMPLE_PLAYER_STOPPED)
+        {
+            const TParameter* parameters = render_parameters->m_Parameters;
+            float             speed      = parameters[SOGO_SAMPLE_PLAYER_PARAMETER_SPEED_INDEX].m_Float;
+            float             frame_rate = parameters[SOGO_SAMPLE_PLAYER_PARAMETER_FRAME_RATE_INDEX].m_Float;
+            ResamplerQuality  quality    = (ResamplerQuality)parameters[SOGO_SAMPLE_PLAYER_PARAMETER_QUALITY_INDEX].m_Int;
+            float             step       = speed > 0.f ? (frame_rate > 0.f ? speed * frame_rate / render_parameters->m_FrameRate : speed) : 0.f;
+            if (GetResamplerTapCount(quality) > 2)
+            {
+                played_count = PlaySampleResampled(io_buffer, sub_block_count, channel_count, sample->m_Data, sample_frame_count, format, quality, step, context);
+            }
+            else
+            {
+                played_count = PlaySample(io_buffer, sub_block_count, channel_count, sample->m_Data, sample_frame_count, format, step, context);
+            }
+        }
+        memset(&io_buffer[played_count * channel_count], 0, sizeof(float) * channel_count * (sub_block_count - played_count));
+    }
+}
+
+static void RenderSamplePlayerS16(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    RenderSamplePlayer(graph, node, render_parameters, SAMPLE_FORMAT_S16);
+}
+
+static void RenderSamplePlayerFloat(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    RenderSamplePlayer(graph, node, render_parameters, SAMPLE_FORMAT_FLOAT);
+}
+
+static const ParameterDescription SamplePlayerParameters[SOGO_SAMPLE_PLAYER_PARAMETER_COUNT] = {
+    { "Speed", 1.0f },
+    { "FrameRate", 0.0f },
+    { "Quality", 0.0f }
+};
+
+static const TriggerDescription SamplePlayerTriggers[SOGO_SAMPLE_PLAYER_TRIGGER_INPUT_COUNT] = {
+    { "Start" },
+    { "Stop" },
+    { "Loop" }
+};
+
+static void SamplePlayerS16NodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitSamplePlayer;
+    out_node_runtime_desc->m_RenderCallback    = RenderSamplePlayerS16;
+    out_node_runtime_desc->m_ContextMemorySize = sizeof(SamplePlayerContext);
+}
+
+static void SamplePlayerFloatNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitSamplePlayer;
+    out_node_runtime_desc->m_RenderCallback    = RenderSamplePlayerFloat;
+    out_node_runtime_desc->m_ContextMemorySize = sizeof(SamplePlayerContext);
+}
+
+bool MakeSamplePlayerNodeDesc(SampleFormat format, TChannelIndex channel_count, NodeStaticDescription* out_node_static_description)
+{
+    if ((format != SAMPLE_FORMAT_S16 && format != SAMPLE_FORMAT_FLOAT) || channel_count == 0 || channel_count > SAMPLE_PLAYER_MAX_CHANNEL_COUNT)
+    {
+        return false;
+    }
+    out_node_static_description->m_GetNodeRuntimeDescCallback = format == SAMPLE_FORMAT_S16 ? SamplePlayerS16NodeGetNodeRuntimeDescCallback : SamplePlayerFloatNodeGetNodeRuntimeDescCallback;
+    out_node_static_description->m_ParameterDescriptions      = SamplePlayerParameters;
+    out_node_static_description->m_AudioOutputDescriptions    = &FixedAudioOutputDescriptions[channel_count - 1];
+    out_node_static_description->m_Triggers                   = SamplePlayerTriggers;
+    out_node_static_description->m_AudioInputCount            = 0;
+    out_node_static_description->m_AudioOutputCount           = SOGO_SAMPLE_PLAYER_AUDIO_OUTPUT_COUNT;
+    out_node_static_description->m_ResourceCount              = SOGO_SAMPLE_PLAYER_RESOURCE_COUNT;
+    out_node_static_description->m_ParameterCount             = SOGO_SAMPLE_PLAYER_PARAMETER_COUNT;
+    out_node_static_description->m_TriggerInputCount          = SOGO_SAMPLE_PLAYER_TRIGGER_INPUT_COUNT;
+    out_node_static_description->m_TriggerOutputCount         = 0;
+    out_node_static_description->m_Flags                      = 0;
+    out_node_static_description->m_UserData.m_Int             = 0;
+    return true;
+}
+
+///////////////////// SOGO MAKE_STEREO
+
+enum SOGO_TOSTEREO_PARAMETERS
+{
+    SOGO_TOSTEREO_PARAMETER_COUNT
+};
+
+enum SOGO_TOSTEREO_RESOURCES
+{
+    SOGO_TOSTEREO_RESOURCE_COUNT
+};
+
+enum SOGO_TOSTEREO_TRIGGER_INPUTS
+{
+    SOGO_TOSTEREO_TRIGGER_INPUT_COUNT
+};
+
+enum SOGO_TOSTEREO_TRIGGER_OUTPUTS
+{
+    SOGO_TOSTEREO_TRIGGER_OUTPUT_COUNT
+};
+
+enum SOGO_TOSTEREO_AUDIO_INPUTS
+{
+    SOGO_TOSTEREO_AUDIO_INPUT,
+    SOGO_TOSTEREO_AUDIO_INPUT_COUNT
+};
+
+enum SOGO_TOSTEREO_AUDIO_OUTPUTS
+{
+    SOGO_TOSTEREO_AUDIO_OUTPUT,
+    SOGO_TOSTEREO_AUDIO_OUTPUT_COUNT
+};
+
+static void RenderToStereo(HGraph graph, HNode node, const RenderParameters* render_parameters)
+{
+    AudioOutput* input_data = render_parameters->m_AudioInputs[SOGO_TOSTEREO_AUDIO_INPUT].m_AudioOutput;
+    if (input_data == 0x0 || input_data->m_Buffer == 0x0)
+    {
+        render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_Buffer = 0x0;
+        return;
+    }
+    if (input_data->m_ChannelCount != 1 && input_data->m_ChannelCount != 2)
+    {
+        render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_Buffer = 0x0;
+        return;
+    }
 
     TFrameIndex frame_count   = render_parameters->m_FrameCount;
     float*      stereo_output = render_parameters->m_AllocateAudioBuffer(graph, node, 2, frame_count);
 
     render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_Buffer       = stereo_output;
     render_parameters->m_AudioOutputs[SOGO_TOSTEREO_AUDIO_OUTPUT].m_ChannelCount = 2;
+    if (stereo_output == 0x0)
+    {
+        return;
+    }
+
+    // The output is a FIXED buffer of its own, a stereo input is copied rather than passed on
+    if (input_data->m_ChannelCount == 2)
+    {
+        memcpy(stereo_output, input_data->m_Buffer, sizeof(float) * 2 * frame_count);
+        return;
+    }
+
+    float* mono_input = input_data->m_Buffer;
 
     while (frame_count--)
     {
@@ -528,7 +3856,7 @@ static struct AudioOutputDescription ToStereoNodeAudioOutputDescriptions[SOGO_TO
     { AudioOutputDescription::FIXED, { 2 } }
 };
 
-static void ToStereoNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, NodeRuntimeDescription* out_node_runtime_desc)
+static void ToStereoNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
 {
     out_node_runtime_desc->m_InitCallback      = 0;
     out_node_runtime_desc->m_RenderCallback    = RenderToStereo;
@@ -545,7 +3873,9 @@ const NodeStaticDescription ToStereoNodeDesc = {
     SOGO_TOSTEREO_RESOURCE_COUNT,
     SOGO_TOSTEREO_PARAMETER_COUNT,
     SOGO_TOSTEREO_TRIGGER_INPUT_COUNT,
-    SOGO_TOSTEREO_TRIGGER_OUTPUT_COUNT
+    SOGO_TOSTEREO_TRIGGER_OUTPUT_COUNT,
+    NODE_FLAG_SILENT_IN_SILENT_OUT,
+    { 0 }
 };
 
 ///////////////////// SOGO DC
@@ -584,14 +3914,31 @@ enum SOGO_DC_AUDIO_OUTPUTS
 
 static void RenderDC(HGraph graph, HNode node, const RenderParameters* render_parameters)
 {
-    float level = render_parameters->m_Parameters[SOGO_DC_PARAMETER_LEVEL_INDEX].m_Float;
-
     uint32_t frame_count                          = render_parameters->m_FrameCount;
     render_parameters->m_AudioOutputs[0].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, 1, frame_count);
-    float* io_buffer                              = render_parameters->m_AudioOutputs[SOGO_DC_AUDIO_OUTPUT].m_Buffer;
-    while (frame_count--)
+    float* out_buffer                             = render_parameters->m_AudioOutputs[SOGO_DC_AUDIO_OUTPUT].m_Buffer;
+
+    EventIterator event_iterator;
+    InitEventIterator(&event_iterator, render_parameters);
+    TFrameIndex      sub_block_offset;
+    TFrameIndex      sub_block_count;
+    const NodeEvent* events;
+    TTriggerCount    event_count;
+    while (NextSubBlock(&event_iterator, &sub_block_offset, &sub_block_count, &events, &event_count))
     {
-        *io_buffer++ = level;
+        float level = render_parameters->m_Parameters[SOGO_DC_PARAMETER_LEVEL_INDEX].m_Float;
+        if (sub_block_count == frame_count)
+        {
+            // No level change inside the batch, the graph fills out the buffer if a reader needs it
+            out_buffer[0]                                                        = level;
+            render_parameters->m_AudioOutputs[SOGO_DC_AUDIO_OUTPUT].m_IsConstant = true;
+            break;
+        }
+        float* io_buffer = &out_buffer[sub_block_offset];
+        while (sub_block_count--)
+        {
+            *io_buffer++ = level;
+        }
     }
 }
 
@@ -603,7 +3950,7 @@ static struct AudioOutputDescription DCNodeAudioOutputDescriptions[SOGO_DC_AUDIO
     { AudioOutputDescription::FIXED, { 1 } }
 };
 
-static void DCNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, NodeRuntimeDescription* out_node_runtime_desc)
+static void DCNodeGetNodeRuntimeDescCallback(const GraphRuntimeSettings*, TParameter, NodeRuntimeDescription* out_node_runtime_desc)
 {
     out_node_runtime_desc->m_InitCallback      = 0;
     out_node_runtime_desc->m_RenderCallback    = RenderDC;
@@ -620,7 +3967,9 @@ const NodeStaticDescription DCNodeDesc = {
     SOGO_DC_RESOURCE_COUNT,
     SOGO_DC_PARAMETER_COUNT,
     SOGO_DC_TRIGGER_INPUT_COUNT,
-    SOGO_DC_TRIGGER_OUTPUT_COUNT
+    SOGO_DC_TRIGGER_OUTPUT_COUNT,
+    0,
+    { 0 }
 };
 
 #if 0
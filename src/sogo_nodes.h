@@ -4,6 +4,8 @@
 
 namespace sogo {
 
+// The sine and gain nodes have a RenderInstancesCallback and render all instances of an instanced
+// graph in one call, the other built-in nodes render one instance at a time.
 extern const NodeStaticDescription SplitNodeDesc;
 extern const NodeStaticDescription MergeNodeDesc;
 extern const NodeStaticDescription GainNodeDesc;
@@ -12,4 +14,127 @@ extern const NodeStaticDescription ToStereoNodeDesc;
 extern const NodeStaticDescription DCNodeDesc;
 extern const NodeStaticDescription SequentialTriggerDesc;
 
+static const TAudioSocketIndex MIXER_MAX_INPUT_COUNT   = 64;
+static const TChannelIndex     MIXER_MAX_CHANNEL_COUNT = 8;
+
+// Mixes input_count inputs into one output with channel_count channels, input n is scaled by
+// the parameter "Gain<n>", which ramps at 1/32 per frame as the gain node does. Inputs with channel_count channels are added as they are and mono inputs
+// are added to every channel, CreateGraph fails if an input has any other channel count.
+bool MakeMixerNodeDesc(TAudioSocketIndex input_count, TChannelIndex channel_count, NodeStaticDescription* out_node_static_description);
+
+static const TChannelIndex CHANNEL_MATRIX_MAX_CHANNEL_COUNT = 8;
+
+// Standard up and down mix between mono (C), stereo (L R), quad (L R Lb Rb), 5.1 (L R C LFE Ls Rs)
+// and 7.1 (L R C LFE Lb Rb Ls Rs). out_matrix gets output_channel_count rows of input_channel_count
+// coefficients. Returns false for any other channel count.
+bool GetStandardChannelMatrix(TChannelIndex input_channel_count, TChannelIndex output_channel_count, float* out_matrix);
+
+// Converts the input to output_channel_count channels, output channel o is the sum of the input
+// channels i scaled by matrix[o * input_channel_count + i]. The matrix is resource 0, an array of
+// floats sized for the channel count of the input. Without the resource the standard matrix is
+// used. The output is silent if the matrix does not fit the input.
+bool MakeChannelMatrixNodeDesc(TChannelIndex output_channel_count, NodeStaticDescription* out_node_static_description);
+
+static const TChannelIndex BIQUAD_MAX_CHANNEL_COUNT = 8;
+static const uint32_t      BIQUAD_MAX_STAGE_COUNT   = 4;
+
+enum BiquadType
+{
+    BIQUAD_LOW_PASS,
+    BIQUAD_HIGH_PASS,
+    BIQUAD_BAND_PASS,
+    BIQUAD_LOW_SHELF,
+    BIQUAD_HIGH_SHELF,
+    BIQUAD_PEAK
+};
+
+// Filters up to BIQUAD_MAX_CHANNEL_COUNT channels through stage_count identical biquads in series,
+// a filter of order 2 * stage_count. The parameters are "Type" (m_Int, BiquadType), "Frequency"
+// in Hz, "Q" and "Gain" in dB for the shelf and peak types. Coefficients are recomputed only when
+// a parameter changes. The filter keeps rendering its tail after the input goes silent until it
+// has decayed.
+bool MakeBiquadNodeDesc(uint32_t stage_count, NodeStaticDescription* out_node_static_description);
+
+static const TChannelIndex CONVOLUTION_MAX_CHANNEL_COUNT     = 8;
+static const uint32_t      CONVOLUTION_PARTITION_FRAME_COUNT = 512;
+
+// Convolves each channel of the input with the same channel of the impulse response, a mono input
+// feeds every channel. The impulse response is resource 0, made by PrepareConvolutionImpulse with
+// channel_count channels, and may be up to max_impulse_frame_count frames long, partitions past
+// that are ignored. The output is delayed by CONVOLUTION_PARTITION_FRAME_COUNT frames and is
+// silent once the tail has decayed or without a valid impulse response. Returns false if the
+// channels need more than 1024 partitions of CONVOLUTION_PARTITION_FRAME_COUNT frames.
+bool MakeConvolutionNodeDesc(TChannelIndex channel_count, uint32_t max_impulse_frame_count, NodeStaticDescription* out_node_static_description);
+
+// Size of the resource made by PrepareConvolutionImpulse for an impulse response of
+// impulse_frame_count frames with channel_count channels
+uint32_t GetConvolutionImpulseSize(TChannelIndex channel_count, uint32_t impulse_frame_count);
+
+// Computes the spectra of an impulse response of interleaved floats with channel_count channels
+// into out_impulse_mem, aligned to float, which is then the resource of a convolution node. Call it
+// from the thread that sets the resource so the render thread never transforms an impulse response.
+bool PrepareConvolutionImpulse(TChannelIndex channel_count, const float* samples, uint32_t impulse_frame_count, void* out_impulse_mem);
+
+static const TChannelIndex DELAY_MAX_CHANNEL_COUNT    = 8;
+static const uint32_t      DELAY_MAX_TAP_COUNT        = 8;
+static const float         DELAY_MAX_CAPACITY_SECONDS = 32.f;
+
+// Delays the input by "Delay" seconds, modulated by a sine of "Depth" seconds at "Rate" Hz. The
+// output is "Dry" * input + "Wet" * delayed and "Feedback" * delayed is fed back into the delay,
+// the feedback is clamped to [-0.99, 0.99]. With a depth of 0 the delay is a whole number of
+// frames, modulated delays are interpolated. The ring buffer lives in context memory sized from
+// the frame rate, the delay is clamped to max_delay_seconds for inputs with up to channel_count
+// channels. The output has the channel count of the input and keeps rendering the tail after the
+// input goes silent. Returns false if channel_count * max_delay_seconds exceeds
+// DELAY_MAX_CAPACITY_SECONDS.
+bool MakeDelayNodeDesc(TChannelIndex channel_count, float max_delay_seconds, NodeStaticDescription* out_node_static_description);
+
+// Mixes "Dry" * input with tap_count delayed copies of the input, tap n is "Delay<n>" seconds late
+// and scaled by "Gain<n>". The delays are a whole number of frames, otherwise as MakeDelayNodeDesc.
+bool MakeMultiTapDelayNodeDesc(TChannelIndex channel_count, float max_delay_seconds, uint32_t tap_count, NodeStaticDescription* out_node_static_description);
+
+enum ResamplerQuality
+{
+    RESAMPLER_QUALITY_LINEAR,
+    RESAMPLER_QUALITY_LOW,
+    RESAMPLER_QUALITY_MEDIUM,
+    RESAMPLER_QUALITY_HIGH
+};
+
+// A position in the input of the resampler, m_Fraction is in [0, 1)
+struct ResamplePosition
+{
+    uint32_t m_Frame;
+    float    m_Fraction;
+};
+
+// Number of input frames each output frame is filtered from, 2 for RESAMPLER_QUALITY_LINEAR and
+// 8, 16 and 32 for the polyphase qualities
+uint32_t GetResamplerTapCount(ResamplerQuality quality);
+
+// Number of input frames Resample reads for frame_count output frames from position
+uint32_t GetResampleInputFrameCount(TFrameIndex frame_count, ResamplerQuality quality, float step, const ResamplePosition* position);
+
+// Renders frame_count frames of one channel to output[f * output_stride], advancing position by
+// step input frames per output frame. Output frame f is filtered from the tap count frames at
+// input[position->m_Frame], which puts the input frame at m_Frame + tap count / 2 - 1 at the
+// center. The filter cutoff does not follow step, a step above 1 may alias.
+void Resample(float* output, uint32_t output_stride, TFrameIndex frame_count, const float* input, ResamplerQuality quality, float step, ResamplePosition* position);
+
+static const TChannelIndex SAMPLE_PLAYER_MAX_CHANNEL_COUNT = 8;
+
+enum SampleFormat
+{
+    SAMPLE_FORMAT_S16,
+    SAMPLE_FORMAT_FLOAT
+};
+
+// Plays interleaved PCM samples of the given format and channel count straight from resource 0,
+// which may point into a memory mapped file. The data is read in place and only while playing.
+// The triggers are "Start" to play once, "Stop" and "Loop" to play looped, both start from the
+// first frame. The parameter "Speed" scales the playback rate, "FrameRate" is the frame rate of
+// the sample where 0 means the frame rate of the graph, and "Quality" (m_Int, ResamplerQuality)
+// selects linear interpolation or the polyphase resampler.
+bool MakeSamplePlayerNodeDesc(SampleFormat format, TChannelIndex channel_count, NodeStaticDescription* out_node_static_description);
+
 } // namespace sogo
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <stdint.h>
+
+// Internal helpers for the SIMD kernels of the built in nodes. SSE2 is always available on x86-64,
+// AVX2 kernels are compiled per function and only called after checking the CPU at runtime.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#    define SOGO_SIMD_X86 1
+#    include <immintrin.h>
+#    if defined(_MSC_VER)
+#        include <intrin.h>
+#    endif
+#else
+#    define SOGO_SIMD_X86 0
+#endif
+
+#if SOGO_SIMD_X86
+#    if defined(_MSC_VER)
+#        define SOGO_TARGET_AVX2
+#    else
+#        define SOGO_TARGET_AVX2 __attribute__((target("avx2")))
+#    endif
+#endif
+
+namespace sogo {
+
+enum SimdLevel
+{
+    SIMD_LEVEL_SCALAR,
+    SIMD_LEVEL_SSE2,
+    SIMD_LEVEL_AVX2
+};
+
+inline SimdLevel DetectSimdLevel()
+{
+#if SOGO_SIMD_X86
+#    if defined(_MSC_VER)
+    int cpu_info[4];
+    __cpuid(cpu_info, 1);
+    bool has_os_avx = (cpu_info[2] & (1 << 27)) != 0 && (cpu_info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(cpu_info, 7, 0);
+    bool has_avx2 = has_os_avx && (cpu_info[1] & (1 << 5)) != 0;
+#    else
+    __builtin_cpu_init();
+    bool has_avx2 = __builtin_cpu_supports("avx2") != 0;
+#    endif
+    return has_avx2 ? SIMD_LEVEL_AVX2 : SIMD_LEVEL_SSE2;
+#else
+    return SIMD_LEVEL_SCALAR;
+#endif
+}
+
+// Detected once, the kernels of each node are picked when the node type is first used
+inline SimdLevel GetSimdLevel()
+{
+    static const SimdLevel simd_level = DetectSimdLevel();
+    return simd_level;
+}
+
+// The oscillator kernels of the Sine node for simd_level so tests can check that they agree,
+// simd_level must not be above DetectSimdLevel()
+float SineOscillator(SimdLevel simd_level, float* out_buffer, uint32_t frame_count, float phase, float step);
+void  SineOscillators(SimdLevel simd_level, float* const* out_buffers, uint32_t oscillator_count, uint32_t frame_count, float* io_phases, const float* steps);
+
+} // namespace sogo
@@ -232,14 +232,34 @@ bool SetParameter(HAccess access, HGraph graph, TParameterNameHash parameter_has
     return SetParameter(graph, target->m_NodeIndex, target->m_ParameterIndex, value);
 }
 
-bool Trigger(HAccess access, HGraph graph, TTriggerNameHash trigger_hash)
+bool Trigger(HAccess access, HGraph graph, TTriggerNameHash trigger_hash, TFrameIndex frame_offset)
 {
     TriggerTarget* target = access->m_TriggerLookup.Get(trigger_hash);
     if (target == 0x0)
     {
         return false;
     }
-    return Trigger(graph, target->m_NodeIndex, target->m_TriggerIndex);
+    return Trigger(graph, target->m_NodeIndex, target->m_TriggerIndex, frame_offset);
+}
+
+bool PostParameter(HAccess access, HGraph graph, TParameterNameHash parameter_hash, TParameter value, TFrameIndex frame_offset)
+{
+    ParameterTarget* target = access->m_ParameterLookup.Get(parameter_hash);
+    if (target == 0x0)
+    {
+        return false;
+    }
+    return PostParameter(graph, target->m_NodeIndex, target->m_ParameterIndex, value, frame_offset);
+}
+
+bool PostTrigger(HAccess access, HGraph graph, TTriggerNameHash trigger_hash, TFrameIndex frame_offset)
+{
+    TriggerTarget* target = access->m_TriggerLookup.Get(trigger_hash);
+    if (target == 0x0)
+    {
+        return false;
+    }
+    return PostTrigger(graph, target->m_NodeIndex, target->m_TriggerIndex, frame_offset);
 }
 
 } // namespace sogo
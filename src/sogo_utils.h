@@ -24,6 +24,8 @@ TNodeNameHash      MakeNodeNameHash(const char* node_name);
 TParameterNameHash MakeParameterHash(TNodeNameHash node_name_hash, const char* parameter_name);
 bool               SetParameter(HAccess access, HGraph graph, TParameterNameHash parameter_hash, TParameter value);
 TTriggerNameHash   MakeTriggerHash(TNodeNameHash node_name_hash, const char* trigger_name);
-bool               Trigger(HAccess access, HGraph graph, TTriggerNameHash trigger_hash);
+bool               Trigger(HAccess access, HGraph graph, TTriggerNameHash trigger_hash, TFrameIndex frame_offset);
+bool               PostParameter(HAccess access, HGraph graph, TParameterNameHash parameter_hash, TParameter value, TFrameIndex frame_offset);
+bool               PostTrigger(HAccess access, HGraph graph, TTriggerNameHash trigger_hash, TFrameIndex frame_offset);
 
 } // namespace sogo
@@ -1,9 +1,15 @@
 #include "../src/sogo_nodes.h"
+#include "../src/sogo_simd.h"
 #include "../src/sogo_utils.h"
 #include "../third-party/nadir/src/nadir.h"
 #include "../third-party/bikeshed/src/bikeshed.h"
 
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #define ALIGN_SIZE(x, align) (((x) + ((align)-1)) & ~((align)-1))
 
@@ -29,16 +35,110 @@ static void test_teardown(SCtx*)
 {
 }
 
+// The size of an allocation holding all the buffers of a graph, see LayoutGraphBuffers
+static size_t GetGraphBuffersMemSize(const sogo::GraphSize* graph_size)
+{
+    return ALIGN_SIZE(graph_size->m_GraphSize, sizeof(void*)) +
+    (sogo::SCRATCH_BUFFER_ALIGNMENT - 1) +
+    ALIGN_SIZE(graph_size->m_ScratchBufferSize, sogo::SCRATCH_BUFFER_ALIGNMENT) +
+    ALIGN_SIZE(graph_size->m_ConcurrentScratchBufferSize, sogo::SCRATCH_BUFFER_ALIGNMENT) +
+    ALIGN_SIZE(graph_size->m_TriggerBufferSize, sizeof(void*)) +
+    graph_size->m_ContextMemorySize;
+}
+
+// Places the graph at the start of mem and the scratch buffers on SCRATCH_BUFFER_ALIGNMENT
+// boundaries after it so the memory is released with free(mem)
+static void LayoutGraphBuffers(uint8_t* mem, const sogo::GraphSize* graph_size, bool concurrent, sogo::GraphBuffers* out_graph_buffers)
+{
+    uint8_t* scratch_mem            = (uint8_t*)ALIGN_SIZE((uintptr_t)&mem[ALIGN_SIZE(graph_size->m_GraphSize, sizeof(void*))], (uintptr_t)sogo::SCRATCH_BUFFER_ALIGNMENT);
+    uint8_t* concurrent_scratch_mem = &scratch_mem[ALIGN_SIZE(graph_size->m_ScratchBufferSize, sogo::SCRATCH_BUFFER_ALIGNMENT)];
+    uint8_t* trigger_mem            = &concurrent_scratch_mem[ALIGN_SIZE(graph_size->m_ConcurrentScratchBufferSize, sogo::SCRATCH_BUFFER_ALIGNMENT)];
+    uint8_t* context_mem            = &trigger_mem[ALIGN_SIZE(graph_size->m_TriggerBufferSize, sizeof(void*))];
+    out_graph_buffers->m_GraphMem                   = mem;
+    out_graph_buffers->m_ScratchBufferMem           = scratch_mem;
+    out_graph_buffers->m_ConcurrentScratchBufferMem = concurrent ? concurrent_scratch_mem : 0x0;
+    out_graph_buffers->m_TriggerBufferMem           = trigger_mem;
+    out_graph_buffers->m_ContextMem                 = context_mem;
+}
+
+static sogo::HGraph CreateTestGraph(const sogo::GraphDescription* graph_description, const sogo::GraphRuntimeSettings* graph_runtime_settings, uint8_t** out_mem)
+{
+    sogo::GraphSize graph_size;
+    if (!sogo::GetGraphSize(graph_description, graph_runtime_settings, &graph_size))
+    {
+        return 0x0;
+    }
+
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
+    sogo::GraphBuffers graph_buffers;
+    LayoutGraphBuffers(mem, &graph_size, true, &graph_buffers);
+
+    *out_mem = mem;
+    return sogo::CreateGraph(graph_description, graph_runtime_settings, &graph_buffers);
+}
+
+// Builds generator_count DC->Gain generators mixed together with a balanced tree of Merge nodes,
+// a wide and shallow graph where each level can be rendered in parallel
+struct MixerGraphDescription
+{
+    sogo::GraphDescription     m_GraphDescription;
+    sogo::NodeDescription*     m_Nodes;
+    sogo::NodeAudioConnection* m_Connections;
+    sogo::TNodeIndex           m_OutputNodeIndex;
+};
+
+static void MakeMixerGraphDescription(sogo::TNodeIndex generator_count, MixerGraphDescription* out_mixer)
+{
+    sogo::TNodeIndex node_count       = (sogo::TNodeIndex)(generator_count * 2 + (generator_count - 1));
+    uint32_t         connection_count = generator_count + (generator_count - 1) * 2;
+    out_mixer->m_Nodes                = (sogo::NodeDescription*)malloc(sizeof(sogo::NodeDescription) * node_count);
+    out_mixer->m_Connections          = (sogo::NodeAudioConnection*)malloc(sizeof(sogo::NodeAudioConnection) * connection_count);
+    sogo::TNodeIndex* mix_inputs      = (sogo::TNodeIndex*)malloc(sizeof(sogo::TNodeIndex) * node_count);
+
+    sogo::TNodeIndex node_index       = 0;
+    uint32_t         connection_index = 0;
+    sogo::TNodeIndex mix_input_end    = 0;
+    for (sogo::TNodeIndex g = 0; g < generator_count; ++g)
+    {
+        out_mixer->m_Nodes[node_index++]             = { sogo::DCNodeDesc, 0, 0 };
+        out_mixer->m_Connections[connection_index++] = { 0, -1, 0 };
+        mix_inputs[mix_input_end++]                  = node_index;
+        out_mixer->m_Nodes[node_index++]             = { sogo::GainNodeDesc, 1, 0 };
+    }
+    sogo::TNodeIndex mix_input_begin = 0;
+    while (mix_input_end - mix_input_begin > 1)
+    {
+        sogo::TNodeIndex input_1                     = mix_inputs[mix_input_begin++];
+        sogo::TNodeIndex input_2                     = mix_inputs[mix_input_begin++];
+        out_mixer->m_Connections[connection_index++] = { 0, (sogo::TNodeOffset)(input_1 - node_index), 0 };
+        out_mixer->m_Connections[connection_index++] = { 1, (sogo::TNodeOffset)(input_2 - node_index), 0 };
+        mix_inputs[mix_input_end++]                  = node_index;
+        out_mixer->m_Nodes[node_index++]             = { sogo::MergeNodeDesc, 2, 0 };
+    }
+    free(mix_inputs);
+
+    out_mixer->m_GraphDescription = { node_count, out_mixer->m_Nodes, out_mixer->m_Connections, 0x0, 0x0 };
+    out_mixer->m_OutputNodeIndex  = (sogo::TNodeIndex)(node_count - 1);
+}
+
+static void FreeMixerGraphDescription(MixerGraphDescription* mixer)
+{
+    free(mixer->m_Connections);
+    free(mixer->m_Nodes);
+}
+
 static void sogo_create(SCtx*)
 {
     static const sogo::TFrameRate    FRAME_RATE              = 44100;
     static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
     static const sogo::TFrameIndex   BATCH_SIZE              = 64;
     static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
     sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
         FRAME_RATE,
         MAX_BATCH_SIZE,
-        MAX_TRIGGER_EVENT_COUNT
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
     };
     sogo::GraphDescription GRAPH_DESCRIPTION = {
         0,
@@ -49,17 +149,10 @@ static void sogo_create(SCtx*)
     sogo::GraphSize graph_size;
     ASSERT_TRUE(sogo::GetGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_size));
 
-    size_t s = ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) +
-    ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex)) +
-    ALIGN_SIZE(graph_size.m_TriggerBufferSize, 1) +
-    ALIGN_SIZE(graph_size.m_ContextMemorySize, 1);
-    uint8_t* mem = (uint8_t*)malloc(s);
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
     ASSERT_NE(0x0, mem);
     sogo::GraphBuffers graph_buffers;
-    graph_buffers.m_GraphMem         = mem;
-    graph_buffers.m_ScratchBufferMem = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float))];
-    graph_buffers.m_TriggerBufferMem = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) + ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex))];
-    graph_buffers.m_ContextMem       = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) + ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex)) + ALIGN_SIZE(graph_size.m_TriggerBufferSize, 1)];
+    LayoutGraphBuffers(mem, &graph_size, false, &graph_buffers);
 
     sogo::HGraph graph = sogo::CreateGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_buffers);
     TEST_ASSERT_NE(0x0, graph);
@@ -74,10 +167,12 @@ static void sogo_simple_graph(SCtx*)
     static const sogo::TFrameRate    FRAME_RATE              = 44100;
     static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
     static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
     sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
         FRAME_RATE,
         MAX_BATCH_SIZE,
-        MAX_TRIGGER_EVENT_COUNT
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
     };
 
     const char* NODE_NAMES[NODE_COUNT] = {
@@ -132,17 +227,10 @@ static void sogo_simple_graph(SCtx*)
     sogo::GraphSize graph_size;
     ASSERT_TRUE(sogo::GetGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_size));
 
-    size_t s = ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) +
-    ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex)) +
-    ALIGN_SIZE(graph_size.m_TriggerBufferSize, 1) +
-    ALIGN_SIZE(graph_size.m_ContextMemorySize, 1);
-    uint8_t* mem = (uint8_t*)malloc(s);
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
     ASSERT_NE(0x0, mem);
     sogo::GraphBuffers graph_buffers;
-    graph_buffers.m_GraphMem         = mem;
-    graph_buffers.m_ScratchBufferMem = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float))];
-    graph_buffers.m_TriggerBufferMem = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) + ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex))];
-    graph_buffers.m_ContextMem       = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) + ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex)) + ALIGN_SIZE(graph_size.m_TriggerBufferSize, 1)];
+    LayoutGraphBuffers(mem, &graph_size, false, &graph_buffers);
 
     sogo::HGraph graph = sogo::CreateGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_buffers);
     TEST_ASSERT_NE(0x0, graph);
@@ -332,10 +420,12 @@ static void sogo_with_bikeshed(SCtx*)
     static const sogo::TFrameRate    FRAME_RATE              = 44100;
     static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
     static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
     sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
         FRAME_RATE,
         MAX_BATCH_SIZE,
-        MAX_TRIGGER_EVENT_COUNT
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
     };
 
     const char* NODE_NAMES[NODE_COUNT] = {
@@ -390,17 +480,10 @@ static void sogo_with_bikeshed(SCtx*)
     sogo::GraphSize graph_size;
     ASSERT_TRUE(sogo::GetGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_size));
 
-    size_t s = ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) +
-    ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex)) +
-    ALIGN_SIZE(graph_size.m_TriggerBufferSize, 1) +
-    ALIGN_SIZE(graph_size.m_ContextMemorySize, 1);
-    uint8_t* mem = (uint8_t*)malloc(s);
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
     ASSERT_NE(0x0, mem);
     sogo::GraphBuffers graph_buffers;
-    graph_buffers.m_GraphMem         = mem;
-    graph_buffers.m_ScratchBufferMem = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float))];
-    graph_buffers.m_TriggerBufferMem = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) + ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex))];
-    graph_buffers.m_ContextMem       = &mem[ALIGN_SIZE(graph_size.m_GraphSize, sizeof(float)) + ALIGN_SIZE(graph_size.m_ScratchBufferSize, sizeof(sogo::TTriggerSocketIndex)) + ALIGN_SIZE(graph_size.m_TriggerBufferSize, 1)];
+    LayoutGraphBuffers(mem, &graph_size, true, &graph_buffers);
 
     sogo::HGraph graph = sogo::CreateGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_buffers);
     TEST_ASSERT_NE(0x0, graph);
@@ -480,9 +563,3380 @@ static void sogo_with_bikeshed(SCtx*)
     free(graph);
 }
 
+static void sogo_render_order(SCtx*)
+{
+    // Nodes are not written in render order, the generator comes after the node consuming it
+    static const uint32_t            NODE_COUNT              = 2;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    static const uint16_t CONNECTION_COUNT = 1;
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, 1, 0 }
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    sogo::GraphSize graph_size;
+    ASSERT_TRUE(sogo::GetGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_size));
+
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
+    ASSERT_NE(0x0, mem);
+    sogo::GraphBuffers graph_buffers;
+    LayoutGraphBuffers(mem, &graph_size, false, &graph_buffers);
+
+    sogo::HGraph graph = sogo::CreateGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_buffers);
+    TEST_ASSERT_NE(0x0, graph);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 0.5f }));
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        sogo::AudioOutput* render_output = sogo::GetAudioOutput(graph, 0, 0);
+        ASSERT_TRUE(render_output->m_Buffer != 0x0);
+        ASSERT_EQ(1, render_output->m_ChannelCount);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_EQ(0.5f, render_output->m_Buffer[f]);
+        }
+    }
+    free(mem);
+}
+
+static void sogo_scratch_reuse(SCtx*)
+{
+    static const sogo::TNodeIndex    GENERATOR_COUNT         = 128;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    MixerGraphDescription mixer;
+    MakeMixerGraphDescription(GENERATOR_COUNT, &mixer);
+
+    // Each generator and merge allocates a buffer but only a handful are live at the same time
+    sogo::GraphSize graph_size;
+    ASSERT_TRUE(sogo::GetGraphSize(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &graph_size));
+    ASSERT_LT(graph_size.m_ScratchBufferSize * 16, graph_size.m_ConcurrentScratchBufferSize);
+
+    // Concurrently all the generators may render at once but a merge depends on the generators it
+    // mixes and may reuse their ranges
+    ASSERT_LT(graph_size.m_ConcurrentScratchBufferSize, (GENERATOR_COUNT * 2 - 1) * MAX_BATCH_SIZE * sizeof(float));
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    float expected_signal = 0.f;
+    for (sogo::TNodeIndex g = 0; g < GENERATOR_COUNT; ++g)
+    {
+        float level = 1.f / (g + 1);
+        ASSERT_TRUE(sogo::SetParameter(graph, (sogo::TNodeIndex)(g * 2), 0, sogo::TParameter { level }));
+        expected_signal += level;
+    }
+
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        sogo::AudioOutput* render_output = sogo::GetAudioOutput(graph, mixer.m_OutputNodeIndex, 0);
+        ASSERT_TRUE(render_output->m_Buffer != 0x0);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_LT(fabsf(expected_signal - render_output->m_Buffer[f]), 0.0001f);
+        }
+    }
+
+    free(mem);
+    FreeMixerGraphDescription(&mixer);
+}
+
+static uint32_t g_CountingNodeRenderCount = 0;
+
+static void RenderCountingNode(sogo::HGraph, sogo::HNode, const sogo::RenderParameters* render_parameters)
+{
+    ++g_CountingNodeRenderCount;
+    render_parameters->m_AudioOutputs[0].m_Buffer               = render_parameters->m_AudioInputs[0].m_AudioOutput->m_Buffer;
+    render_parameters->m_AudioInputs[0].m_AudioOutput->m_Buffer = 0x0;
+}
+
+static void CountingNodeGetNodeRuntimeDescCallback(const sogo::GraphRuntimeSettings*, sogo::TParameter, sogo::NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = RenderCountingNode;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+static const sogo::AudioOutputDescription CountingNodeAudioOutputDescriptions[1] = {
+    { sogo::AudioOutputDescription::PASS_THROUGH, { 0 } }
+};
+
+static void sogo_silence_skipping(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 3;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription COUNTING_NODE_DESC = {
+        CountingNodeGetNodeRuntimeDescCallback,
+        0x0,
+        CountingNodeAudioOutputDescriptions,
+        0x0,
+        1,
+        1,
+        0,
+        0,
+        0,
+        0,
+        sogo::NODE_FLAG_SILENT_IN_SILENT_OUT,
+        { 0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 2;
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 }
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { COUNTING_NODE_DESC,
+          1,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    g_CountingNodeRenderCount = 0;
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(1u, g_CountingNodeRenderCount);
+    ASSERT_TRUE(!sogo::GetAudioOutput(graph, 2, 0)->m_IsSilent);
+
+    // The gain ramps down during the first batch and is silent from the second batch
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 0.f }));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(2u, g_CountingNodeRenderCount);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        ASSERT_TRUE(sogo::GetAudioOutput(graph, 1, 0)->m_IsSilent);
+        ASSERT_TRUE(sogo::GetAudioOutput(graph, 2, 0)->m_IsSilent);
+        ASSERT_EQ(0x0, sogo::GetAudioOutput(graph, 2, 0)->m_Buffer);
+    }
+    ASSERT_EQ(2u, g_CountingNodeRenderCount);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 1.f }));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(3u, g_CountingNodeRenderCount);
+    ASSERT_TRUE(!sogo::GetAudioOutput(graph, 2, 0)->m_IsSilent);
+
+    free(mem);
+}
+
+static void sogo_command_queue(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 1;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 16;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 30; // Rounded up to 32
+    static const uint32_t            POST_COUNT              = 10000;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    // Commands are applied when the next batch starts
+    ASSERT_TRUE(sogo::PostParameter(graph, 0, 0, sogo::TParameter { 0.5f }, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0.5f, sogo::GetAudioOutput(graph, 0, 0)->m_Buffer[0]);
+
+    // Indexes are checked when posting, the node has one parameter and no triggers or resources
+    sogo::Resource resource = { 0x0, 0 };
+    ASSERT_TRUE(!sogo::PostParameter(graph, 1, 0, sogo::TParameter { 0.5f }, 0));
+    ASSERT_TRUE(!sogo::PostParameter(graph, 0, 1, sogo::TParameter { 0.5f }, 0));
+    ASSERT_TRUE(!sogo::PostTrigger(graph, 0, 0, 0));
+    ASSERT_TRUE(!sogo::PostResource(graph, 0, 0, &resource));
+    for (uint32_t i = 0; i < 32; ++i)
+    {
+        ASSERT_TRUE(sogo::PostParameter(graph, 0, 0, sogo::TParameter { (float)i }, 0));
+    }
+    ASSERT_TRUE(!sogo::PostParameter(graph, 0, 0, sogo::TParameter { 0.f }, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(31.f, sogo::GetAudioOutput(graph, 0, 0)->m_Buffer[0]);
+
+    ASSERT_TRUE(sogo::PostParameter(graph, 0, 0, sogo::TParameter { 0.f }, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+
+    // The game thread posts increasing levels while the audio thread renders, the audio thread
+    // must see them in order and end up with the last one
+    std::thread game_thread([graph]() {
+        for (uint32_t i = 1; i <= POST_COUNT; ++i)
+        {
+            while (!sogo::PostParameter(graph, 0, 0, sogo::TParameter { (float)i }, 0))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    float last_level = 0.f;
+    while (last_level != (float)POST_COUNT)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        float level = sogo::GetAudioOutput(graph, 0, 0)->m_Buffer[0];
+        ASSERT_TRUE(level >= last_level);
+        last_level = level;
+    }
+    game_thread.join();
+
+    free(mem);
+}
+
+static void sogo_timed_events(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 2;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 16;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 4;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { sogo::SineNodeDesc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 1.f }));
+
+    // Events are applied in frame order regardless of the order they were queued in and
+    // events past the end of the batch are carried over to the next batch
+    ASSERT_TRUE(sogo::ScheduleParameter(graph, 0, 0, sogo::TParameter { 3.f }, 10));
+    ASSERT_TRUE(sogo::ScheduleParameter(graph, 0, 0, sogo::TParameter { 2.f }, 5));
+    ASSERT_TRUE(sogo::ScheduleParameter(graph, 0, 0, sogo::TParameter { 4.f }, MAX_BATCH_SIZE + 3));
+    ASSERT_TRUE(sogo::ScheduleParameter(graph, 0, 0, sogo::TParameter { 5.f }, MAX_BATCH_SIZE * 2));
+    ASSERT_TRUE(!sogo::ScheduleParameter(graph, 0, 0, sogo::TParameter { 0.f }, 0));
+    ASSERT_TRUE(!sogo::ScheduleParameter(graph, 0, 1, sogo::TParameter { 0.f }, 0));
+    ASSERT_TRUE(!sogo::Trigger(graph, 0, 0, 0));
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    const float* dc = sogo::GetAudioOutput(graph, 0, 0)->m_Buffer;
+    ASSERT_EQ(1.f, dc[4]);
+    ASSERT_EQ(2.f, dc[5]);
+    ASSERT_EQ(2.f, dc[9]);
+    ASSERT_EQ(3.f, dc[10]);
+    ASSERT_EQ(3.f, dc[MAX_BATCH_SIZE - 1]);
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    dc = sogo::GetAudioOutput(graph, 0, 0)->m_Buffer;
+    ASSERT_EQ(3.f, dc[2]);
+    ASSERT_EQ(4.f, dc[3]);
+    ASSERT_EQ(4.f, dc[MAX_BATCH_SIZE - 1]);
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    dc = sogo::GetAudioOutput(graph, 0, 0)->m_Buffer;
+    ASSERT_EQ(5.f, dc[0]);
+
+    // Stop silences the sine from its frame, a stopped sine outputs silence until started again
+    ASSERT_TRUE(!sogo::Trigger(graph, 1, 2, 0));
+    ASSERT_TRUE(sogo::Trigger(graph, 1, 1, 8));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    const float* sine = sogo::GetAudioOutput(graph, 1, 0)->m_Buffer;
+    ASSERT_NE(0.f, sine[7]);
+    ASSERT_EQ(0.f, sine[8]);
+    ASSERT_EQ(0.f, sine[MAX_BATCH_SIZE - 1]);
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_TRUE(sogo::GetAudioOutput(graph, 1, 0)->m_IsSilent);
+
+    ASSERT_TRUE(sogo::PostTrigger(graph, 1, 0, 4));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    sine = sogo::GetAudioOutput(graph, 1, 0)->m_Buffer;
+    ASSERT_EQ(0.f, sine[3]);
+    ASSERT_EQ(0.f, sine[4]);
+    ASSERT_NE(0.f, sine[5]);
+    ASSERT_NE(0.f, sine[MAX_BATCH_SIZE - 1]);
+
+    free(mem);
+}
+
+static void sogo_profiling(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 3;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { sogo::SineNodeDesc,
+          0,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    sogo::NodeProfile profile;
+    ASSERT_TRUE(!sogo::GetNodeProfile(graph, 0, &profile));
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+
+#if SOGO_PROFILING
+    ASSERT_TRUE(sogo::GetNodeProfile(graph, 1, &profile));
+    ASSERT_EQ(10u, profile.m_BatchCount);
+    ASSERT_TRUE(profile.m_MinTicks > 0);
+    ASSERT_TRUE(profile.m_MinTicks <= profile.m_AverageTicks);
+    ASSERT_TRUE(profile.m_AverageTicks <= profile.m_MaxTicks);
+    ASSERT_TRUE(profile.m_MinTicks <= profile.m_P99Ticks);
+    ASSERT_TRUE(profile.m_P99Ticks <= profile.m_MaxTicks);
+    ASSERT_TRUE(!sogo::GetNodeProfile(graph, NODE_COUNT, &profile));
+
+    // The type profile sums up the nodes of the type for each batch
+    sogo::NodeProfile dc_profile;
+    ASSERT_TRUE(sogo::GetNodeTypeProfile(graph, &sogo::DCNodeDesc, &dc_profile));
+    ASSERT_EQ(10u, dc_profile.m_BatchCount);
+    ASSERT_TRUE(!sogo::GetNodeTypeProfile(graph, &sogo::GainNodeDesc, &dc_profile));
+
+    // Profiles can be read while the graph renders, only the most recent batches are kept
+    std::atomic<bool> is_rendering(true);
+    std::thread       reader([graph, &is_rendering]() {
+        while (is_rendering.load())
+        {
+            sogo::NodeProfile p;
+            sogo::GetNodeTypeProfile(graph, &sogo::SineNodeDesc, &p);
+        }
+    });
+    for (uint32_t i = 0; i < SOGO_PROFILE_BATCH_COUNT * 2; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+    is_rendering.store(false);
+    reader.join();
+
+    ASSERT_TRUE(sogo::GetNodeProfile(graph, 0, &profile));
+    ASSERT_EQ(SOGO_PROFILE_BATCH_COUNT - 1u, profile.m_BatchCount);
+#else
+    ASSERT_TRUE(!sogo::GetNodeProfile(graph, 0, &profile));
+    ASSERT_TRUE(!sogo::GetNodeTypeProfile(graph, &sogo::DCNodeDesc, &profile));
+#endif
+
+    free(mem);
+}
+
+static const sogo::TChannelIndex SURROUND_CHANNEL_COUNT = 6;
+
+static void RenderSurroundNode(sogo::HGraph graph, sogo::HNode node, const sogo::RenderParameters* render_parameters)
+{
+    render_parameters->m_AudioOutputs[0].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, SURROUND_CHANNEL_COUNT, render_parameters->m_FrameCount);
+    float* out_buffer                             = render_parameters->m_AudioOutputs[0].m_Buffer;
+    for (sogo::TFrameIndex f = 0; f < render_parameters->m_FrameCount; ++f)
+    {
+        for (sogo::TChannelIndex c = 0; c < SURROUND_CHANNEL_COUNT; ++c)
+        {
+            *out_buffer++ = (float)(c + 1);
+        }
+    }
+}
+
+static void SurroundNodeGetNodeRuntimeDescCallback(const sogo::GraphRuntimeSettings*, sogo::TParameter, sogo::NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = RenderSurroundNode;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+static const sogo::AudioOutputDescription SurroundNodeAudioOutputDescriptions[1] = {
+    { sogo::AudioOutputDescription::FIXED, { SURROUND_CHANNEL_COUNT } }
+};
+
+static void sogo_surround_gain(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 2;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 61;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription SURROUND_NODE_DESC = {
+        SurroundNodeGetNodeRuntimeDescCallback,
+        0x0,
+        SurroundNodeAudioOutputDescriptions,
+        0x0,
+        0,
+        1,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { 0 }
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { SURROUND_NODE_DESC,
+          0,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 }
+    };
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[1] = {
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    const sogo::AudioOutput* output = sogo::GetAudioOutput(graph, 1, 0);
+    ASSERT_EQ(SURROUND_CHANNEL_COUNT, output->m_ChannelCount);
+    ASSERT_EQ(6.f, output->m_Buffer[MAX_BATCH_SIZE * SURROUND_CHANNEL_COUNT - 1]);
+
+    // Ramps down 1/32 per frame and holds the new gain once reached
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 0.5f }));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    output = sogo::GetAudioOutput(graph, 1, 0);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        float gain = f < 16 ? 1.f - f / 32.f : 0.5f;
+        for (sogo::TChannelIndex c = 0; c < SURROUND_CHANNEL_COUNT; ++c)
+        {
+            ASSERT_TRUE(fabsf(output->m_Buffer[f * SURROUND_CHANNEL_COUNT + c] - gain * (c + 1)) < 0.00001f);
+        }
+    }
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    output = sogo::GetAudioOutput(graph, 1, 0);
+    for (uint32_t s = 0; s < MAX_BATCH_SIZE * SURROUND_CHANNEL_COUNT; ++s)
+    {
+        ASSERT_EQ(0.5f * (s % SURROUND_CHANNEL_COUNT + 1), output->m_Buffer[s]);
+    }
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 0.f }));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_TRUE(sogo::GetAudioOutput(graph, 1, 0)->m_IsSilent);
+
+    free(mem);
+}
+
+static void sogo_sine_accuracy(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 1;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 125;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            BATCH_COUNT             = 64;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    // 44100 / 64 Hz advances the phase exactly 1 / 64 cycle per frame so the error is that of the
+    // polynomial alone. The filtered frequency is set as well so the frequency is constant from
+    // the first frame.
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { FRAME_RATE / 64.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 1, sogo::TParameter { FRAME_RATE / 64.f }));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+
+    float max_error = 0.f;
+    for (uint32_t b = 0; b < BATCH_COUNT; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        const float* sine = sogo::GetAudioOutput(graph, 0, 0)->m_Buffer;
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            double phase = (b * MAX_BATCH_SIZE + f) / 64.0;
+            float  error = (float)fabs(sine[f] - sin(2.0 * 3.14159265358979323846 * (phase - floor(phase))));
+            max_error    = error > max_error ? error : max_error;
+        }
+    }
+    ASSERT_LT(max_error, 0.000005f);
+
+    free(mem);
+}
+
+// The scalar, SSE2 and AVX2 kernels produce the same samples for a single oscillator and for
+// oscillators side by side, including the frames after the last whole vector
+static void sogo_sine_kernels(SCtx*)
+{
+    static const uint32_t FRAME_COUNT      = 125;
+    static const uint32_t OSCILLATOR_COUNT = 11;
+
+    sogo::SimdLevel simd_levels[]    = { sogo::SIMD_LEVEL_SCALAR, sogo::SIMD_LEVEL_SSE2, sogo::SIMD_LEVEL_AVX2 };
+    uint32_t        simd_level_count = (uint32_t)sogo::DetectSimdLevel() + 1;
+
+    float  expected[OSCILLATOR_COUNT][FRAME_COUNT];
+    float  rendered[OSCILLATOR_COUNT][FRAME_COUNT];
+    float* out_buffers[OSCILLATOR_COUNT];
+    float  steps[OSCILLATOR_COUNT];
+    float  expected_phases[OSCILLATOR_COUNT];
+    float  phases[OSCILLATOR_COUNT];
+    for (uint32_t o = 0; o < OSCILLATOR_COUNT; ++o)
+    {
+        steps[o] = (o + 1) / 64.f;
+    }
+
+    float expected_phase = sogo::SineOscillator(sogo::SIMD_LEVEL_SCALAR, expected[0], FRAME_COUNT, 0.f, 1.f / 64.f);
+    for (uint32_t l = 1; l < simd_level_count; ++l)
+    {
+        float phase = sogo::SineOscillator(simd_levels[l], rendered[0], FRAME_COUNT, 0.f, 1.f / 64.f);
+        ASSERT_EQ(expected_phase, phase);
+        for (uint32_t f = 0; f < FRAME_COUNT; ++f)
+        {
+            ASSERT_EQ(expected[0][f], rendered[0][f]);
+        }
+    }
+
+    for (uint32_t o = 0; o < OSCILLATOR_COUNT; ++o)
+    {
+        expected_phases[o] = 0.f;
+        out_buffers[o]     = expected[o];
+    }
+    sogo::SineOscillators(sogo::SIMD_LEVEL_SCALAR, out_buffers, OSCILLATOR_COUNT, FRAME_COUNT, expected_phases, steps);
+    for (uint32_t o = 0; o < OSCILLATOR_COUNT; ++o)
+    {
+        out_buffers[o] = rendered[o];
+    }
+    for (uint32_t l = 1; l < simd_level_count; ++l)
+    {
+        for (uint32_t o = 0; o < OSCILLATOR_COUNT; ++o)
+        {
+            phases[o] = 0.f;
+        }
+        sogo::SineOscillators(simd_levels[l], out_buffers, OSCILLATOR_COUNT, FRAME_COUNT, phases, steps);
+        for (uint32_t o = 0; o < OSCILLATOR_COUNT; ++o)
+        {
+            ASSERT_EQ(expected_phases[o], phases[o]);
+            for (uint32_t f = 0; f < FRAME_COUNT; ++f)
+            {
+                ASSERT_EQ(expected[o][f], rendered[o][f]);
+            }
+        }
+    }
+}
+
+static void sogo_mixer(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 6;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 133;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription SURROUND_NODE_DESC = {
+        SurroundNodeGetNodeRuntimeDescCallback,
+        0x0,
+        SurroundNodeAudioOutputDescriptions,
+        0x0,
+        0,
+        1,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { 0 }
+    };
+
+    sogo::NodeStaticDescription MIXER_NODE_DESC;
+    ASSERT_TRUE(!sogo::MakeMixerNodeDesc(0, 2, &MIXER_NODE_DESC));
+    ASSERT_TRUE(!sogo::MakeMixerNodeDesc(4, sogo::MIXER_MAX_CHANNEL_COUNT + 1, &MIXER_NODE_DESC));
+    ASSERT_TRUE(sogo::MakeMixerNodeDesc(sogo::MIXER_MAX_INPUT_COUNT, 2, &MIXER_NODE_DESC));
+    ASSERT_EQ(0, strcmp("Gain0", MIXER_NODE_DESC.m_ParameterDescriptions[0].m_ParameterName));
+    ASSERT_EQ(0, strcmp("Gain9", MIXER_NODE_DESC.m_ParameterDescriptions[9].m_ParameterName));
+    ASSERT_EQ(0, strcmp("Gain10", MIXER_NODE_DESC.m_ParameterDescriptions[10].m_ParameterName));
+    ASSERT_EQ(0, strcmp("Gain63", MIXER_NODE_DESC.m_ParameterDescriptions[63].m_ParameterName));
+    ASSERT_TRUE(sogo::MakeMixerNodeDesc(4, 2, &MIXER_NODE_DESC));
+
+    sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { sogo::ToStereoNodeDesc,
+          1,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { SURROUND_NODE_DESC,
+          0,
+          0 },
+        { MIXER_NODE_DESC,
+          4,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 5;
+
+    // Mono, stereo, mono and surround into a stereo mixer
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -5, 0 },
+        { 1, -3, 0 },
+        { 2, -2, 0 },
+        { 3, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    // Surround can not be mixed into stereo
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_EQ(0x0, graph);
+    free(mem);
+
+    // Leave the surround output unconnected
+    NODES[5].m_AudioConnectionCount = 3;
+    graph                           = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 1.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 2.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 3, 0, sogo::TParameter { 3.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 5, 1, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::ScheduleParameter(graph, 5, 2, sogo::TParameter { 0.f }, 10));
+
+    // The gains ramp from 1 at 1/32 per frame, the stereo input down to 0.5 from the start and
+    // the second mono input down to 0 from frame 10
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    const sogo::AudioOutput* output = sogo::GetAudioOutput(graph, 5, 0);
+    ASSERT_EQ(2, output->m_ChannelCount);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        float stereo_gain = f < 16 ? 1.f - f / 32.f : 0.5f;
+        float mono_gain   = f < 10 ? 1.f : (f < 42 ? 1.f - (f - 10) / 32.f : 0.f);
+        float expected    = 1.f + 2.f * stereo_gain + 3.f * mono_gain;
+        ASSERT_LT(fabsf(expected - output->m_Buffer[f * 2 + 0]), 0.00001f);
+        ASSERT_LT(fabsf(expected - output->m_Buffer[f * 2 + 1]), 0.00001f);
+    }
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        ASSERT_EQ(2.f, output->m_Buffer[f * 2 + 0]);
+        ASSERT_EQ(2.f, output->m_Buffer[f * 2 + 1]);
+    }
+
+    free(mem);
+}
+
+static void sogo_channel_matrix(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 8;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 133;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription SURROUND_NODE_DESC = {
+        SurroundNodeGetNodeRuntimeDescCallback,
+        0x0,
+        SurroundNodeAudioOutputDescriptions,
+        0x0,
+        0,
+        1,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { 0 }
+    };
+
+    float matrix[SURROUND_CHANNEL_COUNT * 2];
+    ASSERT_TRUE(!sogo::GetStandardChannelMatrix(3, 2, matrix));
+    ASSERT_TRUE(sogo::GetStandardChannelMatrix(1, 2, matrix));
+    ASSERT_EQ(1.f, matrix[0]);
+    ASSERT_EQ(1.f, matrix[1]);
+
+    sogo::NodeStaticDescription MONO_NODE_DESC;
+    sogo::NodeStaticDescription STEREO_NODE_DESC;
+    sogo::NodeStaticDescription SURROUND_MATRIX_NODE_DESC;
+    sogo::NodeStaticDescription SURROUND_71_NODE_DESC;
+    ASSERT_TRUE(!sogo::MakeChannelMatrixNodeDesc(0, &MONO_NODE_DESC));
+    ASSERT_TRUE(!sogo::MakeChannelMatrixNodeDesc(sogo::CHANNEL_MATRIX_MAX_CHANNEL_COUNT + 1, &MONO_NODE_DESC));
+    ASSERT_TRUE(sogo::MakeChannelMatrixNodeDesc(1, &MONO_NODE_DESC));
+    ASSERT_TRUE(sogo::MakeChannelMatrixNodeDesc(2, &STEREO_NODE_DESC));
+    ASSERT_TRUE(sogo::MakeChannelMatrixNodeDesc(6, &SURROUND_MATRIX_NODE_DESC));
+    ASSERT_TRUE(sogo::MakeChannelMatrixNodeDesc(8, &SURROUND_71_NODE_DESC));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { SURROUND_NODE_DESC,
+          0,
+          0 },
+        { STEREO_NODE_DESC,
+          1,
+          0 },
+        { MONO_NODE_DESC,
+          1,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { SURROUND_MATRIX_NODE_DESC,
+          1,
+          0 },
+        { SURROUND_71_NODE_DESC,
+          1,
+          0 },
+        { STEREO_NODE_DESC,
+          1,
+          0 },
+        { SURROUND_MATRIX_NODE_DESC,
+          1,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 6;
+
+    // 5.1 down to stereo and mono, mono up to 5.1, mono through a custom 7.1 matrix,
+    // 5.1 through a matrix of the wrong size and 5.1 to 5.1
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -2, 0 },
+        { 0, -1, 0 },
+        { 0, -2, 0 },
+        { 0, -6, 0 },
+        { 0, -7, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    float                custom_matrix[8]    = { 1.f, 0.f, -1.f, 0.f, 2.f, 0.f, 0.f, 0.5f };
+    const sogo::Resource custom_resource     = { custom_matrix, sizeof(custom_matrix) };
+    const sogo::Resource wrong_size_resource = { custom_matrix, sizeof(float) * 2 };
+    ASSERT_TRUE(sogo::SetResource(graph, 5, 0, &custom_resource));
+    ASSERT_TRUE(sogo::SetResource(graph, 6, 0, &wrong_size_resource));
+    ASSERT_TRUE(sogo::SetParameter(graph, 3, 0, sogo::TParameter { 0.5f }));
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+
+    // Surround channels are 1 to 6, center and surrounds fold into the front at -3 dB
+    const float              minus_3db = 0.70710678f;
+    const float              left      = 1.f + (3.f + 5.f) * minus_3db;
+    const float              right     = 2.f + (3.f + 6.f) * minus_3db;
+    const sogo::AudioOutput* stereo    = sogo::GetAudioOutput(graph, 1, 0);
+    const sogo::AudioOutput* mono      = sogo::GetAudioOutput(graph, 2, 0);
+    const sogo::AudioOutput* upmix     = sogo::GetAudioOutput(graph, 4, 0);
+    const sogo::AudioOutput* custom    = sogo::GetAudioOutput(graph, 5, 0);
+    const sogo::AudioOutput* identity  = sogo::GetAudioOutput(graph, 7, 0);
+    ASSERT_EQ(2, stereo->m_ChannelCount);
+    ASSERT_EQ(1, mono->m_ChannelCount);
+    ASSERT_EQ(6, upmix->m_ChannelCount);
+    ASSERT_EQ(8, custom->m_ChannelCount);
+    ASSERT_EQ(0x0, sogo::GetAudioOutput(graph, 6, 0)->m_Buffer);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        ASSERT_LT(fabsf(left - stereo->m_Buffer[f * 2 + 0]), 0.0001f);
+        ASSERT_LT(fabsf(right - stereo->m_Buffer[f * 2 + 1]), 0.0001f);
+        ASSERT_LT(fabsf(0.5f * (left + right) - mono->m_Buffer[f]), 0.0001f);
+        for (sogo::TChannelIndex c = 0; c < 6; ++c)
+        {
+            ASSERT_EQ(c == 2 ? 0.5f : 0.f, upmix->m_Buffer[f * 6 + c]);
+            ASSERT_EQ((float)(c + 1), identity->m_Buffer[f * 6 + c]);
+        }
+        for (sogo::TChannelIndex c = 0; c < 8; ++c)
+        {
+            ASSERT_EQ(0.5f * custom_matrix[c], custom->m_Buffer[f * 8 + c]);
+        }
+    }
+
+    free(mem);
+}
+
+static void sogo_constant_signal(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 8;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 133;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    sogo::NodeStaticDescription MIXER_NODE_DESC;
+    ASSERT_TRUE(sogo::MakeMixerNodeDesc(2, 2, &MIXER_NODE_DESC));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc, // 0.5
+          0,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { sogo::ToStereoNodeDesc,
+          1,
+          0 },
+        { sogo::DCNodeDesc, // 1
+          0,
+          0 },
+        { sogo::DCNodeDesc, // 2
+          0,
+          0 },
+        { sogo::MergeNodeDesc,
+          2,
+          0 },
+        { sogo::DCNodeDesc, // 3
+          0,
+          0 },
+        { MIXER_NODE_DESC,
+          2,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 6;
+
+    // A constant ramped by a gain into a node that reads samples, constants merged and mixed
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -2, 0 },
+        { 1, -1, 0 },
+        { 0, -2, 0 },
+        { 1, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 2.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 3, 0, sogo::TParameter { 1.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 0, sogo::TParameter { 2.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 6, 0, sogo::TParameter { 3.f }));
+    ASSERT_TRUE(sogo::ScheduleParameter(graph, 7, 0, sogo::TParameter { 0.f }, 10));
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+
+    // Only nodes that handle constant inputs read the DC and the merge
+    ASSERT_TRUE(sogo::GetAudioOutput(graph, 0, 0)->m_IsConstant);
+    ASSERT_TRUE(sogo::GetAudioOutput(graph, 5, 0)->m_IsConstant);
+    ASSERT_EQ(3.f, sogo::GetAudioOutput(graph, 5, 0)->m_Buffer[0]);
+
+    // The ramping gain is filled out by the node, the mixer output is filled out by the graph
+    const sogo::AudioOutput* gain   = sogo::GetAudioOutput(graph, 1, 0);
+    const sogo::AudioOutput* stereo = sogo::GetAudioOutput(graph, 2, 0);
+    const sogo::AudioOutput* mixer  = sogo::GetAudioOutput(graph, 7, 0);
+    ASSERT_TRUE(!gain->m_IsConstant);
+    ASSERT_TRUE(!mixer->m_IsConstant);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        float ramp = stereo->m_Buffer[f * 2 + 0];
+        ASSERT_TRUE(ramp >= 0.5f && ramp <= 1.f);
+        ASSERT_TRUE(f == 0 || ramp >= stereo->m_Buffer[f * 2 - 2]);
+        ASSERT_TRUE(f < 32 || ramp == 1.f);
+        ASSERT_EQ(ramp, stereo->m_Buffer[f * 2 + 1]);
+        float expected = 3.f + 3.f * (f < 10 ? 1.f : (f < 42 ? 1.f - (f - 10) / 32.f : 0.f));
+        ASSERT_LT(fabsf(expected - mixer->m_Buffer[f * 2 + 0]), 0.00001f);
+        ASSERT_LT(fabsf(expected - mixer->m_Buffer[f * 2 + 1]), 0.00001f);
+    }
+
+    // Without changes inside the batch the gain and the mixer render a single frame, the graph
+    // fills out their outputs
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_TRUE(!gain->m_IsConstant);
+    ASSERT_TRUE(!mixer->m_IsConstant);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        ASSERT_EQ(1.f, stereo->m_Buffer[f * 2 + 0]);
+        ASSERT_EQ(1.f, stereo->m_Buffer[f * 2 + 1]);
+        ASSERT_EQ(3.f, mixer->m_Buffer[f * 2 + 0]);
+        ASSERT_EQ(3.f, mixer->m_Buffer[f * 2 + 1]);
+    }
+
+    free(mem);
+}
+
+// Scales channel c by c + 1, reads and writes planar buffers
+static void RenderPlanarScaleNode(sogo::HGraph, sogo::HNode, const sogo::RenderParameters* render_parameters)
+{
+    const sogo::AudioOutput* input  = render_parameters->m_AudioInputs[0].m_AudioOutput;
+    sogo::AudioOutput*       output = &render_parameters->m_AudioOutputs[0];
+    if (input->m_Buffer == 0x0 || !input->m_IsPlanar || !output->m_IsPlanar)
+    {
+        output->m_Buffer = 0x0;
+        return;
+    }
+    for (sogo::TChannelIndex c = 0; c < output->m_ChannelCount; ++c)
+    {
+        for (sogo::TFrameIndex f = 0; f < render_parameters->m_FrameCount; ++f)
+        {
+            output->m_Buffer[c * output->m_ChannelStride + f] = input->m_Buffer[c * input->m_ChannelStride + f] * (float)(c + 1);
+        }
+    }
+}
+
+static void PlanarScaleNodeGetNodeRuntimeDescCallback(const sogo::GraphRuntimeSettings*, sogo::TParameter, sogo::NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = RenderPlanarScaleNode;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+static const sogo::AudioOutputDescription PlanarScaleNodeAudioOutputDescriptions[1] = {
+    { sogo::AudioOutputDescription::PASS_THROUGH, { 0 } }
+};
+
+static void sogo_planar_layout(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 7;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 133;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            WORKER_THREAD_COUNT     = 2;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription SURROUND_NODE_DESC = {
+        SurroundNodeGetNodeRuntimeDescCallback,
+        0x0,
+        SurroundNodeAudioOutputDescriptions,
+        0x0,
+        0,
+        1,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { 0 }
+    };
+
+    const sogo::NodeStaticDescription PLANAR_SCALE_NODE_DESC = {
+        PlanarScaleNodeGetNodeRuntimeDescCallback,
+        0x0,
+        PlanarScaleNodeAudioOutputDescriptions,
+        0x0,
+        1,
+        1,
+        0,
+        0,
+        0,
+        0,
+        sogo::NODE_FLAG_PLANAR,
+        { 0 }
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { SURROUND_NODE_DESC,
+          0,
+          0 },
+        { PLANAR_SCALE_NODE_DESC,
+          1,
+          0 },
+        { PLANAR_SCALE_NODE_DESC,
+          1,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { sogo::MergeNodeDesc,
+          2,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { PLANAR_SCALE_NODE_DESC,
+          1,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 6;
+
+    // The surround is read by a planar and an interleaved node, the planar scale by a planar and
+    // an interleaved node and the constant DC by a planar node
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -2, 0 },
+        { 0, -4, 0 },
+        { 1, -1, 0 },
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+    ASSERT_EQ(NODE_COUNT + 3, sogo::GetRenderJobCount(graph));
+    ASSERT_TRUE(sogo::SetParameter(graph, 5, 0, sogo::TParameter { 2.f }));
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(WORKER_THREAD_COUNT, sogo::GetRenderJobCount(graph)));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, WORKER_THREAD_COUNT, sogo::GetRenderJobCount(graph));
+    ASSERT_NE(0x0, executor);
+
+    for (uint32_t render_mode = 0; render_mode < 3; ++render_mode)
+    {
+        if (render_mode == 0)
+        {
+            sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        }
+        else if (render_mode == 1)
+        {
+            ASSERT_TRUE(sogo::RenderGraphParallel(graph, MAX_BATCH_SIZE, executor));
+        }
+        else
+        {
+            ASSERT_TRUE(sogo::RenderGraphWavefront(graph, MAX_BATCH_SIZE, executor));
+        }
+
+        const sogo::AudioOutput* cube   = sogo::GetAudioOutput(graph, 2, 0);
+        const sogo::AudioOutput* square = sogo::GetAudioOutput(graph, 3, 0);
+        const sogo::AudioOutput* merge  = sogo::GetAudioOutput(graph, 4, 0);
+        const sogo::AudioOutput* dc     = sogo::GetAudioOutput(graph, 6, 0);
+        ASSERT_TRUE(cube->m_IsPlanar);
+        ASSERT_TRUE(!square->m_IsPlanar);
+        ASSERT_TRUE(!merge->m_IsPlanar);
+        ASSERT_TRUE(dc->m_IsPlanar);
+        ASSERT_EQ(0u, cube->m_ChannelStride % 16);
+        ASSERT_TRUE(cube->m_ChannelStride >= MAX_BATCH_SIZE);
+        ASSERT_TRUE(!dc->m_IsConstant);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            for (sogo::TChannelIndex c = 0; c < SURROUND_CHANNEL_COUNT; ++c)
+            {
+                float level = (float)(c + 1);
+                ASSERT_EQ(level * level * level, cube->m_Buffer[c * cube->m_ChannelStride + f]);
+                ASSERT_EQ(level * level, square->m_Buffer[f * SURROUND_CHANNEL_COUNT + c]);
+                ASSERT_EQ(level + level * level, merge->m_Buffer[f * SURROUND_CHANNEL_COUNT + c]);
+            }
+            ASSERT_EQ(2.f, dc->m_Buffer[f]);
+        }
+    }
+
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(mem);
+}
+
+// DC of (c + 1) / 4 per channel plus a full scale signal at Nyquist, needs an even batch size
+static void RenderDCNyquistNode(sogo::HGraph graph, sogo::HNode node, const sogo::RenderParameters* render_parameters)
+{
+    render_parameters->m_AudioOutputs[0].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, SURROUND_CHANNEL_COUNT, render_parameters->m_FrameCount);
+    float* out_buffer                             = render_parameters->m_AudioOutputs[0].m_Buffer;
+    for (sogo::TFrameIndex f = 0; f < render_parameters->m_FrameCount; ++f)
+    {
+        for (sogo::TChannelIndex c = 0; c < SURROUND_CHANNEL_COUNT; ++c)
+        {
+            *out_buffer++ = (float)(c + 1) * 0.25f + ((f & 1) ? -1.f : 1.f);
+        }
+    }
+}
+
+static void DCNyquistNodeGetNodeRuntimeDescCallback(const sogo::GraphRuntimeSettings*, sogo::TParameter, sogo::NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = RenderDCNyquistNode;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+static void sogo_biquad(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 6;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription DC_NYQUIST_NODE_DESC = {
+        DCNyquistNodeGetNodeRuntimeDescCallback,
+        0x0,
+        SurroundNodeAudioOutputDescriptions,
+        0x0,
+        0,
+        1,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { 0 }
+    };
+
+    sogo::NodeStaticDescription biquad_node_descs[sogo::BIQUAD_MAX_STAGE_COUNT];
+    for (uint32_t s = 0; s < sogo::BIQUAD_MAX_STAGE_COUNT; ++s)
+    {
+        ASSERT_TRUE(sogo::MakeBiquadNodeDesc(s + 1, &biquad_node_descs[s]));
+    }
+    sogo::NodeStaticDescription unused_desc;
+    ASSERT_TRUE(!sogo::MakeBiquadNodeDesc(0, &unused_desc));
+    ASSERT_TRUE(!sogo::MakeBiquadNodeDesc(sogo::BIQUAD_MAX_STAGE_COUNT + 1, &unused_desc));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { DC_NYQUIST_NODE_DESC,
+          0,
+          0 },
+        { biquad_node_descs[0],
+          1,
+          0 },
+        { biquad_node_descs[1],
+          1,
+          0 },
+        { biquad_node_descs[0],
+          1,
+          0 },
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { biquad_node_descs[3],
+          1,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 4;
+
+    // Low pass, high pass cascade and low shelf of the DC + Nyquist signal, low pass cascade of
+    // the constant DC
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -2, 0 },
+        { 0, -3, 0 },
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    sogo::TParameter type;
+    type.m_Int = sogo::BIQUAD_HIGH_PASS;
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 0, type));
+    type.m_Int = sogo::BIQUAD_LOW_SHELF;
+    ASSERT_TRUE(sogo::SetParameter(graph, 3, 0, type));
+    ASSERT_TRUE(sogo::SetParameter(graph, 3, 3, sogo::TParameter { 6.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 0, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 5, 1, sogo::TParameter { 200.f }));
+
+    // Long enough for every filter to settle
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+
+    const float               shelf_gain = powf(10.f, 6.f / 20.f);
+    const sogo::AudioOutput* low_pass   = sogo::GetAudioOutput(graph, 1, 0);
+    const sogo::AudioOutput* high_pass  = sogo::GetAudioOutput(graph, 2, 0);
+    const sogo::AudioOutput* low_shelf  = sogo::GetAudioOutput(graph, 3, 0);
+    const sogo::AudioOutput* dc         = sogo::GetAudioOutput(graph, 5, 0);
+    ASSERT_NE(0x0, low_pass->m_Buffer);
+    ASSERT_NE(0x0, high_pass->m_Buffer);
+    ASSERT_NE(0x0, low_shelf->m_Buffer);
+    ASSERT_NE(0x0, dc->m_Buffer);
+    ASSERT_TRUE(!dc->m_IsConstant);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        float nyquist = (f & 1) ? -1.f : 1.f;
+        for (sogo::TChannelIndex c = 0; c < SURROUND_CHANNEL_COUNT; ++c)
+        {
+            float level = (float)(c + 1) * 0.25f;
+            ASSERT_LT(fabsf(low_pass->m_Buffer[f * SURROUND_CHANNEL_COUNT + c] - level), 0.001f);
+            ASSERT_LT(fabsf(high_pass->m_Buffer[f * SURROUND_CHANNEL_COUNT + c] - nyquist), 0.001f);
+            ASSERT_LT(fabsf(low_shelf->m_Buffer[f * SURROUND_CHANNEL_COUNT + c] - (level * shelf_gain + nyquist)), 0.001f);
+        }
+        ASSERT_LT(fabsf(dc->m_Buffer[f] - 0.5f), 0.001f);
+    }
+
+    // Switching the low pass to a band pass removes both the DC and Nyquist
+    type.m_Int = sogo::BIQUAD_BAND_PASS;
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, type));
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+    for (uint32_t i = 0; i < MAX_BATCH_SIZE * SURROUND_CHANNEL_COUNT; ++i)
+    {
+        ASSERT_LT(fabsf(low_pass->m_Buffer[i]), 0.001f);
+    }
+
+    free(mem);
+
+    // A resonant low pass of a sine rings on after the sine stops and goes silent once it has decayed
+    const sogo::NodeDescription TAIL_NODES[2] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 },
+        { biquad_node_descs[1],
+          1,
+          0 }
+    };
+
+    sogo::GraphDescription TAIL_GRAPH_DESCRIPTION = {
+        2,
+        TAIL_NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    graph = CreateTestGraph(&TAIL_GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 440.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 2, sogo::TParameter { 8.f }));
+    const sogo::AudioOutput* tail = sogo::GetAudioOutput(graph, 1, 0);
+    for (uint32_t i = 0; i < 16; ++i)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+    ASSERT_NE(0x0, tail->m_Buffer);
+
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 1, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, sogo::GetAudioOutput(graph, 0, 0)->m_Buffer);
+    ASSERT_NE(0x0, tail->m_Buffer);
+    float tail_peak = 0.f;
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        tail_peak = fabsf(tail->m_Buffer[f]) > tail_peak ? fabsf(tail->m_Buffer[f]) : tail_peak;
+    }
+    ASSERT_LT(0.01f, tail_peak);
+
+    uint32_t tail_batch_count = 1;
+    while (tail->m_Buffer != 0x0 && tail_batch_count < 1000)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        ++tail_batch_count;
+    }
+    ASSERT_EQ(0x0, tail->m_Buffer);
+    ASSERT_LT(2u, tail_batch_count);
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, tail->m_Buffer);
+
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_NE(0x0, tail->m_Buffer);
+
+    free(mem);
+}
+
+static void sogo_sample_player(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 3;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 16;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    sogo::NodeStaticDescription mono_s16_desc;
+    sogo::NodeStaticDescription stereo_float_desc;
+    sogo::NodeStaticDescription mono_float_desc;
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_S16, 1, &mono_s16_desc));
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, 2, &stereo_float_desc));
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, 1, &mono_float_desc));
+    ASSERT_TRUE(!sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, 0, &mono_float_desc));
+    ASSERT_TRUE(!sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, sogo::SAMPLE_PLAYER_MAX_CHANNEL_COUNT + 1, &mono_float_desc));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { mono_s16_desc,
+          0,
+          0 },
+        { stereo_float_desc,
+          0,
+          0 },
+        { mono_float_desc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    // Stands in for memory mapped files, the node reads the samples where they are
+    static const int16_t S16_SAMPLES[4]   = { 0, 8192, 16384, 24576 };
+    static const float   FLOAT_SAMPLES[6] = { 1.f, -1.f, 2.f, -2.f, 3.f, -3.f };
+    sogo::Resource       s16_resource     = { (void*)S16_SAMPLES, sizeof(S16_SAMPLES) };
+    sogo::Resource       float_resource   = { (void*)FLOAT_SAMPLES, sizeof(FLOAT_SAMPLES) };
+    ASSERT_TRUE(sogo::SetResource(graph, 0, 0, &s16_resource));
+    ASSERT_TRUE(sogo::SetResource(graph, 1, 0, &float_resource));
+
+    const sogo::AudioOutput* s16_output   = sogo::GetAudioOutput(graph, 0, 0);
+    const sogo::AudioOutput* float_output = sogo::GetAudioOutput(graph, 1, 0);
+    const sogo::AudioOutput* empty_output = sogo::GetAudioOutput(graph, 2, 0);
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, s16_output->m_Buffer);
+    ASSERT_EQ(0x0, float_output->m_Buffer);
+    ASSERT_EQ(0x0, empty_output->m_Buffer);
+
+    // Half speed plays every sample frame twice, interpolated, and holds the last frame until the end
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 2));
+    ASSERT_TRUE(sogo::Trigger(graph, 1, 2, 0));
+    ASSERT_TRUE(sogo::Trigger(graph, 2, 0, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_NE(0x0, s16_output->m_Buffer);
+    ASSERT_NE(0x0, empty_output->m_Buffer);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        float expected = f < 2 || f >= 10 ? 0.f : (f < 9 ? (f - 2) * 0.125f : 0.75f);
+        ASSERT_LT(fabsf(s16_output->m_Buffer[f] - expected), 0.0001f);
+        ASSERT_EQ((float)(f % 3 + 1), float_output->m_Buffer[f * 2]);
+        ASSERT_EQ(-(float)(f % 3 + 1), float_output->m_Buffer[f * 2 + 1]);
+        ASSERT_EQ(0.f, empty_output->m_Buffer[f]);
+    }
+
+    ASSERT_TRUE(sogo::Trigger(graph, 1, 1, 4));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, s16_output->m_Buffer);
+    ASSERT_EQ(0x0, empty_output->m_Buffer);
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        float expected = f < 4 ? (float)((MAX_BATCH_SIZE + f) % 3 + 1) : 0.f;
+        ASSERT_EQ(expected, float_output->m_Buffer[f * 2]);
+        ASSERT_EQ(-expected, float_output->m_Buffer[f * 2 + 1]);
+    }
+
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, float_output->m_Buffer);
+
+    free(mem);
+}
+
+static void sogo_resampler(SCtx*)
+{
+    static const uint32_t          INPUT_FRAME_COUNT = 256;
+    static const sogo::TFrameIndex OUTPUT_COUNT      = 200;
+    static const float             STEP              = 0.5f;
+    static const float             PI                = 3.14159265f;
+
+    // 1 kHz at 22050 Hz resampled to 44100 Hz
+    float input[INPUT_FRAME_COUNT];
+    for (uint32_t i = 0; i < INPUT_FRAME_COUNT; ++i)
+    {
+        input[i] = sinf(2.f * PI * 1000.f * i / 22050.f);
+    }
+
+    const sogo::ResamplerQuality QUALITIES[4] = { sogo::RESAMPLER_QUALITY_LINEAR, sogo::RESAMPLER_QUALITY_LOW, sogo::RESAMPLER_QUALITY_MEDIUM, sogo::RESAMPLER_QUALITY_HIGH };
+    const float                  MAX_ERROR[4] = { 0.01f, 0.01f, 0.002f, 0.001f };
+    for (uint32_t q = 0; q < 4; ++q)
+    {
+        uint32_t               tap_count = sogo::GetResamplerTapCount(QUALITIES[q]);
+        sogo::ResamplePosition position  = { 0, 0.25f };
+        uint32_t               needed    = sogo::GetResampleInputFrameCount(OUTPUT_COUNT, QUALITIES[q], STEP, &position);
+        ASSERT_EQ(99 + tap_count, needed);
+        ASSERT_TRUE(needed <= INPUT_FRAME_COUNT);
+
+        float output[OUTPUT_COUNT * 2];
+        sogo::Resample(&output[1], 2, OUTPUT_COUNT, input, QUALITIES[q], STEP, &position);
+        ASSERT_EQ(100u, position.m_Frame);
+        ASSERT_EQ(0.25f, position.m_Fraction);
+        for (sogo::TFrameIndex f = 0; f < OUTPUT_COUNT; ++f)
+        {
+            float input_frame = 0.25f + f * STEP + (tap_count / 2 - 1);
+            float expected    = sinf(2.f * PI * 1000.f * input_frame / 22050.f);
+            ASSERT_LT(fabsf(output[f * 2 + 1] - expected), MAX_ERROR[q]);
+        }
+
+        // Every row has unity gain at DC
+        float ones[INPUT_FRAME_COUNT];
+        for (uint32_t i = 0; i < INPUT_FRAME_COUNT; ++i)
+        {
+            ones[i] = 1.f;
+        }
+        position = { 0, 0.f };
+        sogo::Resample(output, 1, OUTPUT_COUNT, ones, QUALITIES[q], 0.93f, &position);
+        for (sogo::TFrameIndex f = 0; f < OUTPUT_COUNT; ++f)
+        {
+            ASSERT_LT(fabsf(output[f] - 1.f), 0.0001f);
+        }
+    }
+
+    // The sample player plays a 22050 Hz sample in a 44100 Hz graph
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 100;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    sogo::NodeStaticDescription sample_player_desc;
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, 1, &sample_player_desc));
+
+    const sogo::NodeDescription NODES[1] = {
+        { sample_player_desc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        1,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    sogo::Resource   sample = { input, sizeof(input) };
+    sogo::TParameter quality;
+    quality.m_Int = sogo::RESAMPLER_QUALITY_HIGH;
+    ASSERT_TRUE(sogo::SetResource(graph, 0, 0, &sample));
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 1, sogo::TParameter { 22050.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 2, quality));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+
+    const sogo::AudioOutput* output = sogo::GetAudioOutput(graph, 0, 0);
+    for (uint32_t b = 0; b < 6; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        ASSERT_NE(0x0, output->m_Buffer);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            // Away from the silence before the start and after the end of the sample
+            uint32_t frame       = b * MAX_BATCH_SIZE + f;
+            float    input_frame = frame * STEP;
+            if (input_frame >= INPUT_FRAME_COUNT)
+            {
+                ASSERT_EQ(0.f, output->m_Buffer[f]);
+            }
+            else if (input_frame >= 16.f && input_frame < INPUT_FRAME_COUNT - 16)
+            {
+                ASSERT_LT(fabsf(output->m_Buffer[f] - sinf(2.f * PI * 1000.f * input_frame / 22050.f)), 0.001f);
+            }
+        }
+    }
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, output->m_Buffer);
+
+    free(mem);
+}
+
+static void sogo_convolution(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 2;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 100;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            INPUT_FRAME_COUNT       = 300;
+    static const uint32_t            IMPULSE_FRAME_COUNT     = 1500;
+    static const uint32_t            LATENCY                 = sogo::CONVOLUTION_PARTITION_FRAME_COUNT;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    sogo::NodeStaticDescription sample_player_desc;
+    sogo::NodeStaticDescription convolution_desc;
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, 1, &sample_player_desc));
+    ASSERT_TRUE(sogo::MakeConvolutionNodeDesc(2, IMPULSE_FRAME_COUNT, &convolution_desc));
+    ASSERT_TRUE(!sogo::MakeConvolutionNodeDesc(0, IMPULSE_FRAME_COUNT, &convolution_desc));
+    ASSERT_TRUE(!sogo::MakeConvolutionNodeDesc(2, 1024 * sogo::CONVOLUTION_PARTITION_FRAME_COUNT, &convolution_desc));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sample_player_desc,
+          0,
+          0 },
+        { convolution_desc,
+          1,
+          0 }
+    };
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[1] = {
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    // A noise burst through a noise impulse response of three partitions, the mono input feeds both channels
+    static float input[INPUT_FRAME_COUNT];
+    static float impulse[IMPULSE_FRAME_COUNT * 2];
+    uint32_t     seed = 1;
+    for (uint32_t i = 0; i < INPUT_FRAME_COUNT; ++i)
+    {
+        seed     = seed * 1664525u + 1013904223u;
+        input[i] = (float)(seed >> 8) / (float)(1u << 23) - 1.f;
+    }
+    for (uint32_t i = 0; i < IMPULSE_FRAME_COUNT * 2; ++i)
+    {
+        seed       = seed * 1664525u + 1013904223u;
+        impulse[i] = ((float)(seed >> 8) / (float)(1u << 23) - 1.f) * 0.1f;
+    }
+    uint32_t prepared_impulse_size = sogo::GetConvolutionImpulseSize(2, IMPULSE_FRAME_COUNT);
+    void*    prepared_impulse      = malloc(prepared_impulse_size);
+    ASSERT_TRUE(!sogo::PrepareConvolutionImpulse(0, impulse, IMPULSE_FRAME_COUNT, prepared_impulse));
+    ASSERT_TRUE(sogo::PrepareConvolutionImpulse(2, impulse, IMPULSE_FRAME_COUNT, prepared_impulse));
+
+    // The node is silent without a prepared impulse response for its channel count
+    sogo::Resource input_resource   = { input, sizeof(input) };
+    sogo::Resource impulse_resource = { prepared_impulse, prepared_impulse_size - 1 };
+    ASSERT_TRUE(sogo::SetResource(graph, 0, 0, &input_resource));
+    ASSERT_TRUE(sogo::SetResource(graph, 1, 0, &impulse_resource));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+    const sogo::AudioOutput* output = sogo::GetAudioOutput(graph, 1, 0);
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_EQ(0x0, output->m_Buffer);
+
+    // Restart the input with the whole impulse response
+    impulse_resource.m_Size = prepared_impulse_size;
+    ASSERT_TRUE(sogo::SetResource(graph, 1, 0, &impulse_resource));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+
+    uint32_t                 batch_count = (LATENCY + INPUT_FRAME_COUNT + IMPULSE_FRAME_COUNT) / MAX_BATCH_SIZE + 1;
+    for (uint32_t b = 0; b < batch_count; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        ASSERT_NE(0x0, output->m_Buffer);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            int32_t frame = (int32_t)(b * MAX_BATCH_SIZE + f) - (int32_t)LATENCY;
+            for (uint32_t c = 0; c < 2; ++c)
+            {
+                float expected = 0.f;
+                for (int32_t k = 0; k < (int32_t)IMPULSE_FRAME_COUNT; ++k)
+                {
+                    int32_t i = frame - k;
+                    if (i >= 0 && i < (int32_t)INPUT_FRAME_COUNT)
+                    {
+                        expected += impulse[k * 2 + c] * input[i];
+                    }
+                }
+                ASSERT_LT(fabsf(output->m_Buffer[f * 2 + c] - expected), 0.0001f);
+            }
+        }
+    }
+
+    // The tail has decayed after passing through every partition
+    for (uint32_t b = 0; b < 4 * LATENCY / MAX_BATCH_SIZE + 1; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+    ASSERT_EQ(0x0, output->m_Buffer);
+
+    // A batch larger than the plan gets no buffers, both nodes leave their outputs silent
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    ASSERT_NE(0x0, output->m_Buffer);
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE * 2);
+    ASSERT_EQ(0x0, sogo::GetAudioOutput(graph, 0, 0)->m_Buffer);
+    ASSERT_EQ(0x0, output->m_Buffer);
+
+    free(prepared_impulse);
+    free(mem);
+}
+
+// Renders the frame index since the graph was created / 1000
+static void RenderRampNode(sogo::HGraph graph, sogo::HNode node, const sogo::RenderParameters* render_parameters)
+{
+    uint32_t* frame_index                         = (uint32_t*)render_parameters->m_ContextMemory;
+    render_parameters->m_AudioOutputs[0].m_Buffer = render_parameters->m_AllocateAudioBuffer(graph, node, 1, render_parameters->m_FrameCount);
+    for (sogo::TFrameIndex f = 0; f < render_parameters->m_FrameCount; ++f)
+    {
+        render_parameters->m_AudioOutputs[0].m_Buffer[f] = (float)(*frame_index)++ * 0.001f;
+    }
+}
+
+static void InitRampNode(sogo::HGraph, sogo::HNode, const sogo::GraphRuntimeSettings*, sogo::TParameter, void* context_memory)
+{
+    *(uint32_t*)context_memory = 0;
+}
+
+static void RampNodeGetNodeRuntimeDescCallback(const sogo::GraphRuntimeSettings*, sogo::TParameter, sogo::NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = InitRampNode;
+    out_node_runtime_desc->m_RenderCallback    = RenderRampNode;
+    out_node_runtime_desc->m_ContextMemorySize = sizeof(uint32_t);
+}
+
+static const sogo::AudioOutputDescription RampNodeAudioOutputDescriptions[1] = {
+    { sogo::AudioOutputDescription::FIXED, { 1 } }
+};
+
+static void sogo_delay(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 5;
+    static const sogo::TFrameRate    FRAME_RATE              = 1000;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 32;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription RAMP_NODE_DESC = {
+        RampNodeGetNodeRuntimeDescCallback,
+        0x0,
+        RampNodeAudioOutputDescriptions,
+        0x0,
+        0,
+        1,
+        0,
+        0,
+        0,
+        0,
+        0,
+        { 0 }
+    };
+
+    sogo::NodeStaticDescription sample_player_desc;
+    sogo::NodeStaticDescription delay_desc;
+    sogo::NodeStaticDescription multi_tap_delay_desc;
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_FLOAT, 1, &sample_player_desc));
+    ASSERT_TRUE(!sogo::MakeDelayNodeDesc(0, 1.f, &delay_desc));
+    ASSERT_TRUE(!sogo::MakeDelayNodeDesc(2, 100.f, &delay_desc));
+    ASSERT_TRUE(!sogo::MakeMultiTapDelayNodeDesc(1, 1.f, sogo::DELAY_MAX_TAP_COUNT + 1, &multi_tap_delay_desc));
+    ASSERT_TRUE(sogo::MakeDelayNodeDesc(1, 0.2f, &delay_desc));
+    ASSERT_TRUE(sogo::MakeMultiTapDelayNodeDesc(1, 0.2f, 2, &multi_tap_delay_desc));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sample_player_desc,
+          0,
+          0 },
+        { delay_desc,
+          1,
+          0 },
+        { multi_tap_delay_desc,
+          1,
+          0 },
+        { RAMP_NODE_DESC,
+          0,
+          0 },
+        { delay_desc,
+          1,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 3;
+
+    // An impulse through an echo and a multi tap delay, a ramp through a modulated delay
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -2, 0 },
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    static const float impulse[1]        = { 1.f };
+    sogo::Resource     impulse_resource = { (void*)impulse, sizeof(impulse) };
+    ASSERT_TRUE(sogo::SetResource(graph, 0, 0, &impulse_resource));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 0, sogo::TParameter { 0.05f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 1, 3, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 0, sogo::TParameter { 0.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 2, sogo::TParameter { 0.02f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 3, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 4, sogo::TParameter { 0.07f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 5, sogo::TParameter { -0.25f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 0, sogo::TParameter { 0.03f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 1, sogo::TParameter { 0.01f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 2, sogo::TParameter { 3.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 4, sogo::TParameter { 0.f }));
+
+    const sogo::AudioOutput* echo      = sogo::GetAudioOutput(graph, 1, 0);
+    const sogo::AudioOutput* multi_tap = sogo::GetAudioOutput(graph, 2, 0);
+    const sogo::AudioOutput* modulated = sogo::GetAudioOutput(graph, 4, 0);
+    double                   phase     = 0.0;
+    for (uint32_t b = 0; b < 8; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        ASSERT_NE(0x0, echo->m_Buffer);
+        ASSERT_NE(0x0, multi_tap->m_Buffer);
+        ASSERT_NE(0x0, modulated->m_Buffer);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            uint32_t frame          = b * MAX_BATCH_SIZE + f;
+            float    expected_echo  = frame % 50 == 0 ? powf(0.5f, frame < 50 ? 0.f : (float)(frame / 50 - 1)) : 0.f;
+            float    expected_taps  = frame == 20 ? 0.5f : (frame == 70 ? -0.25f : 0.f);
+            ASSERT_LT(fabsf(echo->m_Buffer[f] - expected_echo), 0.00001f);
+            ASSERT_LT(fabsf(multi_tap->m_Buffer[f] - expected_taps), 0.00001f);
+
+            // A ramp read at a fractional delay is exact with linear interpolation
+            double delay = 30.0 + 10.0 * sin(6.283185307179586 * phase);
+            phase += 3.0 / FRAME_RATE;
+            if (frame >= 40)
+            {
+                ASSERT_LT(fabsf(modulated->m_Buffer[f] - (float)((frame - delay) * 0.001)), 0.0001f);
+            }
+        }
+    }
+
+    // The echo decays and the multi tap delay empties, then both go silent
+    for (uint32_t b = 0; b < 100; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+    ASSERT_EQ(0x0, echo->m_Buffer);
+    ASSERT_EQ(0x0, multi_tap->m_Buffer);
+    ASSERT_NE(0x0, modulated->m_Buffer);
+
+    free(mem);
+}
+
+static sogo::HInstancedGraph CreateTestInstancedGraph(const sogo::GraphDescription* graph_description, const sogo::GraphRuntimeSettings* graph_runtime_settings, uint32_t instance_count, uint8_t** out_mem)
+{
+    sogo::GraphSize graph_size;
+    if (!sogo::GetInstancedGraphSize(graph_description, graph_runtime_settings, instance_count, &graph_size))
+    {
+        return 0x0;
+    }
+
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
+    sogo::GraphBuffers graph_buffers;
+    LayoutGraphBuffers(mem, &graph_size, false, &graph_buffers);
+
+    *out_mem = mem;
+    return sogo::CreateInstancedGraph(graph_description, graph_runtime_settings, instance_count, &graph_buffers);
+}
+
+static void sogo_instanced_graph(SCtx*)
+{
+    static const uint32_t            INSTANCE_COUNT          = 13;
+    static const uint32_t            NODE_COUNT              = 2;
+    static const sogo::TFrameRate    FRAME_RATE              = 48000;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 64;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 8;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 8;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 }
+    };
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[1] = {
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    sogo::GraphSize graph_size;
+    ASSERT_TRUE(!sogo::GetInstancedGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, 0, &graph_size));
+
+    uint8_t*              mem             = 0x0;
+    sogo::HInstancedGraph instanced_graph = CreateTestInstancedGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, INSTANCE_COUNT, &mem);
+    ASSERT_NE(0x0, instanced_graph);
+    ASSERT_EQ(0x0, sogo::GetInstance(instanced_graph, INSTANCE_COUNT));
+    ASSERT_TRUE(!sogo::SetInstanceActive(instanced_graph, INSTANCE_COUNT, true));
+
+    // Every instance is compared to a graph of its own with the same parameters
+    uint8_t*     reference_mem[INSTANCE_COUNT];
+    sogo::HGraph reference_graphs[INSTANCE_COUNT];
+    for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        reference_graphs[i] = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &reference_mem[i]);
+        ASSERT_NE(0x0, reference_graphs[i]);
+        sogo::HGraph instance = sogo::GetInstance(instanced_graph, i);
+        ASSERT_NE(0x0, instance);
+        if (i == 5)
+        {
+            continue;
+        }
+        ASSERT_TRUE(sogo::SetInstanceActive(instanced_graph, i, true));
+        sogo::HGraph graphs[2] = { instance, reference_graphs[i] };
+        for (uint32_t g = 0; g < 2; ++g)
+        {
+            ASSERT_TRUE(sogo::SetParameter(graphs[g], 0, 0, sogo::TParameter { 100.f + 37.f * i }));
+            ASSERT_TRUE(sogo::SetParameter(graphs[g], 1, 0, sogo::TParameter { 0.5f + 0.01f * i }));
+            if (i == 3)
+            {
+                ASSERT_TRUE(sogo::Trigger(graphs[g], 0, 1, MAX_BATCH_SIZE + 10));
+            }
+        }
+    }
+
+    for (uint32_t b = 0; b < 16; ++b)
+    {
+        if (b == 8)
+        {
+            // Deactivated and activated again, the instance starts over with the initial parameters
+            ASSERT_TRUE(sogo::SetInstanceActive(instanced_graph, 2, false));
+            sogo::RenderInstancedGraph(instanced_graph, MAX_BATCH_SIZE);
+            ASSERT_EQ(0x0, sogo::GetAudioOutput(sogo::GetInstance(instanced_graph, 2), 1, 0)->m_Buffer);
+            ASSERT_TRUE(sogo::SetInstanceActive(instanced_graph, 2, true));
+            free(reference_mem[2]);
+            reference_graphs[2] = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &reference_mem[2]);
+            for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+            {
+                if (i != 2)
+                {
+                    sogo::RenderGraph(reference_graphs[i], MAX_BATCH_SIZE);
+                }
+            }
+        }
+        sogo::RenderInstancedGraph(instanced_graph, MAX_BATCH_SIZE);
+        for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+        {
+            sogo::RenderGraph(reference_graphs[i], MAX_BATCH_SIZE);
+            const sogo::AudioOutput* output = sogo::GetAudioOutput(sogo::GetInstance(instanced_graph, i), 1, 0);
+            if (i == 5)
+            {
+                ASSERT_EQ(0x0, output->m_Buffer);
+                continue;
+            }
+            const sogo::AudioOutput* reference_output = sogo::GetAudioOutput(reference_graphs[i], 1, 0);
+            if (i == 3 && b > 1)
+            {
+                ASSERT_EQ(0x0, output->m_Buffer);
+                ASSERT_EQ(0x0, reference_output->m_Buffer);
+                continue;
+            }
+            ASSERT_NE(0x0, output->m_Buffer);
+            ASSERT_NE(0x0, reference_output->m_Buffer);
+            for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+            {
+                ASSERT_LT(fabsf(output->m_Buffer[f] - reference_output->m_Buffer[f]), 0.0001f);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        free(reference_mem[i]);
+    }
+    free(mem);
+}
+
+static sogo::HGraph InstantiateTestGraph(sogo::HGraphPrototype prototype, uint8_t** out_mem)
+{
+    sogo::GraphSize graph_size;
+    sogo::GetPrototypeGraphSize(prototype, &graph_size);
+
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
+    sogo::GraphBuffers graph_buffers;
+    LayoutGraphBuffers(mem, &graph_size, true, &graph_buffers);
+
+    *out_mem = mem;
+    return sogo::InstantiateGraph(prototype, &graph_buffers);
+}
+
+static void sogo_graph_prototype(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 5;
+    static const sogo::TFrameRate    FRAME_RATE              = 48000;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 64;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 8;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 8;
+    static const uint32_t            WORKER_THREAD_COUNT     = 2;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription PLANAR_SCALE_NODE_DESC = {
+        PlanarScaleNodeGetNodeRuntimeDescCallback,
+        0x0,
+        PlanarScaleNodeAudioOutputDescriptions,
+        0x0,
+        1,
+        1,
+        0,
+        0,
+        0,
+        0,
+        sogo::NODE_FLAG_PLANAR,
+        { 0 }
+    };
+
+    sogo::NodeStaticDescription delay_desc;
+    ASSERT_TRUE(sogo::MakeDelayNodeDesc(1, 0.01f, &delay_desc));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 },
+        { PLANAR_SCALE_NODE_DESC,
+          1,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { sogo::MergeNodeDesc,
+          2,
+          0 },
+        { delay_desc,
+          1,
+          0 }
+    };
+
+    // The merge mixes the sine, converted to planar and back, with an external input
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[5] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 1, sogo::EXTERNAL_NODE_OFFSET, 0 },
+        { 0, -1, 0 }
+    };
+
+    float external_buffer[MAX_BATCH_SIZE];
+    for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+    {
+        external_buffer[f] = f * 0.01f;
+    }
+    sogo::AudioOutput  external_output          = { external_buffer, 1, false, false, false, 0 };
+    sogo::AudioOutput* EXTERNAL_AUDIO_INPUTS[1] = { &external_output };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        EXTERNAL_AUDIO_INPUTS
+    };
+
+    sogo::TGraphSize prototype_size;
+    ASSERT_TRUE(sogo::GetPrototypeSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &prototype_size));
+    void*                 prototype_mem = malloc(prototype_size);
+    sogo::HGraphPrototype prototype     = sogo::CreatePrototype(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, prototype_mem);
+    ASSERT_NE(0x0, prototype);
+
+    sogo::GraphSize graph_size;
+    sogo::GraphSize prototype_graph_size;
+    ASSERT_TRUE(sogo::GetGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_size));
+    sogo::GetPrototypeGraphSize(prototype, &prototype_graph_size);
+    ASSERT_EQ(graph_size.m_GraphSize, prototype_graph_size.m_GraphSize);
+    ASSERT_EQ(graph_size.m_ScratchBufferSize, prototype_graph_size.m_ScratchBufferSize);
+    ASSERT_EQ(graph_size.m_ConcurrentScratchBufferSize, prototype_graph_size.m_ConcurrentScratchBufferSize);
+    ASSERT_EQ(graph_size.m_TriggerBufferSize, prototype_graph_size.m_TriggerBufferSize);
+    ASSERT_EQ(graph_size.m_ContextMemorySize, prototype_graph_size.m_ContextMemorySize);
+
+    // The instantiated graphs do not refer back to the prototype
+    uint8_t*     mem[2];
+    sogo::HGraph graphs[2];
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        graphs[i] = InstantiateTestGraph(prototype, &mem[i]);
+        ASSERT_NE(0x0, graphs[i]);
+    }
+    free(prototype_mem);
+
+    uint8_t*     reference_mem   = 0x0;
+    sogo::HGraph reference_graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &reference_mem);
+    ASSERT_NE(0x0, reference_graph);
+    ASSERT_EQ(sogo::GetRenderJobCount(reference_graph), sogo::GetRenderJobCount(graphs[0]));
+
+    ASSERT_TRUE(sogo::SetParameter(reference_graph, 0, 0, sogo::TParameter { 220.f }));
+    ASSERT_TRUE(sogo::SetParameter(graphs[0], 0, 0, sogo::TParameter { 220.f }));
+    ASSERT_TRUE(sogo::SetParameter(graphs[1], 0, 0, sogo::TParameter { 330.f }));
+    ASSERT_TRUE(sogo::Trigger(reference_graph, 0, 1, MAX_BATCH_SIZE * 6 + 5));
+    ASSERT_TRUE(sogo::Trigger(graphs[0], 0, 1, MAX_BATCH_SIZE * 6 + 5));
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(WORKER_THREAD_COUNT, sogo::GetRenderJobCount(graphs[1])));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, WORKER_THREAD_COUNT, sogo::GetRenderJobCount(graphs[1]));
+    ASSERT_NE(0x0, executor);
+
+    bool is_different = false;
+    for (uint32_t b = 0; b < 16; ++b)
+    {
+        sogo::RenderGraph(reference_graph, MAX_BATCH_SIZE);
+        sogo::RenderGraph(graphs[0], MAX_BATCH_SIZE);
+        ASSERT_TRUE(sogo::RenderGraphParallel(graphs[1], MAX_BATCH_SIZE, executor));
+
+        const sogo::AudioOutput* reference_output = sogo::GetAudioOutput(reference_graph, 4, 0);
+        const sogo::AudioOutput* output           = sogo::GetAudioOutput(graphs[0], 4, 0);
+        const sogo::AudioOutput* other_output     = sogo::GetAudioOutput(graphs[1], 4, 0);
+        ASSERT_NE(0x0, reference_output->m_Buffer);
+        ASSERT_NE(0x0, output->m_Buffer);
+        ASSERT_NE(0x0, other_output->m_Buffer);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_EQ(reference_output->m_Buffer[f], output->m_Buffer[f]);
+            is_different |= other_output->m_Buffer[f] != output->m_Buffer[f];
+        }
+    }
+    ASSERT_TRUE(is_different);
+
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(reference_mem);
+    free(mem[1]);
+    free(mem[0]);
+}
+
+static void sogo_compiled_graph(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 4;
+    static const sogo::TFrameRate    FRAME_RATE              = 48000;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 64;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 8;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 8;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription PLANAR_SCALE_NODE_DESC = {
+        PlanarScaleNodeGetNodeRuntimeDescCallback,
+        0x0,
+        PlanarScaleNodeAudioOutputDescriptions,
+        0x0,
+        1,
+        1,
+        0,
+        0,
+        0,
+        0,
+        sogo::NODE_FLAG_PLANAR,
+        { 0 }
+    };
+
+    sogo::NodeStaticDescription delay_desc;
+    ASSERT_TRUE(sogo::MakeDelayNodeDesc(1, 0.01f, &delay_desc));
+
+    const sogo::NodeStaticDescription* NODE_TYPES[4] = {
+        &sogo::GainNodeDesc,
+        &sogo::SineNodeDesc,
+        &PLANAR_SCALE_NODE_DESC,
+        &delay_desc
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 },
+        { PLANAR_SCALE_NODE_DESC,
+          1,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { delay_desc,
+          1,
+          0 }
+    };
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[3] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    sogo::TGraphSize compiled_graph_size;
+    ASSERT_TRUE(sogo::GetCompiledGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &compiled_graph_size));
+    void* compiled_graph_mem = malloc(compiled_graph_size);
+    ASSERT_TRUE(!sogo::CompileGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, NODE_TYPES, 3, compiled_graph_mem));
+    ASSERT_TRUE(sogo::CompileGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, NODE_TYPES, 4, compiled_graph_mem));
+
+    // Compiling is deterministic and the compiled graph may be loaded at any address
+    void* loaded_mem = malloc(compiled_graph_size);
+    ASSERT_TRUE(sogo::CompileGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, NODE_TYPES, 4, loaded_mem));
+    ASSERT_EQ(0, memcmp(compiled_graph_mem, loaded_mem, compiled_graph_size));
+    free(compiled_graph_mem);
+
+    const sogo::NodeStaticDescription* SWAPPED_NODE_TYPES[4] = {
+        &sogo::SineNodeDesc,
+        &sogo::GainNodeDesc,
+        &PLANAR_SCALE_NODE_DESC,
+        &delay_desc
+    };
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size - 1, NODE_TYPES, 4));
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 3));
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, SWAPPED_NODE_TYPES, 4));
+    ((uint8_t*)loaded_mem)[0] ^= 1;
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 4));
+    ((uint8_t*)loaded_mem)[0] ^= 1;
+
+    // The node types must match in every field, a delay with another capacity has other context memory
+    sogo::NodeStaticDescription longer_delay_desc;
+    ASSERT_TRUE(sogo::MakeDelayNodeDesc(1, 0.02f, &longer_delay_desc));
+    const sogo::NodeStaticDescription* LONGER_DELAY_NODE_TYPES[4] = {
+        &sogo::GainNodeDesc,
+        &sogo::SineNodeDesc,
+        &PLANAR_SCALE_NODE_DESC,
+        &longer_delay_desc
+    };
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, LONGER_DELAY_NODE_TYPES, 4));
+
+    // m_Size and m_NodeTypesOffset follow three uint32_t in the header, a truncated file that
+    // claims its own size and corrupted offsets are rejected before they are followed
+    uint32_t* header = (uint32_t*)loaded_mem;
+    ASSERT_EQ(compiled_graph_size, header[3]);
+    uint32_t  truncated_size = compiled_graph_size / 2;
+    void*     truncated_mem  = malloc(truncated_size);
+    memcpy(truncated_mem, loaded_mem, truncated_size);
+    ((uint32_t*)truncated_mem)[3] = truncated_size;
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(truncated_mem, truncated_size, NODE_TYPES, 4));
+    free(truncated_mem);
+
+    uint32_t node_types_offset = header[4];
+    header[4]                  = 0xfffffff0u;
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 4));
+    header[4] = 8;
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 4));
+    header[4] = node_types_offset + 4;
+    ASSERT_EQ(0x0, sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 4));
+    header[4] = node_types_offset;
+    sogo::HCompiledGraph compiled_graph = sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 4);
+    ASSERT_NE(0x0, compiled_graph);
+
+    void* unchanged_mem = malloc(compiled_graph_size);
+    memcpy(unchanged_mem, loaded_mem, compiled_graph_size);
+
+    sogo::GraphSize graph_size;
+    sogo::GraphSize compiled_graph_buffers_size;
+    ASSERT_TRUE(sogo::GetGraphSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_size));
+    sogo::GetCompiledGraphBuffersSize(compiled_graph, &compiled_graph_buffers_size);
+    ASSERT_EQ(graph_size.m_GraphSize, compiled_graph_buffers_size.m_GraphSize);
+    ASSERT_EQ(graph_size.m_ScratchBufferSize, compiled_graph_buffers_size.m_ScratchBufferSize);
+    ASSERT_EQ(graph_size.m_ConcurrentScratchBufferSize, compiled_graph_buffers_size.m_ConcurrentScratchBufferSize);
+    ASSERT_EQ(graph_size.m_TriggerBufferSize, compiled_graph_buffers_size.m_TriggerBufferSize);
+    ASSERT_EQ(graph_size.m_ContextMemorySize, compiled_graph_buffers_size.m_ContextMemorySize);
+
+    uint8_t* mem = (uint8_t*)malloc(GetGraphBuffersMemSize(&graph_size));
+    sogo::GraphBuffers graph_buffers;
+    LayoutGraphBuffers(mem, &graph_size, false, &graph_buffers);
+    sogo::HGraph graph                         = sogo::InstantiateCompiledGraph(compiled_graph, NODE_TYPES, &graph_buffers);
+    ASSERT_NE(0x0, graph);
+    ASSERT_EQ(0, memcmp(unchanged_mem, loaded_mem, compiled_graph_size));
+
+    uint8_t*     reference_mem   = 0x0;
+    sogo::HGraph reference_graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &reference_mem);
+    ASSERT_NE(0x0, reference_graph);
+    ASSERT_EQ(sogo::GetRenderJobCount(reference_graph), sogo::GetRenderJobCount(graph));
+
+    ASSERT_TRUE(sogo::SetParameter(reference_graph, 0, 0, sogo::TParameter { 440.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 440.f }));
+    ASSERT_TRUE(sogo::SetParameter(reference_graph, 2, 0, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 2, 0, sogo::TParameter { 0.5f }));
+    for (uint32_t b = 0; b < 16; ++b)
+    {
+        sogo::RenderGraph(reference_graph, MAX_BATCH_SIZE);
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        const sogo::AudioOutput* reference_output = sogo::GetAudioOutput(reference_graph, 3, 0);
+        const sogo::AudioOutput* output           = sogo::GetAudioOutput(graph, 3, 0);
+        ASSERT_NE(0x0, reference_output->m_Buffer);
+        ASSERT_NE(0x0, output->m_Buffer);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_EQ(reference_output->m_Buffer[f], output->m_Buffer[f]);
+        }
+    }
+    ASSERT_EQ(0, memcmp(unchanged_mem, loaded_mem, compiled_graph_size));
+
+    // A compiled graph with any byte flipped is rejected or renders within its buffers
+    for (uint32_t i = 0; i < compiled_graph_size; ++i)
+    {
+        ((uint8_t*)loaded_mem)[i] ^= 0xff;
+        sogo::HCompiledGraph corrupted_compiled_graph = sogo::LoadCompiledGraph(loaded_mem, compiled_graph_size, NODE_TYPES, 4);
+        if (corrupted_compiled_graph != 0x0)
+        {
+            sogo::HGraph corrupted_graph = sogo::InstantiateCompiledGraph(corrupted_compiled_graph, NODE_TYPES, &graph_buffers);
+            ASSERT_NE(0x0, corrupted_graph);
+            sogo::RenderGraph(corrupted_graph, MAX_BATCH_SIZE);
+            sogo::RenderGraph(corrupted_graph, MAX_BATCH_SIZE);
+        }
+        ((uint8_t*)loaded_mem)[i] ^= 0xff;
+    }
+    ASSERT_EQ(0, memcmp(unchanged_mem, loaded_mem, compiled_graph_size));
+
+    // External audio inputs are addresses in the process that compiles the graph
+    static const sogo::NodeAudioConnection EXTERNAL_CONNECTIONS[3] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, sogo::EXTERNAL_NODE_OFFSET, 0 }
+    };
+
+    sogo::AudioOutput  external_output          = { 0x0, 1, true, false, false, 0 };
+    sogo::AudioOutput* EXTERNAL_AUDIO_INPUTS[1] = { &external_output };
+    GRAPH_DESCRIPTION.m_AudioConnections    = EXTERNAL_CONNECTIONS;
+    GRAPH_DESCRIPTION.m_ExternalAudioInputs = EXTERNAL_AUDIO_INPUTS;
+    ASSERT_TRUE(!sogo::CompileGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, NODE_TYPES, 4, unchanged_mem));
+
+    free(reference_mem);
+    free(mem);
+    free(unchanged_mem);
+    free(loaded_mem);
+}
+
+static void sogo_bench_mixer(SCtx*)
+{
+    static const sogo::TNodeIndex    GENERATOR_COUNT         = 32;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   BATCH_SIZE              = 256;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            BATCH_COUNT             = 1000;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    // The same bus as a tree of Merge nodes and as a single mixer node
+    MixerGraphDescription merge_tree;
+    MakeMixerGraphDescription(GENERATOR_COUNT, &merge_tree);
+
+    sogo::NodeStaticDescription mixer_node_desc;
+    ASSERT_TRUE(sogo::MakeMixerNodeDesc(GENERATOR_COUNT, 1, &mixer_node_desc));
+    sogo::NodeDescription     nodes[GENERATOR_COUNT + 1];
+    sogo::NodeAudioConnection connections[GENERATOR_COUNT];
+    for (sogo::TNodeIndex g = 0; g < GENERATOR_COUNT; ++g)
+    {
+        nodes[g]       = { sogo::DCNodeDesc, 0, 0 };
+        connections[g] = { (sogo::TAudioSocketIndex)g, (sogo::TNodeOffset)(g - GENERATOR_COUNT), 0 };
+    }
+    nodes[GENERATOR_COUNT]                = { mixer_node_desc, GENERATOR_COUNT, 0 };
+    sogo::GraphDescription mixer_graph    = { GENERATOR_COUNT + 1, nodes, connections, 0x0, 0x0 };
+
+    uint8_t*     merge_mem   = 0x0;
+    sogo::HGraph merge_graph = CreateTestGraph(&merge_tree.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &merge_mem);
+    ASSERT_NE(0x0, merge_graph);
+    uint8_t*     mixer_mem = 0x0;
+    sogo::HGraph graph     = CreateTestGraph(&mixer_graph, &GRAPH_RUNTIME_SETTINGS, &mixer_mem);
+    ASSERT_NE(0x0, graph);
+
+    sogo::RenderGraph(merge_graph, BATCH_SIZE);
+    sogo::RenderGraph(graph, BATCH_SIZE);
+    ASSERT_EQ((float)GENERATOR_COUNT, sogo::GetAudioOutput(merge_graph, merge_tree.m_OutputNodeIndex, 0)->m_Buffer[BATCH_SIZE - 1]);
+    ASSERT_EQ((float)GENERATOR_COUNT, sogo::GetAudioOutput(graph, GENERATOR_COUNT, 0)->m_Buffer[BATCH_SIZE - 1]);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i)
+    {
+        sogo::RenderGraph(merge_graph, BATCH_SIZE);
+    }
+    std::chrono::high_resolution_clock::time_point merge_end = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i)
+    {
+        sogo::RenderGraph(graph, BATCH_SIZE);
+    }
+    std::chrono::high_resolution_clock::time_point mixer_end = std::chrono::high_resolution_clock::now();
+
+    printf("%u voices, %u frames per batch, us per batch: merge tree with gains %.2f, mixer %.2f\n",
+           (uint32_t)GENERATOR_COUNT,
+           (uint32_t)BATCH_SIZE,
+           std::chrono::duration<double, std::micro>(merge_end - start).count() / BATCH_COUNT,
+           std::chrono::duration<double, std::micro>(mixer_end - merge_end).count() / BATCH_COUNT);
+
+    free(mixer_mem);
+    free(merge_mem);
+    FreeMixerGraphDescription(&merge_tree);
+}
+
+static void sogo_copy_on_write(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 7;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            WORKER_THREAD_COUNT     = 2;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::DCNodeDesc,
+          0,
+          0 },
+        { sogo::SplitNodeDesc,
+          1,
+          0 },
+        { sogo::SplitNodeDesc,
+          1,
+          0 },
+        { sogo::ToStereoNodeDesc,
+          1,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { sogo::MergeNodeDesc,
+          2,
+          0 }
+    };
+
+    static const uint16_t CONNECTION_COUNT = 7;
+
+    // DC -> Split -> Split fans out to a send that only reads and to two gains that write
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[CONNECTION_COUNT] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -2, 1 },
+        { 0, -2, 0 },
+        { 0, -3, 1 },
+        { 0, -2, 0 },
+        { 1, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 1.f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 0, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 4, 1, sogo::TParameter { 0.5f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 5, 0, sogo::TParameter { 0.25f }));
+    ASSERT_TRUE(sogo::SetParameter(graph, 5, 1, sogo::TParameter { 0.25f }));
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(WORKER_THREAD_COUNT, NODE_COUNT));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, WORKER_THREAD_COUNT, NODE_COUNT);
+    ASSERT_NE(0x0, executor);
+
+    for (uint32_t render_mode = 0; render_mode < 3; ++render_mode)
+    {
+        if (render_mode == 0)
+        {
+            sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        }
+        else if (render_mode == 1)
+        {
+            ASSERT_TRUE(sogo::RenderGraphParallel(graph, MAX_BATCH_SIZE, executor));
+        }
+        else
+        {
+            ASSERT_TRUE(sogo::RenderGraphWavefront(graph, MAX_BATCH_SIZE, executor));
+        }
+
+        const sogo::AudioOutput* source = sogo::GetAudioOutput(graph, 0, 0);
+        const sogo::AudioOutput* split  = sogo::GetAudioOutput(graph, 1, 0);
+        const sogo::AudioOutput* send   = sogo::GetAudioOutput(graph, 3, 0);
+        const sogo::AudioOutput* gain_1 = sogo::GetAudioOutput(graph, 4, 0);
+        const sogo::AudioOutput* gain_2 = sogo::GetAudioOutput(graph, 5, 0);
+        const sogo::AudioOutput* merge  = sogo::GetAudioOutput(graph, 6, 0);
+        ASSERT_EQ(source->m_Buffer, split->m_Buffer);
+        ASSERT_NE(gain_1->m_Buffer, gain_2->m_Buffer);
+        if (render_mode == 0)
+        {
+            // The first gain copies, the second gain is the last reader and writes in place
+            ASSERT_NE(source->m_Buffer, gain_1->m_Buffer);
+            ASSERT_EQ(source->m_Buffer, gain_2->m_Buffer);
+        }
+        else
+        {
+            // Nothing orders the readers when rendering concurrently, both gains copy
+            ASSERT_NE(source->m_Buffer, gain_1->m_Buffer);
+            ASSERT_NE(source->m_Buffer, gain_2->m_Buffer);
+            ASSERT_EQ(1.f, source->m_Buffer[MAX_BATCH_SIZE - 1]);
+        }
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_EQ(1.f, send->m_Buffer[f * 2 + 0]);
+            ASSERT_EQ(1.f, send->m_Buffer[f * 2 + 1]);
+            ASSERT_EQ(0.75f, merge->m_Buffer[f]);
+        }
+    }
+
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(mem);
+}
+
+static void sogo_render_parallel(SCtx*)
+{
+    static const sogo::TNodeIndex    GENERATOR_COUNT         = 32;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            WORKER_THREAD_COUNT     = 3;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    MixerGraphDescription mixer;
+    MakeMixerGraphDescription(GENERATOR_COUNT, &mixer);
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    float expected_signal = 0.f;
+    for (sogo::TNodeIndex g = 0; g < GENERATOR_COUNT; ++g)
+    {
+        float level = 1.f / (g + 1);
+        ASSERT_TRUE(sogo::SetParameter(graph, (sogo::TNodeIndex)(g * 2), 0, sogo::TParameter { level }));
+        expected_signal += level;
+    }
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(WORKER_THREAD_COUNT, mixer.m_GraphDescription.m_NodeCount));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, WORKER_THREAD_COUNT, mixer.m_GraphDescription.m_NodeCount);
+    ASSERT_NE(0x0, executor);
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        ASSERT_TRUE(sogo::RenderGraphParallel(graph, MAX_BATCH_SIZE, executor));
+        sogo::AudioOutput* render_output = sogo::GetAudioOutput(graph, mixer.m_OutputNodeIndex, 0);
+        ASSERT_TRUE(render_output->m_Buffer != 0x0);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_LT(fabsf(expected_signal - render_output->m_Buffer[f]), 0.0001f);
+        }
+    }
+
+    // Workers idle long enough to park are woken by the next batch
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        ASSERT_TRUE(i % 2 == 0 ? sogo::RenderGraphParallel(graph, MAX_BATCH_SIZE, executor) : sogo::RenderGraphWavefront(graph, MAX_BATCH_SIZE, executor));
+        sogo::AudioOutput* render_output = sogo::GetAudioOutput(graph, mixer.m_OutputNodeIndex, 0);
+        ASSERT_LT(fabsf(expected_signal - render_output->m_Buffer[0]), 0.0001f);
+    }
+
+    // The serial renderer must produce the same result on the same graph
+    sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    sogo::AudioOutput* render_output = sogo::GetAudioOutput(graph, mixer.m_OutputNodeIndex, 0);
+    ASSERT_LT(fabsf(expected_signal - render_output->m_Buffer[0]), 0.0001f);
+
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(mem);
+    FreeMixerGraphDescription(&mixer);
+}
+
+static void sogo_render_wavefront(SCtx*)
+{
+    static const sogo::TNodeIndex    GENERATOR_COUNT         = 32;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            WORKER_THREAD_COUNT     = 3;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    MixerGraphDescription mixer;
+    MakeMixerGraphDescription(GENERATOR_COUNT, &mixer);
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    float expected_signal = 0.f;
+    for (sogo::TNodeIndex g = 0; g < GENERATOR_COUNT; ++g)
+    {
+        float level = 1.f / (g + 1);
+        ASSERT_TRUE(sogo::SetParameter(graph, (sogo::TNodeIndex)(g * 2), 0, sogo::TParameter { level }));
+        expected_signal += level;
+    }
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(WORKER_THREAD_COUNT, mixer.m_GraphDescription.m_NodeCount));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, WORKER_THREAD_COUNT, mixer.m_GraphDescription.m_NodeCount);
+    ASSERT_NE(0x0, executor);
+
+    for (uint32_t i = 0; i < 64; ++i)
+    {
+        // Alternate between the two parallel modes on the same executor
+        if (i & 1)
+        {
+            ASSERT_TRUE(sogo::RenderGraphWavefront(graph, MAX_BATCH_SIZE, executor));
+        }
+        else
+        {
+            ASSERT_TRUE(sogo::RenderGraphParallel(graph, MAX_BATCH_SIZE, executor));
+        }
+        sogo::AudioOutput* render_output = sogo::GetAudioOutput(graph, mixer.m_OutputNodeIndex, 0);
+        ASSERT_TRUE(render_output->m_Buffer != 0x0);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_LT(fabsf(expected_signal - render_output->m_Buffer[f]), 0.0001f);
+        }
+    }
+
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(mem);
+    FreeMixerGraphDescription(&mixer);
+}
+
+// Renders the same wide graph serially and with each of the concurrent scratch buffer paths,
+// every node allocates its output from the concurrent scratch buffer in parallel so a race
+// or an overlapping allocation shows up as a difference in the mixed output
+static void sogo_render_concurrent_scratch(SCtx*)
+{
+    static const sogo::TNodeIndex    GENERATOR_COUNT         = 64;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 128;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            WORKER_THREAD_COUNT     = 3;
+    static const uint32_t            BATCH_COUNT             = 96;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    // Sine generators instead of DC so every generator and every frame carries a distinct signal
+    MixerGraphDescription mixer;
+    MakeMixerGraphDescription(GENERATOR_COUNT, &mixer);
+    for (sogo::TNodeIndex g = 0; g < GENERATOR_COUNT; ++g)
+    {
+        mixer.m_Nodes[g * 2] = { sogo::SineNodeDesc, 0, 0 };
+    }
+
+    uint8_t*     serial_mem     = 0x0;
+    sogo::HGraph serial_graph   = CreateTestGraph(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &serial_mem);
+    ASSERT_NE(0x0, serial_graph);
+    uint8_t*     parallel_mem   = 0x0;
+    sogo::HGraph parallel_graph = CreateTestGraph(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &parallel_mem);
+    ASSERT_NE(0x0, parallel_graph);
+
+    for (sogo::TNodeIndex g = 0; g < GENERATOR_COUNT; ++g)
+    {
+        sogo::TParameter frequency = { 110.f * (g + 1) };
+        sogo::TParameter level     = { 1.f / (g + 1) };
+        ASSERT_TRUE(sogo::SetParameter(serial_graph, (sogo::TNodeIndex)(g * 2), 0, frequency));
+        ASSERT_TRUE(sogo::SetParameter(serial_graph, (sogo::TNodeIndex)(g * 2 + 1), 0, level));
+        ASSERT_TRUE(sogo::SetParameter(parallel_graph, (sogo::TNodeIndex)(g * 2), 0, frequency));
+        ASSERT_TRUE(sogo::SetParameter(parallel_graph, (sogo::TNodeIndex)(g * 2 + 1), 0, level));
+    }
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(WORKER_THREAD_COUNT, mixer.m_GraphDescription.m_NodeCount));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, WORKER_THREAD_COUNT, mixer.m_GraphDescription.m_NodeCount);
+    ASSERT_NE(0x0, executor);
+
+    sogo::TNodeIndex node_count  = mixer.m_GraphDescription.m_NodeCount;
+    sogo::RenderJob* render_jobs = (sogo::RenderJob*)malloc(sizeof(sogo::RenderJob) * node_count);
+    bool*            rendered    = (bool*)malloc(sizeof(bool) * node_count);
+
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i)
+    {
+        sogo::RenderGraph(serial_graph, MAX_BATCH_SIZE);
+
+        switch (i % 3)
+        {
+            case 0:
+                ASSERT_TRUE(sogo::RenderGraphParallel(parallel_graph, MAX_BATCH_SIZE, executor));
+                break;
+            case 1:
+                ASSERT_TRUE(sogo::RenderGraphWavefront(parallel_graph, MAX_BATCH_SIZE, executor));
+                break;
+            case 2:
+            {
+                // Run the jobs on this thread in any order that honours their dependencies
+                sogo::GetRenderJobs(parallel_graph, MAX_BATCH_SIZE, render_jobs);
+                memset(rendered, 0, sizeof(bool) * node_count);
+                sogo::TNodeIndex rendered_count = 0;
+                while (rendered_count < node_count)
+                {
+                    for (sogo::TNodeIndex n = 0; n < node_count; ++n)
+                    {
+                        if (rendered[n])
+                        {
+                            continue;
+                        }
+                        sogo::TNodeIndex d = 0;
+                        while (d < render_jobs[n].m_DependencyCount && rendered[render_jobs[n].m_Dependencies[d]])
+                        {
+                            ++d;
+                        }
+                        if (d == render_jobs[n].m_DependencyCount)
+                        {
+                            render_jobs[n].m_RenderCallback(render_jobs[n].m_Graph, render_jobs[n].m_Node, &render_jobs[n].m_RenderParameters);
+                            rendered[n] = true;
+                            ++rendered_count;
+                        }
+                    }
+                }
+                break;
+            }
+        }
+
+        sogo::AudioOutput* serial_output   = sogo::GetAudioOutput(serial_graph, mixer.m_OutputNodeIndex, 0);
+        sogo::AudioOutput* parallel_output = sogo::GetAudioOutput(parallel_graph, mixer.m_OutputNodeIndex, 0);
+        ASSERT_TRUE(serial_output->m_Buffer != 0x0);
+        ASSERT_TRUE(parallel_output->m_Buffer != 0x0);
+        for (sogo::TFrameIndex f = 0; f < MAX_BATCH_SIZE; ++f)
+        {
+            ASSERT_EQ(serial_output->m_Buffer[f], parallel_output->m_Buffer[f]);
+        }
+    }
+
+    free(rendered);
+    free(render_jobs);
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(parallel_mem);
+    free(serial_mem);
+    FreeMixerGraphDescription(&mixer);
+}
+
+static void sogo_bench_schedulers(SCtx*)
+{
+    static const sogo::TNodeIndex    GENERATOR_COUNT         = 512;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   BATCH_SIZE              = 64;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            BATCH_COUNT             = 1000;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    MixerGraphDescription mixer;
+    MakeMixerGraphDescription(GENERATOR_COUNT, &mixer);
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&mixer.m_GraphDescription, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    uint32_t worker_thread_count = std::thread::hardware_concurrency();
+    worker_thread_count          = worker_thread_count > 1 ? worker_thread_count - 1 : 1;
+
+    void*           executor_mem = malloc(sogo::GetExecutorSize(worker_thread_count, mixer.m_GraphDescription.m_NodeCount));
+    sogo::HExecutor executor     = sogo::CreateExecutor(executor_mem, worker_thread_count, mixer.m_GraphDescription.m_NodeCount);
+    ASSERT_NE(0x0, executor);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i)
+    {
+        sogo::RenderGraph(graph, BATCH_SIZE);
+    }
+    std::chrono::high_resolution_clock::time_point serial_end = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i)
+    {
+        sogo::RenderGraphParallel(graph, BATCH_SIZE, executor);
+    }
+    std::chrono::high_resolution_clock::time_point parallel_end = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < BATCH_COUNT; ++i)
+    {
+        sogo::RenderGraphWavefront(graph, BATCH_SIZE, executor);
+    }
+    std::chrono::high_resolution_clock::time_point wavefront_end = std::chrono::high_resolution_clock::now();
+
+    printf("%u nodes, %u frames per batch, %u worker threads, us per batch: serial %.2f, task %.2f, wavefront %.2f\n",
+           (uint32_t)mixer.m_GraphDescription.m_NodeCount,
+           (uint32_t)BATCH_SIZE,
+           worker_thread_count,
+           std::chrono::duration<double, std::micro>(serial_end - start).count() / BATCH_COUNT,
+           std::chrono::duration<double, std::micro>(parallel_end - serial_end).count() / BATCH_COUNT,
+           std::chrono::duration<double, std::micro>(wavefront_end - parallel_end).count() / BATCH_COUNT);
+
+    sogo::DisposeExecutor(executor);
+    free(executor_mem);
+    free(mem);
+    FreeMixerGraphDescription(&mixer);
+}
+
+static uint32_t g_TriggerCountingNodeTriggerCount = 0;
+
+static void RenderTriggerCountingNode(sogo::HGraph, sogo::HNode, const sogo::RenderParameters* render_parameters)
+{
+    sogo::EventIterator event_iterator;
+    sogo::InitEventIterator(&event_iterator, render_parameters);
+    sogo::TFrameIndex      sub_block_offset;
+    sogo::TFrameIndex      sub_block_count;
+    const sogo::NodeEvent* events;
+    sogo::TTriggerCount    event_count;
+    while (sogo::NextSubBlock(&event_iterator, &sub_block_offset, &sub_block_count, &events, &event_count))
+    {
+        g_TriggerCountingNodeTriggerCount += event_count;
+    }
+}
+
+static void TriggerCountingNodeGetNodeRuntimeDescCallback(const sogo::GraphRuntimeSettings*, sogo::TParameter, sogo::NodeRuntimeDescription* out_node_runtime_desc)
+{
+    out_node_runtime_desc->m_InitCallback      = 0;
+    out_node_runtime_desc->m_RenderCallback    = RenderTriggerCountingNode;
+    out_node_runtime_desc->m_ContextMemorySize = 0;
+}
+
+static void sogo_bench_triggers(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 1;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 64;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 4096;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            TRIGGER_COUNT           = 100000;
+    static const uint32_t            ROUND_COUNT             = 100;
+    static const uint32_t            MAX_PRODUCER_COUNT      = 4;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeStaticDescription TRIGGER_COUNTING_NODE_DESC = {
+        TriggerCountingNodeGetNodeRuntimeDescCallback,
+        0x0,
+        0x0,
+        0x0,
+        0,
+        0,
+        0,
+        0,
+        1,
+        0,
+        0,
+        { 0 }
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { TRIGGER_COUNTING_NODE_DESC,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    // Producers post while the audio thread renders, every trigger must arrive exactly once
+    {
+        g_TriggerCountingNodeTriggerCount = 0;
+        uint32_t    triggers_per_producer = TRIGGER_COUNT / MAX_PRODUCER_COUNT;
+        std::thread producers[MAX_PRODUCER_COUNT];
+        for (uint32_t p = 0; p < MAX_PRODUCER_COUNT; ++p)
+        {
+            producers[p] = std::thread([graph, triggers_per_producer]() {
+                for (uint32_t i = 0; i < triggers_per_producer; ++i)
+                {
+                    while (!sogo::Trigger(graph, 0, 0, 0))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        while (g_TriggerCountingNodeTriggerCount < triggers_per_producer * MAX_PRODUCER_COUNT)
+        {
+            sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        }
+        for (uint32_t p = 0; p < MAX_PRODUCER_COUNT; ++p)
+        {
+            producers[p].join();
+        }
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        ASSERT_EQ(triggers_per_producer * MAX_PRODUCER_COUNT, g_TriggerCountingNodeTriggerCount);
+        ASSERT_EQ(0u, sogo::GetDroppedEventCount(graph));
+    }
+
+    // Contended posting throughput, each round the producers fill the queue together and the
+    // audio thread drains it
+    for (uint32_t producer_count = 1; producer_count <= MAX_PRODUCER_COUNT; producer_count *= 2)
+    {
+        g_TriggerCountingNodeTriggerCount = 0;
+        uint32_t triggers_per_producer    = MAX_TRIGGER_EVENT_COUNT / producer_count;
+        double   post_ns                  = 0.0;
+        for (uint32_t round = 0; round < ROUND_COUNT; ++round)
+        {
+            std::atomic<uint32_t> ready_count(0);
+            std::atomic<uint32_t> failed_count(0);
+            std::thread           producers[MAX_PRODUCER_COUNT];
+            for (uint32_t p = 0; p < producer_count; ++p)
+            {
+                producers[p] = std::thread([graph, producer_count, triggers_per_producer, &ready_count, &failed_count]() {
+                    ready_count.fetch_add(1);
+                    while (ready_count.load() < producer_count)
+                    {
+                        std::this_thread::yield();
+                    }
+                    for (uint32_t i = 0; i < triggers_per_producer; ++i)
+                    {
+                        if (!sogo::Trigger(graph, 0, 0, 0))
+                        {
+                            failed_count.fetch_add(1);
+                        }
+                    }
+                });
+            }
+            std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+            for (uint32_t p = 0; p < producer_count; ++p)
+            {
+                producers[p].join();
+            }
+            post_ns += std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start).count();
+            ASSERT_EQ(0u, failed_count.load());
+            ASSERT_TRUE(!sogo::Trigger(graph, 0, 0, 0));
+            sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+        }
+        ASSERT_EQ(ROUND_COUNT * producer_count * triggers_per_producer, g_TriggerCountingNodeTriggerCount);
+
+        printf("%u producer threads, %u triggers, ns per trigger %.2f\n",
+               producer_count,
+               g_TriggerCountingNodeTriggerCount,
+               post_ns / g_TriggerCountingNodeTriggerCount);
+    }
+
+    free(mem);
+}
+
+static void sogo_bench_instances(SCtx*)
+{
+    static const uint32_t            INSTANCE_COUNT          = 256;
+    static const uint32_t            NODE_COUNT              = 2;
+    static const uint32_t            BATCH_COUNT             = 1000;
+    static const sogo::TFrameRate    FRAME_RATE              = 48000;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 64;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 8;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 8;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 }
+    };
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[1] = {
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    uint8_t*              instanced_mem   = 0x0;
+    sogo::HInstancedGraph instanced_graph = CreateTestInstancedGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, INSTANCE_COUNT, &instanced_mem);
+    ASSERT_NE(0x0, instanced_graph);
+
+    uint8_t**     mem    = (uint8_t**)malloc(sizeof(uint8_t*) * INSTANCE_COUNT);
+    sogo::HGraph* graphs = (sogo::HGraph*)malloc(sizeof(sogo::HGraph) * INSTANCE_COUNT);
+    for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        graphs[i] = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem[i]);
+        ASSERT_NE(0x0, graphs[i]);
+        ASSERT_TRUE(sogo::SetInstanceActive(instanced_graph, i, true));
+        ASSERT_TRUE(sogo::SetParameter(graphs[i], 0, 0, sogo::TParameter { 200.f + i }));
+        ASSERT_TRUE(sogo::SetParameter(sogo::GetInstance(instanced_graph, i), 0, 0, sogo::TParameter { 200.f + i }));
+    }
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t b = 0; b < BATCH_COUNT; ++b)
+    {
+        for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+        {
+            sogo::RenderGraph(graphs[i], MAX_BATCH_SIZE);
+        }
+    }
+    std::chrono::high_resolution_clock::time_point graphs_end = std::chrono::high_resolution_clock::now();
+    for (uint32_t b = 0; b < BATCH_COUNT; ++b)
+    {
+        sogo::RenderInstancedGraph(instanced_graph, MAX_BATCH_SIZE);
+    }
+    std::chrono::high_resolution_clock::time_point instanced_end = std::chrono::high_resolution_clock::now();
+
+    printf("%u instances, %u frames per batch, us per batch: graphs %.2f, instanced %.2f\n",
+           INSTANCE_COUNT,
+           MAX_BATCH_SIZE,
+           std::chrono::duration<double, std::micro>(graphs_end - start).count() / BATCH_COUNT,
+           std::chrono::duration<double, std::micro>(instanced_end - graphs_end).count() / BATCH_COUNT);
+
+    for (uint32_t i = 0; i < INSTANCE_COUNT; ++i)
+    {
+        free(mem[i]);
+    }
+    free(graphs);
+    free(mem);
+    free(instanced_mem);
+}
+
+static void sogo_bench_instantiate(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 5;
+    static const uint32_t            GRAPH_COUNT             = 1000;
+    static const sogo::TFrameRate    FRAME_RATE              = 48000;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 256;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 8;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 8;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    // A one shot sound effect, a sample through a filter and a short echo
+    sogo::NodeStaticDescription sample_player_desc;
+    sogo::NodeStaticDescription biquad_desc;
+    sogo::NodeStaticDescription delay_desc;
+    ASSERT_TRUE(sogo::MakeSamplePlayerNodeDesc(sogo::SAMPLE_FORMAT_S16, 1, &sample_player_desc));
+    ASSERT_TRUE(sogo::MakeBiquadNodeDesc(2, &biquad_desc));
+    ASSERT_TRUE(sogo::MakeDelayNodeDesc(1, 0.05f, &delay_desc));
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sample_player_desc,
+          0,
+          0 },
+        { biquad_desc,
+          1,
+          0 },
+        { sogo::GainNodeDesc,
+          1,
+          0 },
+        { delay_desc,
+          1,
+          0 },
+        { sogo::ToStereoNodeDesc,
+          1,
+          0 }
+    };
+
+    static const sogo::NodeAudioConnection NODE_AUDIO_CONNECTIONS[NODE_COUNT - 1] = {
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -1, 0 },
+        { 0, -1, 0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        NODE_AUDIO_CONNECTIONS,
+        0x0,
+        0x0
+    };
+
+    sogo::TGraphSize prototype_size;
+    ASSERT_TRUE(sogo::GetPrototypeSize(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &prototype_size));
+    void*                 prototype_mem = malloc(prototype_size);
+    sogo::HGraphPrototype prototype     = sogo::CreatePrototype(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, prototype_mem);
+    ASSERT_NE(0x0, prototype);
+
+    // Both create the graph in the same buffers over and over
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+    sogo::GraphSize graph_size;
+    sogo::GetPrototypeGraphSize(prototype, &graph_size);
+    sogo::GraphBuffers graph_buffers;
+    LayoutGraphBuffers(mem, &graph_size, true, &graph_buffers);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < GRAPH_COUNT; ++i)
+    {
+        graph = sogo::CreateGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &graph_buffers);
+    }
+    std::chrono::high_resolution_clock::time_point create_end = std::chrono::high_resolution_clock::now();
+    for (uint32_t i = 0; i < GRAPH_COUNT; ++i)
+    {
+        graph = sogo::InstantiateGraph(prototype, &graph_buffers);
+    }
+    std::chrono::high_resolution_clock::time_point instantiate_end = std::chrono::high_resolution_clock::now();
+    ASSERT_NE(0x0, graph);
+
+    printf("%u nodes, us per graph: create %.2f, instantiate %.2f\n",
+           NODE_COUNT,
+           std::chrono::duration<double, std::micro>(create_end - start).count() / GRAPH_COUNT,
+           std::chrono::duration<double, std::micro>(instantiate_end - create_end).count() / GRAPH_COUNT);
+
+    free(mem);
+    free(prototype_mem);
+}
+
+static void sogo_bench_sine(SCtx*)
+{
+    static const uint32_t            NODE_COUNT              = 1;
+    static const sogo::TFrameRate    FRAME_RATE              = 44100;
+    static const sogo::TFrameIndex   MAX_BATCH_SIZE          = 125;
+    static const sogo::TTriggerCount MAX_TRIGGER_EVENT_COUNT = 32;
+    static const sogo::TCommandCount MAX_COMMAND_COUNT       = 32;
+    static const uint32_t            BATCH_COUNT             = 6400;
+    sogo::GraphRuntimeSettings       GRAPH_RUNTIME_SETTINGS  = {
+        FRAME_RATE,
+        MAX_BATCH_SIZE,
+        MAX_TRIGGER_EVENT_COUNT,
+        MAX_COMMAND_COUNT
+    };
+
+    const sogo::NodeDescription NODES[NODE_COUNT] = {
+        { sogo::SineNodeDesc,
+          0,
+          0 }
+    };
+
+    sogo::GraphDescription GRAPH_DESCRIPTION = {
+        NODE_COUNT,
+        NODES,
+        0x0,
+        0x0,
+        0x0
+    };
+
+    uint8_t*     mem   = 0x0;
+    sogo::HGraph graph = CreateTestGraph(&GRAPH_DESCRIPTION, &GRAPH_RUNTIME_SETTINGS, &mem);
+    ASSERT_NE(0x0, graph);
+
+    ASSERT_TRUE(sogo::SetParameter(graph, 0, 0, sogo::TParameter { 1234.f }));
+    ASSERT_TRUE(sogo::Trigger(graph, 0, 0, 0));
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t b = 0; b < BATCH_COUNT; ++b)
+    {
+        sogo::RenderGraph(graph, MAX_BATCH_SIZE);
+    }
+    std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+    printf("%u frames per batch, ns per frame %.3f\n", MAX_BATCH_SIZE, std::chrono::duration<double, std::nano>(end - start).count() / (BATCH_COUNT * MAX_BATCH_SIZE));
+
+    free(mem);
+}
+
 TEST_BEGIN(sogo_test, sogo_main_setup, sogo_main_teardown, test_setup, test_teardown)
 TEST(sogo_create)
 TEST(sogo_simple_graph)
 TEST(sogo_merge_graphs)
 TEST(sogo_with_bikeshed)
+TEST(sogo_render_order)
+TEST(sogo_scratch_reuse)
+TEST(sogo_silence_skipping)
+TEST(sogo_copy_on_write)
+TEST(sogo_command_queue)
+TEST(sogo_timed_events)
+TEST(sogo_profiling)
+TEST(sogo_surround_gain)
+TEST(sogo_sine_accuracy)
+TEST(sogo_sine_kernels)
+TEST(sogo_mixer)
+TEST(sogo_channel_matrix)
+TEST(sogo_constant_signal)
+TEST(sogo_planar_layout)
+TEST(sogo_biquad)
+TEST(sogo_sample_player)
+TEST(sogo_resampler)
+TEST(sogo_convolution)
+TEST(sogo_delay)
+TEST(sogo_instanced_graph)
+TEST(sogo_graph_prototype)
+TEST(sogo_compiled_graph)
+TEST(sogo_render_parallel)
+TEST(sogo_render_wavefront)
+TEST(sogo_render_concurrent_scratch)
+TEST(sogo_bench_schedulers)
+TEST(sogo_bench_triggers)
+TEST(sogo_bench_mixer)
+TEST(sogo_bench_instances)
+TEST(sogo_bench_instantiate)
+TEST(sogo_bench_sine)
 TEST_END(sogo_test)